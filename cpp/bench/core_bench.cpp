@@ -0,0 +1,309 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../core/TranslatorEngine.h"
+#include "../core/Config.h"
+#include "../core/LRUCache.h"
+#include "../core/Segmenter.h"
+#include "../core/Glossary.h"
+#include "../core/PostprocessDA.h"
+#include "../core/PostprocessES.h"
+#include "../core/Tokenizer.h"
+
+// Microbenchmarks for the core components on short, medium and long emails.
+// Results go to traductor_bench.json (Google Benchmark JSON) unless
+// --benchmark_out is given, so runs of two versions can be diffed with
+// benchmark's compare.py.
+
+namespace {
+
+enum EmailSize { Short = 0, Medium = 1, Long = 2 };
+
+const std::string& spanishEmail(int size) {
+    static const std::string shortEmail = "Hola Marta, gracias por tu correo. Te llamo mañana a las 10:00.";
+    static const std::string mediumEmail =
+        "Buenos días,\n\n"
+        "Adjunto la factura número 2025-0142 correspondiente al mes de septiembre.\n\n"
+        "El importe total es de 1.250,00 euros y el plazo de pago es de 30 días desde la fecha de emisión. "
+        "Les agradeceríamos que confirmaran la recepción de este documento y que nos indicaran si necesitan "
+        "una copia en papel para su contabilidad.\n\n"
+        "Quedamos a su disposición para cualquier consulta.\n\n"
+        "Atentamente,\n\nLucía Gómez\nAdministración\nwww.ejemplo.es";
+    static const std::string longEmail = [] {
+        std::string text =
+            "Hola Marta,\n\nGracias por tu correo de ayer.\n\n"
+            "Te confirmo que la reunión con el equipo de Copenhague será el martes 16/10/2025 a las 10:00 en la "
+            "sala grande. Hemos preparado la presentación con los resultados del trimestre y una propuesta para "
+            "reducir los plazos de entrega de los pedidos internacionales.\n\n";
+        const std::string paragraphs[] = {
+            "En cuanto al contrato de mantenimiento, el proveedor ha aceptado ampliar la garantía a 24 meses "
+            "siempre que firmemos antes del 31/12/2025. El precio se mantiene en 4.800,00 euros al año, con "
+            "revisión anual según el IPC.",
+            "El almacén de Aarhus recibirá la mercancía la semana 43. Necesitamos que el transportista confirme "
+            "la hora de llegada con 48 horas de antelación, porque el muelle de carga solo está abierto de 7:00 "
+            "a 15:00.",
+            "Por favor, revisa también el informe adjunto sobre las devoluciones del último mes: el 3,5 % de los "
+            "pedidos llegó con el embalaje dañado y queremos proponer un cambio de proveedor de cajas.",
+            "Si tienes dudas sobre la facturación, puedes escribir directamente a contabilidad o llamarme al "
+            "912 345 678 en horario de oficina.",
+        };
+        for (int round = 0; round < 4; ++round) {
+            for (const auto& paragraph : paragraphs) {
+                text += paragraph + "\n\n";
+            }
+        }
+        text += "Un saludo,\n\nCarlos Pérez\nDepartamento de Logística\nTel. 912 345 678";
+        return text;
+    }();
+    return size == Short ? shortEmail : size == Medium ? mediumEmail : longEmail;
+}
+
+// Raw decoder output the post-processors see (spacing and date/number artifacts kept)
+const std::string& danishOutput(int size) {
+    static const std::string shortText = "Hej Marta ,  tak for din e-mail . Jeg ringer i morgen kl. 10:00 .";
+    static const std::string mediumText =
+        "Godmorgen ,\n\nVedhæftet faktura nummer 2025-0142 for september måned .\n\n"
+        "Det samlede beløb er 1.250,00 euro og betalingsfristen er 30 dage fra udstedelsesdatoen 01/10/2025 . "
+        "Vi ville sætte pris på , at I bekræfter modtagelsen af dette dokument og fortæller os , om I har brug "
+        "for en papirkopi til jeres regnskab .\n\nVi står til rådighed for spørgsmål .\n\n"
+        "Med venlig hilsen ,\n\nLucía Gómez\nAdministration";
+    static const std::string longText = [] {
+        std::string text;
+        for (int i = 0; i < 8; ++i) {
+            text += mediumText + "\n\n";
+        }
+        return text;
+    }();
+    return size == Short ? shortText : size == Medium ? mediumText : longText;
+}
+
+const std::string& spanishOutput(int size) {
+    static const std::string shortText = "Hola Marta ,  gracias por tu correo . Te llamo mañana a las 10:00 .";
+    static const std::string mediumText =
+        "Buenos días ,\n\nAdjunto la factura número 2025-0142 del mes de septiembre .\n\n"
+        "El importe total es de 1.250,00 euros y el plazo de pago es de 30 días desde el 01/10/2025 . "
+        "Les agradeceríamos que confirmaran la recepción de este documento .\n\n"
+        "Saludos cordiales ,\n\nLucía Gómez";
+    static const std::string longText = [] {
+        std::string text;
+        for (int i = 0; i < 8; ++i) {
+            text += mediumText + "\n\n";
+        }
+        return text;
+    }();
+    return size == Short ? shortText : size == Medium ? mediumText : longText;
+}
+
+void emailSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("email")->Arg(Short)->Arg(Medium)->Arg(Long);
+}
+
+void setBytes(benchmark::State& state, const std::string& text) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+
+} // namespace
+
+// ---- Translation cache key ----
+
+static void BM_MakeCacheKey(benchmark::State& state) {
+    const std::string& text = spanishEmail(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(traductor::TranslatorEngine::makeCacheKey(text, "es-da", "balanced"));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_MakeCacheKey)->Apply(emailSizes);
+
+// ---- LRUCache: 90% hits, 10% puts, shared by 1..N threads ----
+
+static void BM_LRUCacheGetPut(benchmark::State& state) {
+    constexpr size_t kEntries = 4096;
+    static std::unique_ptr<traductor::LRUCache> cache;
+    static std::vector<std::string> keys;
+    if (state.thread_index() == 0) {
+        cache = std::make_unique<traductor::LRUCache>(kEntries);
+        keys.clear();
+        for (size_t i = 0; i < kEntries * 2; ++i) {
+            keys.push_back("es-da|balanced||" + spanishEmail(Short) + " #" + std::to_string(i));
+            if (i < kEntries) {
+                cache->put(keys.back(), danishOutput(Short));
+            }
+        }
+    }
+    // Google Benchmark starts timing only after every thread has reached the loop
+
+    const std::string& value = danishOutput(Short);
+    uint64_t i = static_cast<uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        i = i * 6364136223846793005ULL + 1442695040888963407ULL;
+        const std::string& key = keys[(i >> 33) % (i % 10 == 0 ? keys.size() : kEntries)];
+        if (i % 10 == 0) {
+            cache->put(key, value);
+        } else {
+            benchmark::DoNotOptimize(cache->get(key));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LRUCacheGetPut)->ThreadRange(1, 8)->UseRealTime();
+
+// ---- Segmenter ----
+
+static void BM_Segment(benchmark::State& state) {
+    traductor::Segmenter segmenter(static_cast<size_t>(traductor::Config().maxSegmentChars()));
+    const std::string& text = spanishEmail(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(segmenter.segment(text));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_Segment)->Apply(emailSizes);
+
+// ---- Glossary with 10..10k terms (a few of them occur in the text) ----
+
+namespace {
+
+traductor::Glossary makeGlossary(size_t terms) {
+    traductor::Glossary::TermMap map = {
+        {"factura", "faktura"}, {"Copenhague", "København"}, {"contabilidad", "regnskab"},
+        {"proveedor", "leverandør"}, {"almacén", "lager"},
+    };
+    for (size_t i = map.size(); i < terms; ++i) {
+        map["término" + std::to_string(i)] = "term" + std::to_string(i);
+    }
+    traductor::Glossary glossary;
+    glossary.setTerms(map);
+    return glossary;
+}
+
+void glossarySizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"terms", "email"});
+    for (int64_t terms : {10, 100, 1000, 10000}) {
+        for (int64_t size : {Medium, Long}) {
+            bench->Args({terms, size});
+        }
+    }
+}
+
+} // namespace
+
+static void BM_GlossaryPreProcessing(benchmark::State& state) {
+    auto glossary = makeGlossary(static_cast<size_t>(state.range(0)));
+    const std::string& text = spanishEmail(static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(glossary.applyPreProcessing(text));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_GlossaryPreProcessing)->Apply(glossarySizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_GlossaryPostProcessing(benchmark::State& state) {
+    auto glossary = makeGlossary(static_cast<size_t>(state.range(0)));
+    // What the decoder returns for a protected text: the markers survive translation
+    const std::string translated = glossary.applyPreProcessing(spanishEmail(static_cast<int>(state.range(1))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(glossary.applyPostProcessing(translated));
+    }
+    setBytes(state, translated);
+}
+BENCHMARK(BM_GlossaryPostProcessing)->Apply(glossarySizes)->Unit(benchmark::kMicrosecond);
+
+// ---- Post-processing ----
+
+static void BM_PostprocessDA(benchmark::State& state) {
+    const std::string& text = danishOutput(static_cast<int>(state.range(0)));
+    const bool formal = state.range(1) != 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(traductor::PostprocessDA::process(text, formal));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_PostprocessDA)->ArgNames({"email", "formal"})->ArgsProduct({{Short, Medium, Long}, {0, 1}});
+
+static void BM_PostprocessES(benchmark::State& state) {
+    const std::string& text = spanishOutput(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(traductor::PostprocessES::process(text));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_PostprocessES)->Apply(emailSizes);
+
+// ---- Tokenizer (needs the SentencePiece model; TRADUCTOR_SP_MODEL overrides the config path) ----
+
+namespace {
+
+traductor::Tokenizer* sharedTokenizer() {
+    static std::unique_ptr<traductor::Tokenizer> tokenizer = []() -> std::unique_ptr<traductor::Tokenizer> {
+        std::string path = std::getenv("TRADUCTOR_SP_MODEL") ? std::getenv("TRADUCTOR_SP_MODEL")
+                           : (std::filesystem::path(traductor::Config().modelDir()) / "sentencepiece.bpe.model").string();
+        auto created = std::make_unique<traductor::Tokenizer>();
+        created->setCacheSize(0);  // measure SentencePiece, not the segment cache
+        if (!created->load(path)) {
+            return nullptr;
+        }
+        return created;
+    }();
+    return tokenizer.get();
+}
+
+} // namespace
+
+static void BM_TokenizerEncode(benchmark::State& state) {
+    auto* tokenizer = sharedTokenizer();
+    if (!tokenizer) {
+        state.SkipWithError("SentencePiece model not found (set TRADUCTOR_SP_MODEL)");
+        return;
+    }
+    const std::string& text = spanishEmail(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer->encode(text, "spa_Latn"));
+    }
+    setBytes(state, text);
+}
+BENCHMARK(BM_TokenizerEncode)->Apply(emailSizes);
+
+static void BM_TokenizerDecode(benchmark::State& state) {
+    auto* tokenizer = sharedTokenizer();
+    if (!tokenizer) {
+        state.SkipWithError("SentencePiece model not found (set TRADUCTOR_SP_MODEL)");
+        return;
+    }
+    const std::string& text = spanishEmail(static_cast<int>(state.range(0)));
+    const auto ids = tokenizer->encode(text, "spa_Latn");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tokenizer->decode(ids));
+    }
+    state.counters["tokens"] = static_cast<double>(ids.size());
+    setBytes(state, text);
+}
+BENCHMARK(BM_TokenizerDecode)->Apply(emailSizes);
+
+int main(int argc, char** argv) {
+    // JSON results file by default, next to the usual console table
+    std::vector<char*> args(argv, argv + argc);
+    std::string out = "--benchmark_out=traductor_bench.json";
+    std::string format = "--benchmark_out_format=json";
+    bool hasOut = false;
+    for (int i = 1; i < argc; ++i) {
+        hasOut = hasOut || std::string(argv[i]).rfind("--benchmark_out=", 0) == 0;
+    }
+    if (!hasOut) {
+        args.push_back(out.data());
+        args.push_back(format.data());
+    }
+    int count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("traductor_max_segment_chars", std::to_string(traductor::Config().maxSegmentChars()));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
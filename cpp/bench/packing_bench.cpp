@@ -0,0 +1,203 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include "../core/TranslatorEngine.h"
+#include "../core/Config.h"
+
+// Segment packing benchmark: runs the same email corpus once without packing
+// and once per target token length, and reports throughput next to two quality
+// proxies: how often the boundary markers survived translation, and how many
+// emails come out identical to the unpacked baseline.
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --corpus FILE        Emails separated by lines containing only '---'\n";
+    std::cout << "                       (default: assets/bench_emails.txt)\n";
+    std::cout << "  --direction DIR      Translation direction: es-da or da-es (default: es-da)\n";
+    std::cout << "  --targets LIST       Comma-separated pack target token lengths (default: 32,64,128)\n";
+    std::cout << "  --max_unit_tokens N  Only pack units up to N estimated tokens (default: config)\n";
+    std::cout << "  --max_segment_chars N Segment size used for all runs (default: config)\n";
+    std::cout << "  --config FILE        Load configuration from JSON file\n";
+    std::cout << "  --help               Show this help message\n";
+}
+
+std::vector<std::string> loadCorpus(const std::string& filepath) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open corpus " << filepath << std::endl;
+        return {};
+    }
+
+    std::vector<std::string> emails;
+    std::string current;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line == "---") {
+            if (!current.empty()) emails.push_back(current);
+            current.clear();
+            continue;
+        }
+        if (!current.empty()) current += "\n";
+        current += line;
+    }
+    if (!current.empty()) emails.push_back(current);
+
+    return emails;
+}
+
+std::vector<int> parseTargets(const std::string& list) {
+    std::vector<int> targets;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int value = std::atoi(item.c_str());
+        if (value > 0) targets.push_back(value);
+    }
+    return targets;
+}
+
+struct RunResult {
+    int targetTokens = 0;  // 0 = packing disabled
+    double seconds = 0.0;
+    size_t sequences = 0;
+    size_t packed = 0;
+    size_t fallbacks = 0;
+    std::vector<std::string> outputs;
+};
+
+bool runCorpus(traductor::Config config, bool pack, int targetTokens,
+               const std::vector<std::string>& corpus, const std::string& direction,
+               RunResult& run) {
+    config.setPackShortSegments(pack);
+    if (pack) config.setPackTargetTokens(targetTokens);
+
+    traductor::TranslatorEngine engine(config);
+    if (!engine.initialize()) {
+        std::cerr << "Error: Failed to initialize translator: "
+                  << engine.getHealthInfo().lastError << std::endl;
+        return false;
+    }
+
+    run.targetTokens = pack ? targetTokens : 0;
+    run.outputs.reserve(corpus.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& email : corpus) {
+        run.outputs.push_back(engine.translate(email, direction));
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto health = engine.getHealthInfo();
+    run.sequences = health.decoderSequences;
+    run.packed = health.packedSegments;
+    run.fallbacks = health.packingFallbacks;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string corpusFile = "assets/bench_emails.txt";
+    std::string direction = "es-da";
+    std::string targetList = "32,64,128";
+    std::string configFile;
+    int maxUnitTokens = -1;
+    int maxSegmentChars = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--corpus" && i + 1 < argc) {
+            corpusFile = argv[++i];
+        } else if (arg == "--direction" && i + 1 < argc) {
+            direction = argv[++i];
+        } else if (arg == "--targets" && i + 1 < argc) {
+            targetList = argv[++i];
+        } else if (arg == "--max_unit_tokens" && i + 1 < argc) {
+            maxUnitTokens = std::atoi(argv[++i]);
+        } else if (arg == "--max_segment_chars" && i + 1 < argc) {
+            maxSegmentChars = std::atoi(argv[++i]);
+        } else if (arg == "--config" && i + 1 < argc) {
+            configFile = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    traductor::Config config;
+    if (!configFile.empty() && !config.loadFromFile(configFile)) {
+        std::cerr << "Error: Failed to load config from " << configFile << std::endl;
+        return 1;
+    }
+    if (maxUnitTokens > 0) config.setPackMaxUnitTokens(maxUnitTokens);
+    if (maxSegmentChars > 0) config.setMaxSegmentChars(maxSegmentChars);
+
+    auto corpus = loadCorpus(corpusFile);
+    auto targets = parseTargets(targetList);
+    if (corpus.empty() || targets.empty()) {
+        std::cerr << "Error: Empty corpus or target list" << std::endl;
+        return 1;
+    }
+
+    size_t corpusChars = 0;
+    for (const auto& email : corpus) corpusChars += email.size();
+
+    // Baseline without packing
+    std::vector<RunResult> runs(1);
+    if (!runCorpus(config, false, 0, corpus, direction, runs[0])) {
+        return 1;
+    }
+    for (int target : targets) {
+        RunResult run;
+        if (!runCorpus(config, true, target, corpus, direction, run)) {
+            return 1;
+        }
+        runs.push_back(std::move(run));
+    }
+
+    const RunResult& baseline = runs[0];
+
+    std::cout << "\n=== SEGMENT PACKING ===" << std::endl;
+    std::cout << "Corpus: " << corpus.size() << " emails, " << corpusChars << " chars" << std::endl;
+    std::cout << std::left
+              << std::setw(8) << "target"
+              << std::setw(11) << "sequences"
+              << std::setw(12) << "emails/s"
+              << std::setw(10) << "speedup"
+              << std::setw(10) << "packed"
+              << std::setw(14) << "markers_ok%"
+              << std::setw(14) << "same_as_base%" << std::endl;
+
+    for (const auto& run : runs) {
+        double emailsPerSec = run.seconds > 0 ? corpus.size() / run.seconds : 0.0;
+        double speedup = run.seconds > 0 ? baseline.seconds / run.seconds : 0.0;
+        double markersOk = run.packed > 0
+            ? 100.0 * static_cast<double>(run.packed - run.fallbacks) / run.packed : 100.0;
+
+        size_t identical = 0;
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            if (run.outputs[i] == baseline.outputs[i]) identical++;
+        }
+
+        std::cout << std::left << std::fixed
+                  << std::setw(8) << (run.targetTokens == 0 ? std::string("off") : std::to_string(run.targetTokens))
+                  << std::setw(11) << run.sequences
+                  << std::setw(12) << std::setprecision(2) << emailsPerSec
+                  << std::setw(10) << std::setprecision(2) << speedup
+                  << std::setw(10) << run.packed
+                  << std::setw(14) << std::setprecision(1) << markersOk
+                  << std::setw(14) << std::setprecision(1) << (100.0 * identical / corpus.size())
+                  << std::endl;
+    }
+
+    return 0;
+}
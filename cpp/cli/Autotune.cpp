@@ -0,0 +1,216 @@
+#include "Autotune.h"
+#include "../core/TranslatorEngine.h"
+#include "../core/CpuInfo.h"
+#include "../core/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace traductor {
+
+namespace {
+
+// Short business emails, the typical workload. Long enough to span several
+// segments, short enough that a full grid finishes in minutes.
+const char* const kSpanishCorpus[] = {
+    "Hola Marta,\n\nGracias por tu correo de ayer. Te confirmo que la reunión con el equipo de "
+    "Copenhague será el martes a las 10:00 en la sala grande.\n\nUn saludo,\nCarlos",
+    "Buenos días,\n\nAdjunto la factura correspondiente al mes de septiembre. El plazo de pago es "
+    "de 30 días desde la fecha de emisión. Les agradeceríamos que confirmaran la recepción.\n\n"
+    "Atentamente,\nLucía Gómez\nAdministración",
+    "Hola,\n\n¿Podrías enviarme el informe antes del viernes? Necesito revisar las cifras de ventas "
+    "antes de la reunión con el cliente.\n\nGracias,\nPablo",
+    "Estimado cliente,\n\nLe informamos de que su pedido ha sido enviado y llegará en un plazo de "
+    "tres a cinco días laborables. Puede seguir el envío desde su área personal.\n\n"
+    "Un cordial saludo,\nAtención al cliente",
+    "Hola equipo,\n\nMañana no podré asistir a la reunión de las nueve. Os dejo mis comentarios "
+    "sobre la propuesta en el documento compartido.\n\nSaludos,\nAna",
+    "Buenas tardes,\n\nQuería preguntar si es posible cambiar la fecha de entrega del proyecto. "
+    "Hemos tenido problemas con un proveedor y necesitamos una semana más.\n\nGracias por su "
+    "comprensión,\nMiguel",
+};
+
+const char* const kDanishCorpus[] = {
+    "Hej Marta,\n\nTak for din mail i går. Jeg bekræfter, at mødet med holdet i Madrid bliver "
+    "tirsdag klokken 10 i det store mødelokale.\n\nMed venlig hilsen,\nCarlos",
+    "Godmorgen,\n\nVedhæftet er fakturaen for september. Betalingsfristen er 30 dage fra "
+    "udstedelsesdatoen. Vi vil sætte pris på en bekræftelse af modtagelsen.\n\nVenlig hilsen,\nLucía",
+    "Hej,\n\nKan du sende mig rapporten inden fredag? Jeg skal gennemgå salgstallene før mødet "
+    "med kunden.\n\nTak,\nPablo",
+    "Kære kunde,\n\nVi kan oplyse, at din ordre er afsendt og vil ankomme inden for tre til fem "
+    "hverdage.\n\nMed venlig hilsen,\nKundeservice",
+};
+
+constexpr int kCorpusRepeats = 8;
+
+// Each copy gets its own reference line so the translation cache never
+// short-circuits a run; pass a different tag for every pass over the corpus
+std::vector<std::string> builtinCorpus(const std::string& direction, const std::string& tag) {
+    std::vector<std::string> corpus;
+    auto append = [&corpus, &tag](const auto& emails) {
+        for (int r = 0; r < kCorpusRepeats; ++r) {
+            for (const char* email : emails) {
+                corpus.push_back(std::string(email) + "\n\nRef. " + tag + "-" + std::to_string(r));
+            }
+        }
+    };
+    if (direction == "da-es") {
+        append(kDanishCorpus);
+    } else {
+        append(kSpanishCorpus);
+    }
+    return corpus;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+} // namespace
+
+Autotune::Autotune(const Config& base, Grid grid, std::string objective)
+    : base_(base), grid_(std::move(grid)), objective_(std::move(objective)) {}
+
+std::vector<int> Autotune::parseList(const std::string& list) {
+    std::vector<int> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int value = std::atoi(item.c_str());
+        if (value > 0) values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<Autotune::Point> Autotune::candidates() const {
+    const int cores = CpuInfo::logicalCores();
+    std::vector<Point> points;
+    for (int replicas : grid_.replicas) {
+        for (int intra : grid_.intraThreads) {
+            if (replicas * intra > cores) continue;
+            for (int tokens : grid_.batchTokens) {
+                for (int chars : grid_.segmentChars) {
+                    Point point;
+                    point.replicas = replicas;
+                    point.intraThreads = intra;
+                    point.batchTokens = tokens;
+                    point.segmentChars = chars;
+                    points.push_back(point);
+                }
+            }
+        }
+    }
+    return points;
+}
+
+Config Autotune::configFor(const Point& point) const {
+    Config config = base_;
+    config.setCt2InterThreads(point.replicas);
+    config.setCt2IntraThreads(point.intraThreads);
+    config.setMaxBatchTokens(point.batchTokens);
+    config.setMaxSegmentChars(point.segmentChars);
+    return config;
+}
+
+bool Autotune::measure(Point& point, const std::string& direction) const {
+    Config config = configFor(point);
+    config.setAdmissionEnabled(false);  // measure the whole corpus, never refuse it
+    TranslatorEngine engine(config);
+    if (!engine.initialize()) {
+        TRADUCTOR_LOG(Error, "autotune") << "Failed to initialize translator: " << engine.getHealthInfo().lastError;
+        return false;
+    }
+    
+    // Warm-up, so one-time allocations do not land in the first sample
+    engine.translate(builtinCorpus(direction, "warmup").front(), direction);
+    
+    // Throughput: the whole corpus in one call keeps every replica busy
+    auto corpus = builtinCorpus(direction, "batch");
+    auto start = std::chrono::steady_clock::now();
+    engine.translate(corpus, direction);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    point.throughput = seconds > 0 ? static_cast<double>(corpus.size()) / seconds : 0.0;
+    
+    // Latency: one email per request, as the REST server sees them
+    auto requests = builtinCorpus(direction, "single");
+    std::vector<double> latencies;
+    latencies.reserve(requests.size());
+    for (const auto& email : requests) {
+        auto begin = std::chrono::steady_clock::now();
+        engine.translate(email, direction);
+        latencies.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin).count());
+    }
+    point.p50Ms = percentile(latencies, 0.50);
+    point.p99Ms = percentile(latencies, 0.99);
+    return true;
+}
+
+bool Autotune::run(const std::string& direction) {
+    auto corpusSize = builtinCorpus(direction, "").size();
+    auto points = candidates();
+    if (points.empty()) {
+        TRADUCTOR_LOG(Error, "autotune") << "No grid point fits on " << CpuInfo::logicalCores() << " cores";
+        return false;
+    }
+    
+    std::cout << "Autotuning " << points.size() << " configurations on "
+              << CpuInfo::logicalCores() << " cores (" << corpusSize << " emails each)" << std::endl;
+    std::cout << std::left << std::setw(10) << "replicas" << std::setw(8) << "intra"
+              << std::setw(14) << "batch_tokens" << std::setw(15) << "segment_chars"
+              << std::setw(12) << "emails/s" << std::setw(10) << "p50 ms" << "p99 ms" << std::endl;
+    
+    results_.clear();
+    for (auto& point : points) {
+        if (!measure(point, direction)) {
+            continue;
+        }
+        results_.push_back(point);
+        std::cout << std::left << std::setw(10) << point.replicas << std::setw(8) << point.intraThreads
+                  << std::setw(14) << point.batchTokens << std::setw(15) << point.segmentChars
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << point.throughput << std::setw(10) << point.p50Ms
+                  << point.p99Ms << std::endl;
+    }
+    
+    if (results_.empty()) {
+        return false;
+    }
+    
+    auto better = [this](const Point& a, const Point& b) {
+        if (objective_ == "latency") {
+            return a.p99Ms < b.p99Ms || (a.p99Ms == b.p99Ms && a.throughput > b.throughput);
+        }
+        return a.throughput > b.throughput || (a.throughput == b.throughput && a.p99Ms < b.p99Ms);
+    };
+    bestIndex_ = 0;
+    for (size_t i = 1; i < results_.size(); ++i) {
+        if (better(results_[i], results_[bestIndex_])) {
+            bestIndex_ = i;
+        }
+    }
+    return true;
+}
+
+Config Autotune::bestConfig() const {
+    return configFor(best());
+}
+
+bool Autotune::writeBestConfig(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        TRADUCTOR_LOG(Error, "autotune") << "Cannot write to file " << path;
+        return false;
+    }
+    file << bestConfig().toJson().dump(2) << std::endl;
+    return true;
+}
+
+} // namespace traductor
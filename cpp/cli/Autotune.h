@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../core/Config.h"
+
+namespace traductor {
+
+/**
+ * Thread-layout tuner for the CLI --autotune mode.
+ * Runs a built-in email corpus over a grid of (replicas, intra threads,
+ * batch token budget, max segment chars), prints throughput and p99 latency
+ * for each point and writes the best configuration as a loadable JSON file.
+ */
+class Autotune {
+public:
+    struct Grid {
+        std::vector<int> replicas = {1, 2, 4, 8};
+        std::vector<int> intraThreads = {1, 2, 4, 8};
+        std::vector<int> batchTokens = {512, 1024, 2048};
+        std::vector<int> segmentChars = {400, 800};
+    };
+    
+    struct Point {
+        int replicas = 0;
+        int intraThreads = 0;
+        int batchTokens = 0;
+        int segmentChars = 0;
+        double throughput = 0.0;  // emails per second with all replicas busy
+        double p50Ms = 0.0;       // single-request latency
+        double p99Ms = 0.0;
+    };
+    
+    // "throughput" picks the highest emails/s, "latency" the lowest p99
+    Autotune(const Config& base, Grid grid, std::string objective = "throughput");
+    
+    // Runs the whole grid; returns false if no point could be measured
+    bool run(const std::string& direction);
+    
+    const std::vector<Point>& results() const { return results_; }
+    const Point& best() const { return results_[bestIndex_]; }
+    
+    // Base configuration with the best point applied
+    Config bestConfig() const;
+    bool writeBestConfig(const std::string& path) const;
+    
+    // Grid points that fit on this machine (replicas x intra <= logical cores)
+    std::vector<Point> candidates() const;
+    
+    static std::vector<int> parseList(const std::string& list);
+
+private:
+    Config base_;
+    Grid grid_;
+    std::string objective_;
+    std::vector<Point> results_;
+    size_t bestIndex_ = 0;
+    
+    bool measure(Point& point, const std::string& direction) const;
+    Config configFor(const Point& point) const;
+};
+
+} // namespace traductor
@@ -9,6 +9,8 @@
 #include "../core/TranslatorEngine.h"
 #include "../core/Config.h"
 #include "../core/Glossary.h"
+#include "../core/Logger.h"
+#include "Autotune.h"
 
 void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [OPTIONS]\n\n";
@@ -16,23 +18,36 @@ void printUsage(const char* programName) {
     std::cout << "  --direction DIR     Translation direction: es-da or da-es (default: es-da)\n";
     std::cout << "  --formal           Use formal Danish style\n";
     std::cout << "  --max_tokens N     Maximum tokens to generate (default: auto)\n";
+    std::cout << "  --profile NAME     Decoding profile: fast, balanced, quality (default: config)\n";
+    std::cout << "  --priority CLASS   Scheduling lane: interactive or bulk (default: the profile's)\n";
     std::cout << "  --in FILE          Input text file (stdin if not specified)\n";
     std::cout << "  --out FILE         Output file (stdout if not specified)\n";
     std::cout << "  --html             HTML mode for email translation\n";
+    std::cout << "  --stream           Translate paragraph by paragraph with bounded memory\n";
+    std::cout << "                     (automatic for input files larger than 1 MB)\n";
     std::cout << "  --metrics          Show detailed performance metrics\n";
+    std::cout << "  --trace FILE       Write a Chrome trace of this run to FILE (chrome://tracing)\n";
     std::cout << "  --glossary FILE    Load glossary from file (format: term_es=term_da)\n";
     std::cout << "  --config FILE      Load configuration from JSON file\n";
+    std::cout << "  --autotune FILE    Benchmark thread layouts and write the best config to FILE\n";
+    std::cout << "  --tune_replicas LIST       Replica counts to try (default: 1,2,4,8)\n";
+    std::cout << "  --tune_intra LIST          Intra threads per replica (default: 1,2,4,8)\n";
+    std::cout << "  --tune_batch_tokens LIST   Batch token budgets (default: 512,1024,2048)\n";
+    std::cout << "  --tune_segment_chars LIST  Max segment chars (default: 400,800)\n";
+    std::cout << "  --tune_objective OBJ       throughput or latency (default: throughput)\n";
     std::cout << "  --help             Show this help message\n\n";
     std::cout << "Examples:\n";
     std::cout << "  " << programName << " --direction es-da --in input.txt --out output.txt\n";
     std::cout << "  " << programName << " --direction da-es --formal --html --metrics < email.html\n";
+    std::cout << "  " << programName << " --direction es-da --stream --in book.txt --out book_da.txt\n";
+    std::cout << "  " << programName << " --autotune tuned.json --tune_replicas 2,4,8 --tune_intra 2,4\n";
     std::cout << "  echo \"Hola mundo\" | " << programName << " --direction es-da --metrics\n";
 }
 
 std::string loadFile(const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+        TRADUCTOR_LOG(Error, "cli") << "Cannot open file " << filepath;
         return "";
     }
     
@@ -45,7 +60,7 @@ std::string loadFile(const std::string& filepath) {
 bool saveFile(const std::string& filepath, const std::string& content) {
     std::ofstream file(filepath);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot write to file " << filepath << std::endl;
+        TRADUCTOR_LOG(Error, "cli") << "Cannot write to file " << filepath;
         return false;
     }
     
@@ -63,7 +78,7 @@ traductor::Glossary::TermMap loadGlossary(const std::string& filepath) {
     }
     
     if (!glossary.loadFromString(content)) {
-        std::cerr << "Warning: Failed to load glossary from " << filepath << std::endl;
+        TRADUCTOR_LOG(Warning, "cli") << "Failed to load glossary from " << filepath;
         return {};
     }
     
@@ -79,8 +94,14 @@ int main(int argc, char* argv[]) {
     std::string outputFile;
     bool htmlMode = false;
     bool showMetrics = false;
+    bool streamMode = false;
+    traductor::RequestOptions requestOptions;
     std::string glossaryFile;
     std::string configFile;
+    std::string autotuneFile;
+    std::string traceFile;
+    traductor::Autotune::Grid tuneGrid;
+    std::string tuneObjective = "throughput";
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -102,18 +123,47 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: max_tokens must be positive" << std::endl;
                 return 1;
             }
+        } else if (arg == "--profile" && i + 1 < argc) {
+            requestOptions.profile = argv[++i];
+        } else if (arg == "--priority" && i + 1 < argc) {
+            std::string priority = argv[++i];
+            if (!traductor::parsePriority(priority, requestOptions.priority)) {
+                std::cerr << "Error: Unknown priority '" << priority << "' (use interactive or bulk)" << std::endl;
+                return 1;
+            }
         } else if (arg == "--in" && i + 1 < argc) {
             inputFile = argv[++i];
         } else if (arg == "--out" && i + 1 < argc) {
             outputFile = argv[++i];
         } else if (arg == "--html") {
             htmlMode = true;
+        } else if (arg == "--stream") {
+            streamMode = true;
         } else if (arg == "--metrics") {
             showMetrics = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+            requestOptions.trace = true;
         } else if (arg == "--glossary" && i + 1 < argc) {
             glossaryFile = argv[++i];
         } else if (arg == "--config" && i + 1 < argc) {
             configFile = argv[++i];
+        } else if (arg == "--autotune" && i + 1 < argc) {
+            autotuneFile = argv[++i];
+        } else if (arg == "--tune_replicas" && i + 1 < argc) {
+            tuneGrid.replicas = traductor::Autotune::parseList(argv[++i]);
+        } else if (arg == "--tune_intra" && i + 1 < argc) {
+            tuneGrid.intraThreads = traductor::Autotune::parseList(argv[++i]);
+        } else if (arg == "--tune_batch_tokens" && i + 1 < argc) {
+            tuneGrid.batchTokens = traductor::Autotune::parseList(argv[++i]);
+        } else if (arg == "--tune_segment_chars" && i + 1 < argc) {
+            tuneGrid.segmentChars = traductor::Autotune::parseList(argv[++i]);
+        } else if (arg == "--tune_objective" && i + 1 < argc) {
+            tuneObjective = argv[++i];
+            if (tuneObjective != "throughput" && tuneObjective != "latency") {
+                std::cerr << "Error: Invalid objective. Use 'throughput' or 'latency'" << std::endl;
+                return 1;
+            }
         } else {
             std::cerr << "Error: Unknown option " << arg << std::endl;
             printUsage(argv[0]);
@@ -125,7 +175,42 @@ int main(int argc, char* argv[]) {
     traductor::Config config;
     if (!configFile.empty()) {
         if (!config.loadFromFile(configFile)) {
-            std::cerr << "Error: Failed to load config from " << configFile << std::endl;
+            TRADUCTOR_LOG(Error, "cli") << "Failed to load config from " << configFile;
+            return 1;
+        }
+    }
+    traductor::Logger::instance().configure(traductor::Logger::Options::fromConfig(config));
+    
+    // Autotune mode: benchmark the grid instead of translating
+    if (!autotuneFile.empty()) {
+        traductor::Autotune tuner(config, tuneGrid, tuneObjective);
+        if (!tuner.run(direction)) {
+            TRADUCTOR_LOG(Error, "cli") << "Autotune failed";
+            return 1;
+        }
+        
+        const auto& best = tuner.best();
+        std::cout << "Best (" << tuneObjective << "): " << best.replicas << " replicas x "
+                  << best.intraThreads << " intra threads, max_batch_tokens " << best.batchTokens
+                  << ", max_segment_chars " << best.segmentChars << " -> "
+                  << std::fixed << std::setprecision(2) << best.throughput << " emails/s, p99 "
+                  << best.p99Ms << "ms" << std::endl;
+        
+        if (!tuner.writeBestConfig(autotuneFile)) {
+            return 1;
+        }
+        std::cout << "Configuration saved to " << autotuneFile << std::endl;
+        return 0;
+    }
+    
+    if (!requestOptions.profile.empty()) {
+        traductor::DecodingProfile profile;
+        if (!config.findDecodingProfile(requestOptions.profile, profile)) {
+            std::cerr << "Error: Unknown profile '" << requestOptions.profile << "'. Available:";
+            for (const auto& name : config.decodingProfileNames()) {
+                std::cerr << " " << name;
+            }
+            std::cerr << std::endl;
             return 1;
         }
     }
@@ -135,32 +220,92 @@ int main(int argc, char* argv[]) {
     if (!glossaryFile.empty()) {
         glossary = loadGlossary(glossaryFile);
         if (!glossary.empty()) {
-            std::cout << "Loaded glossary with " << glossary.size() << " terms" << std::endl;
+            TRADUCTOR_LOG(Info, "cli") << "Loaded glossary with " << glossary.size() << " terms";
         }
     }
     
+    if (!traceFile.empty()) {
+        config.setTraceFile(traceFile);
+    }
+    
     // Initialize translator
+    // Single local user: nothing to shed, and a long document must not be refused
+    config.setAdmissionEnabled(false);
     traductor::TranslatorEngine translator(config);
     
-    std::cout << "Initializing translator..." << std::endl;
+    TRADUCTOR_LOG(Info, "cli") << "Initializing translator...";
     auto startTime = std::chrono::steady_clock::now();
     
     if (!translator.initialize()) {
         auto health = translator.getHealthInfo();
-        std::cerr << "Error: Failed to initialize translator" << std::endl;
-        std::cerr << "Details: " << health.lastError << std::endl;
+        TRADUCTOR_LOG(Error, "cli") << "Failed to initialize translator: " << health.lastError;
         return 1;
     }
     
     auto initTime = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now() - startTime);
-    std::cout << "Translator ready (" << initTime.count() << "ms)" << std::endl;
+    TRADUCTOR_LOG(Info, "cli") << "Translator ready (" << initTime.count() << "ms)";
+    
+    // Large inputs are translated as a stream instead of being loaded whole
+    constexpr std::uintmax_t kStreamThresholdBytes = 1024 * 1024;
+    if (!htmlMode && !inputFile.empty() && !streamMode) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(inputFile, ec);
+        streamMode = !ec && size > kStreamThresholdBytes;
+    }
+    
+    if (streamMode && !htmlMode) {
+        std::ifstream inFile;
+        if (!inputFile.empty()) {
+            inFile.open(inputFile);
+            if (!inFile.is_open()) {
+                TRADUCTOR_LOG(Error, "cli") << "Cannot open file " << inputFile;
+                return 1;
+            }
+        }
+        std::istream& in = inputFile.empty() ? std::cin : inFile;
+        
+        std::ofstream outFile;
+        if (!outputFile.empty()) {
+            outFile.open(outputFile);
+            if (!outFile.is_open()) {
+                TRADUCTOR_LOG(Error, "cli") << "Cannot write to file " << outputFile;
+                return 1;
+            }
+        }
+        std::ostream& out = outputFile.empty() ? std::cout : outFile;
+        
+        TRADUCTOR_LOG(Info, "cli") << "Translating (streaming)...";
+        bool first = true;
+        auto stream = translator.translateStream(in, [&](const std::string& paragraph) {
+            if (!first) out << "\n\n";
+            out << paragraph;
+            out.flush();
+            first = false;
+        }, direction, maxTokens, formal, glossary, requestOptions);
+        out << std::endl;
+        
+        if (!stream.complete) {
+            TRADUCTOR_LOG(Error, "cli") << "Translation stopped early: " << translator.getHealthInfo().lastError;
+            return 1;
+        }
+        const size_t paragraphs = stream.paragraphs;
+        if (paragraphs == 0) {
+            TRADUCTOR_LOG(Error, "cli") << "No input provided";
+            return 1;
+        }
+        if (!outputFile.empty()) {
+            std::cout << "Translation saved to " << outputFile << std::endl;
+        }
+        std::cout << "Translated " << paragraphs << " paragraphs" << std::endl;
+        return 0;
+    }
     
     // Load input
     std::string input;
     if (inputFile.empty()) {
         // Read from stdin
-        std::cout << "Reading from stdin..." << std::endl;
+        TRADUCTOR_LOG(Info, "cli") << "Reading from stdin...";
         std::string line;
         while (std::getline(std::cin, line)) {
             if (!input.empty()) input += "\n";
@@ -174,28 +319,28 @@ int main(int argc, char* argv[]) {
     }
     
     if (input.empty()) {
-        std::cerr << "Error: No input provided" << std::endl;
+        TRADUCTOR_LOG(Error, "cli") << "No input provided";
         return 1;
     }
     
     // Translate
-    std::cout << "Translating..." << std::endl;
+    TRADUCTOR_LOG(Info, "cli") << "Translating...";
     std::string result;
     
     try {
         if (htmlMode) {
             result = translator.translateHtml(input, direction, maxTokens, formal, glossary);
         } else {
-            result = translator.translate(input, direction, maxTokens, formal, glossary);
+            result = translator.translate(input, direction, maxTokens, formal, glossary, requestOptions);
         }
         
         if (result.empty()) {
-            std::cerr << "Error: Translation failed" << std::endl;
+            TRADUCTOR_LOG(Error, "cli") << "Translation failed";
             return 1;
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "Error during translation: " << e.what() << std::endl;
+        TRADUCTOR_LOG(Error, "cli") << "Error during translation: " << e.what();
         return 1;
     }
     
@@ -214,19 +359,73 @@ int main(int argc, char* argv[]) {
         std::chrono::steady_clock::now() - startTime);
     
     std::cout << "Translation completed successfully" << std::endl;
+    if (!traceFile.empty()) {
+        std::cout << "Trace written to " << traceFile << std::endl;
+    }
     
     if (showMetrics) {
         auto health = translator.getHealthInfo();
         std::cout << "=== METRICS ===" << std::endl;
         std::cout << "Total time: " << totalTime.count() << "ms" << std::endl;
+        std::cout << "Decoding profile: " << (requestOptions.profile.empty() ? config.defaultProfile()
+                                                                             : requestOptions.profile) << std::endl;
         std::cout << "Initialization: " << initTime.count() << "ms" << std::endl;
         std::cout << "Average latency: " << std::fixed << std::setprecision(2) 
                   << translator.getAverageLatency() << "ms" << std::endl;
         std::cout << "Total translations: " << translator.getTotalTranslations() << std::endl;
+        std::cout << "Distributions (p50 / p90 / p99 / max):" << std::endl;
+        for (const auto& series : translator.getMetricsSnapshot().series) {
+            if (series.summary.count == 0) {
+                continue;
+            }
+            std::cout << "  " << std::left << std::setw(18) << series.name << std::right << std::setprecision(2)
+                      << series.summary.p50 << " / " << series.summary.p90 << " / " << series.summary.p99
+                      << " / " << series.summary.max << " " << series.unit
+                      << " (" << series.summary.count << " samples)" << std::endl;
+        }
         std::cout << "Cache entries: " << health.cacheSize << std::endl;
         std::cout << "Cache hit rate: " << std::fixed << std::setprecision(1) 
                   << health.cacheHitRate << "%" << std::endl;
-        std::cout << "Model status: " << (health.modelLoaded ? "Loaded" : "Simplified mode") << std::endl;
+        std::cout << "Tokenizer cache hits: encode " << health.tokenizerEncodeHits
+                  << "/" << (health.tokenizerEncodeHits + health.tokenizerEncodeMisses)
+                  << ", decode " << health.tokenizerDecodeHits
+                  << "/" << (health.tokenizerDecodeHits + health.tokenizerDecodeMisses) << std::endl;
+        std::cout << "Pipeline batches: " << health.batchesCompleted
+                  << " (queues: preprocess " << health.preprocessQueueDepth
+                  << ", inference " << health.inferenceQueueDepth
+                  << ", completion " << health.completionQueueDepth << "; interactive "
+                  << health.interactiveQueued << ", bulk " << health.bulkQueued << " queued)" << std::endl;
+        for (size_t i = 0; i < health.replicas.size(); ++i) {
+            const auto& replica = health.replicas[i];
+            std::cout << "Replica " << i << ": " << replica.batches << " batches, "
+                      << std::fixed << std::setprecision(1) << replica.utilization * 100.0 << "% busy";
+            if (!replica.cores.empty()) {
+                std::cout << " (cores " << replica.cores.front() << "-" << replica.cores.back()
+                          << ", node " << replica.numaNode << ")";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Degradation: " << health.degradation << " (level " << health.degradationLevel
+                  << ", " << health.degradedResponses << " degraded responses)" << std::endl;
+        for (const auto& model : health.models) {
+            std::cout << "Model " << model.name << ": " << model.sequences << " sequences, "
+                      << model.batches << " batches, " << model.avgBatchMs() << " ms/batch";
+            if (model.name == "small") {
+                std::cout << ", " << model.escalations << " escalated";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Admission: " << std::setprecision(0) << health.admission.throughput << " tokens/s measured, "
+                  << health.admission.admitted << " admitted, "
+                  << (health.admission.rejectedOverloaded + health.admission.rejectedTooLarge) << " refused"
+                  << std::setprecision(1) << std::endl;
+        std::cout << "Cancelled: " << health.cancelledRequests << " by caller, " << health.deadlineExceeded
+                  << " past deadline (" << health.batchesCancelled << " batches dropped)" << std::endl;
+        std::cout << "Runaway generations: " << health.repetitionLoops << " (" << health.repetitionRecovered
+                  << " recovered on retry)" << std::endl;
+        std::cout << "Model status: " << (health.modelLoaded ? "Loaded" : "Simplified mode")
+                  << " (" << health.inferenceBackend << " backend)" << std::endl;
+        std::cout << "Compute type: " << health.computeType << " (CPU: " << health.cpuFeatures << ")" << std::endl;
         std::cout << "Tokenizer: " << (health.tokenizerLoaded ? "Ready" : "Not loaded") << std::endl;
     }
     
@@ -0,0 +1,105 @@
+#include "AdmissionController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace traductor {
+
+namespace {
+
+// Weight of a new throughput sample
+constexpr double kThroughputAlpha = 0.3;
+
+} // namespace
+
+AdmissionController::Ticket::~Ticket() {
+    if (controller_) {
+        controller_->release(tokens_, completedTokens_, Clock::now());
+    }
+}
+
+AdmissionController::AdmissionController(Options options)
+    : options_(options),
+      throughput_(std::max(1.0, options.initialThroughput)),
+      lastChange_(Clock::now()) {}
+
+AdmissionController::Decision AdmissionController::admit(size_t tokens, Clock::time_point now) {
+    Decision decision;
+    std::lock_guard<std::mutex> lock(mutex_);
+    accountBusyTime(now);
+    
+    const double cost = static_cast<double>(std::max<size_t>(1, tokens));
+    decision.predictedSeconds = (static_cast<double>(backlogTokens_) + cost) / throughput_;
+    
+    if (options_.enabled && decision.predictedSeconds > options_.deadlineSeconds) {
+        if (cost / throughput_ > options_.deadlineSeconds) {
+            // Would miss the deadline even on an idle server
+            decision.reason = Reason::TooLarge;
+            rejectedTooLarge_++;
+        } else {
+            // Retry once enough of the backlog has drained
+            decision.reason = Reason::Overloaded;
+            decision.retryAfterSeconds = std::max(1, static_cast<int>(
+                std::ceil(decision.predictedSeconds - options_.deadlineSeconds)));
+            rejectedOverloaded_++;
+        }
+        return decision;
+    }
+    
+    backlogTokens_ += tokens;
+    inFlight_++;
+    admitted_++;
+    decision.ticket = std::make_shared<Ticket>(this, tokens);
+    return decision;
+}
+
+AdmissionController::Stats AdmissionController::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.backlogTokens = backlogTokens_;
+    stats.inFlight = inFlight_;
+    stats.throughput = throughput_;
+    stats.predictedWaitSeconds = static_cast<double>(backlogTokens_) / throughput_;
+    stats.admitted = admitted_;
+    stats.rejectedOverloaded = rejectedOverloaded_;
+    stats.rejectedTooLarge = rejectedTooLarge_;
+    return stats;
+}
+
+const char* AdmissionController::reasonName(Reason reason) {
+    switch (reason) {
+        case Reason::Overloaded: return "overloaded";
+        case Reason::TooLarge: return "too_large";
+        default: return "none";
+    }
+}
+
+void AdmissionController::release(size_t tokens, size_t completedTokens, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    accountBusyTime(now);
+    
+    backlogTokens_ -= std::min(tokens, backlogTokens_);
+    inFlight_ -= std::min<size_t>(1, inFlight_);
+    sampleTokens_ += completedTokens;
+    if (sampleTokens_ == 0 && inFlight_ == 0) {
+        // The busy time since the last sample only served cache hits or
+        // cancelled and failed requests, so it says nothing about throughput
+        sampleBusySeconds_ = 0.0;
+        return;
+    }
+    
+    if (sampleBusySeconds_ >= options_.minSampleSeconds) {
+        double sample = static_cast<double>(sampleTokens_) / sampleBusySeconds_;
+        throughput_ = std::max(1.0, kThroughputAlpha * sample + (1.0 - kThroughputAlpha) * throughput_);
+        sampleTokens_ = 0;
+        sampleBusySeconds_ = 0.0;
+    }
+}
+
+void AdmissionController::accountBusyTime(Clock::time_point now) {
+    if (inFlight_ > 0 && now > lastChange_) {
+        sampleBusySeconds_ += std::chrono::duration<double>(now - lastChange_).count();
+    }
+    lastChange_ = std::max(lastChange_, now);
+}
+
+} // namespace traductor
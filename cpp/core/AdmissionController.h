@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace traductor {
+
+/**
+ * Deadline-based admission control. Each request is costed in estimated tokens;
+ * with the admitted-but-unfinished backlog and the measured throughput (tokens
+ * per busy second), the controller predicts when the request would finish and
+ * refuses it up front if that is past the deadline, instead of queueing work
+ * that will time out anyway.
+ */
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Options {
+        bool enabled = true;
+        double deadlineSeconds = 300.0;      // request_timeout
+        double initialThroughput = 200.0;    // tokens/s until measured
+        double minSampleSeconds = 1.0;       // busy time per throughput sample
+    };
+    
+    enum class Reason { None, Overloaded, TooLarge };
+    
+    // Releases its tokens from the backlog when destroyed
+    class Ticket {
+    public:
+        Ticket(AdmissionController* controller, size_t tokens) : controller_(controller), tokens_(tokens) {}
+        ~Ticket();
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        
+        size_t tokens() const { return tokens_; }
+        
+        // Tokens the request actually ran through the model. Only these feed the
+        // throughput sample, so cache hits and cancelled or failed requests
+        // (which never call this) do not inflate it.
+        void setCompletedTokens(size_t tokens) { completedTokens_ = std::min(tokens, tokens_); }
+        
+    private:
+        AdmissionController* controller_;
+        size_t tokens_;
+        size_t completedTokens_ = 0;
+    };
+    
+    struct Decision {
+        std::shared_ptr<Ticket> ticket;  // null when refused
+        Reason reason = Reason::None;
+        double predictedSeconds = 0.0;
+        int retryAfterSeconds = 0;
+        
+        bool admitted() const { return ticket != nullptr; }
+    };
+    
+    struct Stats {
+        size_t backlogTokens = 0;
+        size_t inFlight = 0;
+        double throughput = 0.0;        // tokens per busy second
+        double predictedWaitSeconds = 0.0;
+        size_t admitted = 0;
+        size_t rejectedOverloaded = 0;
+        size_t rejectedTooLarge = 0;
+    };
+    
+    explicit AdmissionController(Options options);
+    
+    Decision admit(size_t tokens, Clock::time_point now = Clock::now());
+    Stats getStats() const;
+    
+    static const char* reasonName(Reason reason);
+
+private:
+    Options options_;
+    mutable std::mutex mutex_;
+    size_t backlogTokens_ = 0;
+    size_t inFlight_ = 0;
+    double throughput_;
+    
+    // Current throughput sample: tokens finished over time spent with work in flight
+    size_t sampleTokens_ = 0;
+    double sampleBusySeconds_ = 0.0;
+    Clock::time_point lastChange_;
+    
+    size_t admitted_ = 0;
+    size_t rejectedOverloaded_ = 0;
+    size_t rejectedTooLarge_ = 0;
+    
+    void release(size_t tokens, size_t completedTokens, Clock::time_point now);
+    void accountBusyTime(Clock::time_point now);
+};
+
+} // namespace traductor
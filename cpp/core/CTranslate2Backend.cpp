@@ -0,0 +1,76 @@
+#include "CTranslate2Backend.h"
+
+#ifdef HAVE_CTRANSLATE2
+
+#include <ctranslate2/translator.h>
+#include <ctranslate2/translation_options.h>
+
+namespace traductor {
+
+namespace {
+
+ctranslate2::ComputeType toCt2ComputeType(const std::string& type) {
+    if (type == "int8_float32") return ctranslate2::ComputeType::INT8_FLOAT32;
+    if (type == "int16") return ctranslate2::ComputeType::INT16;
+    if (type == "float32") return ctranslate2::ComputeType::FLOAT32;
+    return ctranslate2::ComputeType::INT8;
+}
+
+} // namespace
+
+CTranslate2Backend::CTranslate2Backend(const std::string& modelPath, const std::string& computeType,
+                                       size_t intraThreads) {
+    ctranslate2::TranslatorConfig translatorConfig;
+    translatorConfig.device = ctranslate2::Device::CPU;
+    translatorConfig.device_index = 0;
+    translatorConfig.compute_type = toCt2ComputeType(computeType);
+    translatorConfig.inter_threads = 1;
+    translatorConfig.intra_threads = static_cast<int>(intraThreads);
+    translator_ = std::make_unique<ctranslate2::Translator>(modelPath, ctranslate2::Device::CPU, translatorConfig);
+}
+
+CTranslate2Backend::~CTranslate2Backend() = default;
+
+std::vector<InferenceBackend::Hypothesis> CTranslate2Backend::translateBatch(
+    const std::vector<std::vector<int>>& sources,
+    const std::string& targetLang,
+    const Options& options) {
+
+    ctranslate2::TranslationOptions ct2Options;
+    ct2Options.beam_size = options.beamSize;
+    ct2Options.length_penalty = options.lengthPenalty;
+    ct2Options.patience = options.patience;
+    ct2Options.max_decoding_length = options.maxDecodingLength;
+    ct2Options.release_attention_weights = false;
+    ct2Options.release_hypothesis = false;
+    ct2Options.use_vmap = options.useVmap;
+    ct2Options.return_scores = options.returnScores;
+    ct2Options.no_repeat_ngram_size = options.noRepeatNgramSize;
+    ct2Options.repetition_penalty = options.repetitionPenalty;
+    if (options.stepCallback) {
+        // CTranslate2 only calls it for greedy search
+        ct2Options.callback = [&callback = options.stepCallback](ctranslate2::GenerationStepResult step) {
+            return callback(step.batch_id, static_cast<int>(step.token_id));
+        };
+    }
+
+    std::vector<std::vector<std::string>> targetPrefix(sources.size(), {targetLang});
+    auto results = translator_->translate_batch(sources, targetPrefix, ct2Options);
+
+    std::vector<Hypothesis> hypotheses(sources.size());
+    for (size_t i = 0; i < results.size() && i < hypotheses.size(); ++i) {
+        if (results[i].hypotheses.empty()) {
+            continue;
+        }
+        hypotheses[i].ids = std::move(results[i].hypotheses[0]);
+        if (!results[i].scores.empty()) {
+            hypotheses[i].score = results[i].scores[0];
+            hypotheses[i].hasScore = true;
+        }
+    }
+    return hypotheses;
+}
+
+} // namespace traductor
+
+#endif // HAVE_CTRANSLATE2
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifdef HAVE_CTRANSLATE2
+
+#include "InferenceBackend.h"
+#include <memory>
+#include <string>
+
+namespace ctranslate2 {
+class Translator;
+}
+
+namespace traductor {
+
+/**
+ * InferenceBackend running a CTranslate2 model on the CPU. One single-threaded
+ * (inter_threads = 1) translator per replica; intra-op threads come from
+ * ct2_intra_threads. The constructor loads the model and throws on failure.
+ */
+class CTranslate2Backend : public InferenceBackend {
+public:
+    // computeType is one of the names resolveComputeType returns (int8, int8_float32, int16, float32)
+    CTranslate2Backend(const std::string& modelPath, const std::string& computeType, size_t intraThreads);
+    ~CTranslate2Backend() override;
+
+    const char* name() const override { return "ctranslate2"; }
+
+    std::vector<Hypothesis> translateBatch(const std::vector<std::vector<int>>& sources,
+                                           const std::string& targetLang,
+                                           const Options& options) override;
+
+private:
+    std::unique_ptr<ctranslate2::Translator> translator_;
+};
+
+} // namespace traductor
+
+#endif // HAVE_CTRANSLATE2
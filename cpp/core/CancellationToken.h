@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace traductor {
+
+/**
+ * Cooperative stop flag with an optional deadline, shared by a request and
+ * every batch it submits. The engine polls it between segments and batches and
+ * from the decoder's step callback; cancel() may be called from any thread.
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Reason { None, Cancelled, DeadlineExceeded };
+
+    CancellationToken() = default;
+    explicit CancellationToken(Clock::duration timeout) { setTimeout(timeout); }
+
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+    // Deadline relative to now; zero or negative means no deadline
+    void setTimeout(Clock::duration timeout) {
+        auto deadline = timeout > Clock::duration::zero() ? (Clock::now() + timeout).time_since_epoch().count() : 0;
+        deadline_.store(deadline, std::memory_order_relaxed);
+    }
+
+    bool hasDeadline() const { return deadline_.load(std::memory_order_relaxed) != 0; }
+
+    Reason reason() const {
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            return Reason::Cancelled;
+        }
+        auto deadline = deadline_.load(std::memory_order_relaxed);
+        if (deadline != 0 && Clock::now().time_since_epoch().count() >= deadline) {
+            return Reason::DeadlineExceeded;
+        }
+        return Reason::None;
+    }
+
+    bool stopRequested() const { return reason() != Reason::None; }
+
+    static const char* reasonName(Reason reason) {
+        switch (reason) {
+            case Reason::Cancelled: return "cancelled";
+            case Reason::DeadlineExceeded: return "deadline_exceeded";
+            default: return "none";
+        }
+    }
+
+private:
+    std::atomic<bool> cancelled_{false};
+    std::atomic<Clock::rep> deadline_{0};  // steady_clock ticks, 0 = none
+};
+
+// Thrown through the pipeline when a batch's request was cancelled or ran out of time
+class OperationCancelled : public std::runtime_error {
+public:
+    explicit OperationCancelled(CancellationToken::Reason reason)
+        : std::runtime_error(std::string("Translation ") + CancellationToken::reasonName(reason)),
+          reason_(reason) {}
+
+    CancellationToken::Reason reason() const { return reason_; }
+
+private:
+    CancellationToken::Reason reason_;
+};
+
+} // namespace traductor
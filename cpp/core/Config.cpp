@@ -1,7 +1,7 @@
 #include "Config.h"
+#include "Logger.h"
 #include <cstdlib>
 #include <fstream>
-#include <iostream>
 
 namespace traductor {
 
@@ -43,12 +43,56 @@ bool Config::loadFromFile(const std::string& configPath) {
         if (config.contains("max_segment_chars")) {
             maxSegmentChars_ = config["max_segment_chars"];
         }
+        if (config.contains("decoding_profiles") && config["decoding_profiles"].is_object()) {
+            for (const auto& [name, settings] : config["decoding_profiles"].items()) {
+                DecodingProfile& profile = decodingProfiles_[name];
+                profile.name = name;
+                profile.beamSize = settings.value("beam_size", profile.beamSize);
+                profile.lengthPenalty = settings.value("length_penalty", profile.lengthPenalty);
+                profile.patience = settings.value("patience", profile.patience);
+                if (settings.contains("priority") && settings["priority"].is_string()) {
+                    parsePriority(settings["priority"].get<std::string>(), profile.priority);
+                }
+            }
+        } else if (config.contains("beam_size")) {
+            decodingProfiles_["quality"].beamSize = beamSize_;
+        }
+        if (config.contains("default_profile")) {
+            defaultProfile_ = config["default_profile"];
+        }
+        if (config.contains("pack_short_segments")) {
+            packShortSegments_ = config["pack_short_segments"];
+        }
+        if (config.contains("pack_target_tokens")) {
+            packTargetTokens_ = config["pack_target_tokens"];
+        }
+        if (config.contains("pack_max_unit_tokens")) {
+            packMaxUnitTokens_ = config["pack_max_unit_tokens"];
+        }
         if (config.contains("ct2_inter_threads")) {
             ct2InterThreads_ = config["ct2_inter_threads"];
         }
         if (config.contains("ct2_intra_threads")) {
             ct2IntraThreads_ = config["ct2_intra_threads"];
         }
+        if (config.contains("ct2_pin_cores")) {
+            ct2PinCores_ = config["ct2_pin_cores"];
+        }
+        if (config.contains("ct2_core_offset")) {
+            ct2CoreOffset_ = config["ct2_core_offset"];
+        }
+        if (config.contains("compute_type")) {
+            computeType_ = config["compute_type"];
+        }
+        if (config.contains("use_vmap")) {
+            useVmap_ = config["use_vmap"];
+        }
+        if (config.contains("tokenizer_threads")) {
+            tokenizerThreads_ = config["tokenizer_threads"];
+        }
+        if (config.contains("tokenizer_cache_size")) {
+            tokenizerCacheSize_ = config["tokenizer_cache_size"];
+        }
         if (config.contains("source_lang")) {
             sourceLang_ = config["source_lang"];
         }
@@ -64,19 +108,163 @@ bool Config::loadFromFile(const std::string& configPath) {
         if (config.contains("port")) {
             port_ = config["port"];
         }
+        if (config.contains("rest_io_threads")) {
+            restIoThreads_ = config["rest_io_threads"];
+        }
+        if (config.contains("rest_workers")) {
+            restWorkers_ = config["rest_workers"];
+        }
+        if (config.contains("rest_queue_capacity")) {
+            restQueueCapacity_ = config["rest_queue_capacity"];
+        }
+        if (config.contains("rate_limit_enabled")) {
+            rateLimitEnabled_ = config["rate_limit_enabled"];
+        }
+        if (config.contains("rate_limit_texts_per_sec")) {
+            rateLimitTextsPerSec_ = config["rate_limit_texts_per_sec"];
+        }
+        if (config.contains("rate_limit_texts_burst")) {
+            rateLimitTextsBurst_ = config["rate_limit_texts_burst"];
+        }
+        if (config.contains("rate_limit_tokens_per_sec")) {
+            rateLimitTokensPerSec_ = config["rate_limit_tokens_per_sec"];
+        }
+        if (config.contains("rate_limit_tokens_burst")) {
+            rateLimitTokensBurst_ = config["rate_limit_tokens_burst"];
+        }
+        if (config.contains("api_key_header")) {
+            apiKeyHeader_ = config["api_key_header"];
+        }
+        if (config.contains("client_weights") && config["client_weights"].is_object()) {
+            clientWeights_.clear();
+            for (const auto& [client, weight] : config["client_weights"].items()) {
+                clientWeights_[client] = weight.get<double>();
+            }
+        }
         if (config.contains("cache_size")) {
             cacheSize_ = config["cache_size"];
         }
         if (config.contains("max_batch_size")) {
             maxBatchSize_ = config["max_batch_size"];
         }
+        if (config.contains("max_batch_tokens")) {
+            maxBatchTokens_ = config["max_batch_tokens"];
+        }
+        if (config.contains("pipeline_queue_depth")) {
+            pipelineQueueDepth_ = config["pipeline_queue_depth"];
+        }
+        if (config.contains("bulk_min_share")) {
+            bulkMinShare_ = config["bulk_min_share"];
+        }
         if (config.contains("request_timeout")) {
             requestTimeout_ = config["request_timeout"];
         }
+        if (config.contains("admission_enabled")) {
+            admissionEnabled_ = config["admission_enabled"];
+        }
+        if (config.contains("admission_initial_throughput")) {
+            admissionInitialThroughput_ = config["admission_initial_throughput"];
+        }
+        if (config.contains("degradation_enabled")) {
+            degradationEnabled_ = config["degradation_enabled"];
+        }
+        if (config.contains("degrade_queue_depth")) {
+            degradeQueueDepth_ = config["degrade_queue_depth"];
+        }
+        if (config.contains("degrade_latency_ms")) {
+            degradeLatencyMs_ = config["degrade_latency_ms"];
+        }
+        if (config.contains("recover_queue_depth")) {
+            recoverQueueDepth_ = config["recover_queue_depth"];
+        }
+        if (config.contains("recover_latency_ms")) {
+            recoverLatencyMs_ = config["recover_latency_ms"];
+        }
+        if (config.contains("degradation_hold_ms")) {
+            degradationHoldMs_ = config["degradation_hold_ms"];
+        }
+        if (config.contains("degradation_beam_steps")) {
+            degradationBeamSteps_ = config["degradation_beam_steps"].get<std::vector<int>>();
+        }
+        if (config.contains("small_ct2_dir")) {
+            smallCt2Dir_ = config["small_ct2_dir"];
+        }
+        if (config.contains("cascade_enabled")) {
+            cascadeEnabled_ = config["cascade_enabled"];
+        }
+        if (config.contains("cascade_max_tokens")) {
+            cascadeMaxTokens_ = config["cascade_max_tokens"];
+        }
+        if (config.contains("cascade_simple_max_tokens")) {
+            cascadeSimpleMaxTokens_ = config["cascade_simple_max_tokens"];
+        }
+        if (config.contains("cascade_min_simplicity")) {
+            cascadeMinSimplicity_ = config["cascade_min_simplicity"];
+        }
+        if (config.contains("cascade_min_score")) {
+            cascadeMinScore_ = config["cascade_min_score"];
+        }
+        if (config.contains("no_repeat_ngram_size")) {
+            noRepeatNgramSize_ = config["no_repeat_ngram_size"];
+        }
+        if (config.contains("repetition_penalty")) {
+            repetitionPenalty_ = config["repetition_penalty"];
+        }
+        if (config.contains("repetition_guard")) {
+            repetitionGuard_ = config["repetition_guard"];
+        }
+        if (config.contains("repetition_max_ngram")) {
+            repetitionMaxNgram_ = config["repetition_max_ngram"];
+        }
+        if (config.contains("repetition_max_repeats")) {
+            repetitionMaxRepeats_ = config["repetition_max_repeats"];
+        }
+        if (config.contains("trace_file")) {
+            traceFile_ = config["trace_file"];
+        }
+        if (config.contains("trace_sample_rate")) {
+            traceSampleRate_ = config["trace_sample_rate"];
+        }
+        if (config.contains("trace_max_file_mb")) {
+            traceMaxFileMb_ = config["trace_max_file_mb"];
+        }
+        if (config.contains("trace_max_files")) {
+            traceMaxFiles_ = config["trace_max_files"];
+        }
+        if (config.contains("slow_request_ms")) {
+            slowRequestMs_ = config["slow_request_ms"];
+        }
+        if (config.contains("slow_request_log_size")) {
+            slowRequestLogSize_ = config["slow_request_log_size"];
+        }
+        if (config.contains("slow_request_log_text")) {
+            slowRequestLogText_ = config["slow_request_log_text"];
+        }
+        if (config.contains("log_level")) {
+            logLevel_ = config["log_level"];
+        }
+        if (config.contains("log_format")) {
+            logFormat_ = config["log_format"];
+        }
+        if (config.contains("log_file")) {
+            logFile_ = config["log_file"];
+        }
+        if (config.contains("inference_backend")) {
+            inferenceBackend_ = config["inference_backend"];
+        }
+        if (config.contains("mock_batch_latency_us")) {
+            mockBatchLatencyUs_ = config["mock_batch_latency_us"];
+        }
+        if (config.contains("mock_step_latency_us")) {
+            mockStepLatencyUs_ = config["mock_step_latency_us"];
+        }
+        if (config.contains("mock_token_latency_us")) {
+            mockTokenLatencyUs_ = config["mock_token_latency_us"];
+        }
         
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading config from file: " << e.what() << std::endl;
+        TRADUCTOR_LOG(Error, "config") << "Error loading config from file: " << e.what();
         return false;
     }
 }
@@ -91,6 +279,10 @@ void Config::loadFromEnvironment() {
     }
     if (const char* env = std::getenv("BEAM_SIZE")) {
         beamSize_ = std::atoi(env);
+        decodingProfiles_["quality"].beamSize = beamSize_;
+    }
+    if (const char* env = std::getenv("DEFAULT_PROFILE")) {
+        defaultProfile_ = env;
     }
     if (const char* env = std::getenv("MAX_INPUT_TOKENS")) {
         maxInputTokens_ = std::atoi(env);
@@ -104,12 +296,39 @@ void Config::loadFromEnvironment() {
     if (const char* env = std::getenv("MAX_SEGMENT_CHARS")) {
         maxSegmentChars_ = std::atoi(env);
     }
+    if (const char* env = std::getenv("PACK_SHORT_SEGMENTS")) {
+        packShortSegments_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("PACK_TARGET_TOKENS")) {
+        packTargetTokens_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("PACK_MAX_UNIT_TOKENS")) {
+        packMaxUnitTokens_ = std::atoi(env);
+    }
     if (const char* env = std::getenv("CT2_INTER_THREADS")) {
         ct2InterThreads_ = std::atoi(env);
     }
     if (const char* env = std::getenv("CT2_INTRA_THREADS")) {
         ct2IntraThreads_ = std::atoi(env);
     }
+    if (const char* env = std::getenv("CT2_PIN_CORES")) {
+        ct2PinCores_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("CT2_CORE_OFFSET")) {
+        ct2CoreOffset_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("COMPUTE_TYPE")) {
+        computeType_ = env;
+    }
+    if (const char* env = std::getenv("USE_VMAP")) {
+        useVmap_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("TOKENIZER_THREADS")) {
+        tokenizerThreads_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("TOKENIZER_CACHE_SIZE")) {
+        tokenizerCacheSize_ = std::atoll(env);
+    }
     if (const char* env = std::getenv("SOURCE_LANG")) {
         sourceLang_ = env;
     }
@@ -125,15 +344,150 @@ void Config::loadFromEnvironment() {
     if (const char* env = std::getenv("PORT")) {
         port_ = std::atoi(env);
     }
+    if (const char* env = std::getenv("REST_IO_THREADS")) {
+        restIoThreads_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("REST_WORKERS")) {
+        restWorkers_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("REST_QUEUE_CAPACITY")) {
+        restQueueCapacity_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("RATE_LIMIT_ENABLED")) {
+        rateLimitEnabled_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("RATE_LIMIT_TEXTS_PER_SEC")) {
+        rateLimitTextsPerSec_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("RATE_LIMIT_TEXTS_BURST")) {
+        rateLimitTextsBurst_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("RATE_LIMIT_TOKENS_PER_SEC")) {
+        rateLimitTokensPerSec_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("RATE_LIMIT_TOKENS_BURST")) {
+        rateLimitTokensBurst_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("API_KEY_HEADER")) {
+        apiKeyHeader_ = env;
+    }
     if (const char* env = std::getenv("CACHE_SIZE")) {
         cacheSize_ = std::atoll(env);
     }
     if (const char* env = std::getenv("MAX_BATCH_SIZE")) {
         maxBatchSize_ = std::atoi(env);
     }
+    if (const char* env = std::getenv("MAX_BATCH_TOKENS")) {
+        maxBatchTokens_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("PIPELINE_QUEUE_DEPTH")) {
+        pipelineQueueDepth_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("BULK_MIN_SHARE")) {
+        bulkMinShare_ = std::atof(env);
+    }
     if (const char* env = std::getenv("REQUEST_TIMEOUT")) {
         requestTimeout_ = std::atoi(env);
     }
+    if (const char* env = std::getenv("ADMISSION_ENABLED")) {
+        admissionEnabled_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("ADMISSION_INITIAL_THROUGHPUT")) {
+        admissionInitialThroughput_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("DEGRADATION_ENABLED")) {
+        degradationEnabled_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("DEGRADE_QUEUE_DEPTH")) {
+        degradeQueueDepth_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("DEGRADE_LATENCY_MS")) {
+        degradeLatencyMs_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("RECOVER_QUEUE_DEPTH")) {
+        recoverQueueDepth_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("RECOVER_LATENCY_MS")) {
+        recoverLatencyMs_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("DEGRADATION_HOLD_MS")) {
+        degradationHoldMs_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("SMALL_CT2_DIR")) {
+        smallCt2Dir_ = env;
+    }
+    if (const char* env = std::getenv("CASCADE_ENABLED")) {
+        cascadeEnabled_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("CASCADE_MAX_TOKENS")) {
+        cascadeMaxTokens_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("CASCADE_SIMPLE_MAX_TOKENS")) {
+        cascadeSimpleMaxTokens_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("CASCADE_MIN_SIMPLICITY")) {
+        cascadeMinSimplicity_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("CASCADE_MIN_SCORE")) {
+        cascadeMinScore_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("NO_REPEAT_NGRAM_SIZE")) {
+        noRepeatNgramSize_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("REPETITION_PENALTY")) {
+        repetitionPenalty_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("REPETITION_GUARD")) {
+        repetitionGuard_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("REPETITION_MAX_NGRAM")) {
+        repetitionMaxNgram_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("REPETITION_MAX_REPEATS")) {
+        repetitionMaxRepeats_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("TRACE_FILE")) {
+        traceFile_ = env;
+    }
+    if (const char* env = std::getenv("TRACE_SAMPLE_RATE")) {
+        traceSampleRate_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("TRACE_MAX_FILE_MB")) {
+        traceMaxFileMb_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("TRACE_MAX_FILES")) {
+        traceMaxFiles_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("SLOW_REQUEST_MS")) {
+        slowRequestMs_ = std::atof(env);
+    }
+    if (const char* env = std::getenv("SLOW_REQUEST_LOG_SIZE")) {
+        slowRequestLogSize_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("SLOW_REQUEST_LOG_TEXT")) {
+        slowRequestLogText_ = (std::string(env) == "true" || std::string(env) == "1");
+    }
+    if (const char* env = std::getenv("LOG_LEVEL")) {
+        logLevel_ = env;
+    }
+    if (const char* env = std::getenv("LOG_FORMAT")) {
+        logFormat_ = env;
+    }
+    if (const char* env = std::getenv("LOG_FILE")) {
+        logFile_ = env;
+    }
+    if (const char* env = std::getenv("INFERENCE_BACKEND")) {
+        inferenceBackend_ = env;
+    }
+    if (const char* env = std::getenv("MOCK_BATCH_LATENCY_US")) {
+        mockBatchLatencyUs_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("MOCK_STEP_LATENCY_US")) {
+        mockStepLatencyUs_ = std::atoi(env);
+    }
+    if (const char* env = std::getenv("MOCK_TOKEN_LATENCY_US")) {
+        mockTokenLatencyUs_ = std::atoi(env);
+    }
 }
 
 void Config::setDefaults() {
@@ -148,9 +502,29 @@ void Config::setDefaults() {
     maxMaxNewTokens_ = 8192;
     maxSegmentChars_ = 800;
     
+    // Decoding profiles: greedy for chat, the configured beam for quality
+    decodingProfiles_.clear();
+    decodingProfiles_["fast"] = {"fast", 1, 1.0f, 1.0f, Priority::Interactive};
+    decodingProfiles_["balanced"] = {"balanced", 2, 1.0f, 1.0f, Priority::Interactive};
+    decodingProfiles_["quality"] = {"quality", beamSize_, 1.0f, 1.0f, Priority::Interactive};
+    defaultProfile_ = "quality";
+    
+    // Segment packing - off by default, see bench/packing_bench.cpp
+    packShortSegments_ = false;
+    packTargetTokens_ = 64;
+    packMaxUnitTokens_ = 16;
+    
     // CTranslate2 threading - conservative defaults
     ct2InterThreads_ = 4;
     ct2IntraThreads_ = 4;
+    ct2PinCores_ = false;
+    ct2CoreOffset_ = 0;
+    computeType_ = "auto";
+    useVmap_ = false;
+    
+    // Tokenizer batch workers
+    tokenizerThreads_ = 2;
+    tokenizerCacheSize_ = 4096;
     
     // Languages
     sourceLang_ = "spa_Latn";
@@ -160,13 +534,103 @@ void Config::setDefaults() {
     // Server
     host_ = "0.0.0.0";
     port_ = 8000;
+    restIoThreads_ = 2;
+    restWorkers_ = 4;
+    restQueueCapacity_ = 256;
+    
+    // Rate limiting - off by default; weights only matter under contention
+    rateLimitEnabled_ = false;
+    rateLimitTextsPerSec_ = 20.0;
+    rateLimitTextsBurst_ = 100.0;
+    rateLimitTokensPerSec_ = 2000.0;
+    rateLimitTokensBurst_ = 10000.0;
+    apiKeyHeader_ = "X-API-Key";
+    clientWeights_.clear();
     
     // Cache
     cacheSize_ = 1024;
     
     // Limits
     maxBatchSize_ = 16;
+    maxBatchTokens_ = 1024;
+    pipelineQueueDepth_ = 4;
+    bulkMinShare_ = 0.2;
     requestTimeout_ = 300;
+    admissionEnabled_ = true;
+    admissionInitialThroughput_ = 200.0;
+    
+    // Degradation - off by default; thresholds leave a gap for hysteresis
+    degradationEnabled_ = false;
+    degradeQueueDepth_ = 8;
+    degradeLatencyMs_ = 2000;
+    recoverQueueDepth_ = 2;
+    recoverLatencyMs_ = 800;
+    degradationHoldMs_ = 3000;
+    degradationBeamSteps_ = {2, 1};
+    smallCt2Dir_ = "";
+    
+    // Model cascade - needs small_ct2_dir
+    cascadeEnabled_ = false;
+    cascadeMaxTokens_ = 12;
+    cascadeSimpleMaxTokens_ = 32;
+    cascadeMinSimplicity_ = 0.9;
+    cascadeMinScore_ = -1.5;
+    
+    // Runaway-generation guard - decoder constraints off, loop detection on
+    noRepeatNgramSize_ = 0;
+    repetitionPenalty_ = 1.0;
+    repetitionGuard_ = true;
+    repetitionMaxNgram_ = 4;
+    repetitionMaxRepeats_ = 4;
+    
+    // Tracing - off until a trace file is set
+    traceFile_.clear();
+    traceSampleRate_ = 0.0;
+    traceMaxFileMb_ = 64;
+    traceMaxFiles_ = 3;
+    
+    // Slow-request log - text redacted unless asked for
+    slowRequestMs_ = 2000.0;
+    slowRequestLogSize_ = 50;
+    slowRequestLogText_ = false;
+    
+    // Logging - text lines on stderr
+    logLevel_ = "info";
+    logFormat_ = "text";
+    logFile_.clear();
+    
+    // Inference backend - the real model when available
+    inferenceBackend_ = "auto";
+    mockBatchLatencyUs_ = 5000;
+    mockStepLatencyUs_ = 1000;
+    mockTokenLatencyUs_ = 100;
+}
+
+double Config::clientWeight(const std::string& client) const {
+    auto it = clientWeights_.find(client);
+    return it == clientWeights_.end() || it->second <= 0.0 ? 1.0 : it->second;
+}
+
+bool Config::isKnownClient(const std::string& client) const {
+    return clientWeights_.count(client) > 0;
+}
+
+bool Config::findDecodingProfile(const std::string& name, DecodingProfile& profile) const {
+    auto it = decodingProfiles_.find(name.empty() ? defaultProfile_ : name);
+    if (it == decodingProfiles_.end()) {
+        return false;
+    }
+    profile = it->second;
+    return true;
+}
+
+std::vector<std::string> Config::decodingProfileNames() const {
+    std::vector<std::string> names;
+    names.reserve(decodingProfiles_.size());
+    for (const auto& [name, profile] : decodingProfiles_) {
+        names.push_back(name);
+    }
+    return names;
 }
 
 nlohmann::json Config::toJson() const {
@@ -178,16 +642,81 @@ nlohmann::json Config::toJson() const {
     config["default_max_new_tokens"] = defaultMaxNewTokens_;
     config["max_max_new_tokens"] = maxMaxNewTokens_;
     config["max_segment_chars"] = maxSegmentChars_;
+    config["default_profile"] = defaultProfile_;
+    for (const auto& [name, profile] : decodingProfiles_) {
+        config["decoding_profiles"][name] = {
+            {"beam_size", profile.beamSize},
+            {"length_penalty", profile.lengthPenalty},
+            {"patience", profile.patience},
+            {"priority", priorityName(profile.priority)}
+        };
+    }
+    config["pack_short_segments"] = packShortSegments_;
+    config["pack_target_tokens"] = packTargetTokens_;
+    config["pack_max_unit_tokens"] = packMaxUnitTokens_;
     config["ct2_inter_threads"] = ct2InterThreads_;
     config["ct2_intra_threads"] = ct2IntraThreads_;
+    config["ct2_pin_cores"] = ct2PinCores_;
+    config["ct2_core_offset"] = ct2CoreOffset_;
+    config["compute_type"] = computeType_;
+    config["use_vmap"] = useVmap_;
+    config["tokenizer_threads"] = tokenizerThreads_;
+    config["tokenizer_cache_size"] = tokenizerCacheSize_;
     config["source_lang"] = sourceLang_;
     config["target_lang"] = targetLang_;
     config["formal_da"] = formalDa_;
     config["host"] = host_;
     config["port"] = port_;
+    config["rest_io_threads"] = restIoThreads_;
+    config["rest_workers"] = restWorkers_;
+    config["rest_queue_capacity"] = restQueueCapacity_;
+    config["rate_limit_enabled"] = rateLimitEnabled_;
+    config["rate_limit_texts_per_sec"] = rateLimitTextsPerSec_;
+    config["rate_limit_texts_burst"] = rateLimitTextsBurst_;
+    config["rate_limit_tokens_per_sec"] = rateLimitTokensPerSec_;
+    config["rate_limit_tokens_burst"] = rateLimitTokensBurst_;
+    config["api_key_header"] = apiKeyHeader_;
+    config["client_weights"] = clientWeights_;
     config["cache_size"] = cacheSize_;
     config["max_batch_size"] = maxBatchSize_;
+    config["max_batch_tokens"] = maxBatchTokens_;
+    config["pipeline_queue_depth"] = pipelineQueueDepth_;
+    config["bulk_min_share"] = bulkMinShare_;
     config["request_timeout"] = requestTimeout_;
+    config["admission_enabled"] = admissionEnabled_;
+    config["admission_initial_throughput"] = admissionInitialThroughput_;
+    config["degradation_enabled"] = degradationEnabled_;
+    config["degrade_queue_depth"] = degradeQueueDepth_;
+    config["degrade_latency_ms"] = degradeLatencyMs_;
+    config["recover_queue_depth"] = recoverQueueDepth_;
+    config["recover_latency_ms"] = recoverLatencyMs_;
+    config["degradation_hold_ms"] = degradationHoldMs_;
+    config["degradation_beam_steps"] = degradationBeamSteps_;
+    config["small_ct2_dir"] = smallCt2Dir_;
+    config["cascade_enabled"] = cascadeEnabled_;
+    config["cascade_max_tokens"] = cascadeMaxTokens_;
+    config["cascade_simple_max_tokens"] = cascadeSimpleMaxTokens_;
+    config["cascade_min_simplicity"] = cascadeMinSimplicity_;
+    config["cascade_min_score"] = cascadeMinScore_;
+    config["no_repeat_ngram_size"] = noRepeatNgramSize_;
+    config["repetition_penalty"] = repetitionPenalty_;
+    config["repetition_guard"] = repetitionGuard_;
+    config["repetition_max_ngram"] = repetitionMaxNgram_;
+    config["repetition_max_repeats"] = repetitionMaxRepeats_;
+    config["trace_file"] = traceFile_;
+    config["trace_sample_rate"] = traceSampleRate_;
+    config["trace_max_file_mb"] = traceMaxFileMb_;
+    config["trace_max_files"] = traceMaxFiles_;
+    config["slow_request_ms"] = slowRequestMs_;
+    config["slow_request_log_size"] = slowRequestLogSize_;
+    config["slow_request_log_text"] = slowRequestLogText_;
+    config["log_level"] = logLevel_;
+    config["log_format"] = logFormat_;
+    config["log_file"] = logFile_;
+    config["inference_backend"] = inferenceBackend_;
+    config["mock_batch_latency_us"] = mockBatchLatencyUs_;
+    config["mock_step_latency_us"] = mockStepLatencyUs_;
+    config["mock_token_latency_us"] = mockTokenLatencyUs_;
     return config;
 }
 
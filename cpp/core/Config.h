@@ -1,11 +1,26 @@
 #pragma once
 
+#include <map>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include "PriorityScheduler.h"
 
 namespace traductor {
 
+/**
+ * Named decoding settings selected per request ("profile" in REST, --profile
+ * in the CLI): greedy for chat-like text, wider beams where quality matters.
+ */
+struct DecodingProfile {
+    std::string name;
+    int beamSize = 4;
+    float lengthPenalty = 1.0f;
+    float patience = 1.0f;
+    Priority priority = Priority::Interactive;  // lane for requests that do not name one
+};
+
 /**
  * Central configuration management for the translator.
  * Reads from JSON/ENV variables and provides default parameters.
@@ -28,9 +43,45 @@ public:
     int maxMaxNewTokens() const { return maxMaxNewTokens_; }
     int maxSegmentChars() const { return maxSegmentChars_; }
     
-    // CTranslate2 Performance
+    // Decoding profiles; "quality" follows beam_size unless configured explicitly
+    std::string defaultProfile() const { return defaultProfile_; }
+    void setDefaultProfile(const std::string& name) { defaultProfile_ = name; }
+    bool findDecodingProfile(const std::string& name, DecodingProfile& profile) const;
+    void setDecodingProfile(const DecodingProfile& profile) { decodingProfiles_[profile.name] = profile; }
+    std::vector<std::string> decodingProfileNames() const;
+    void setMaxSegmentChars(int chars) { maxSegmentChars_ = chars; }
+    
+    // Packing of short segments (one-line paragraphs, greetings, signatures)
+    bool packShortSegments() const { return packShortSegments_; }
+    int packTargetTokens() const { return packTargetTokens_; }
+    int packMaxUnitTokens() const { return packMaxUnitTokens_; }
+    void setPackShortSegments(bool enabled) { packShortSegments_ = enabled; }
+    void setPackTargetTokens(int tokens) { packTargetTokens_ = tokens; }
+    void setPackMaxUnitTokens(int tokens) { packMaxUnitTokens_ = tokens; }
+    
+    // CTranslate2 Performance: inter threads = number of engine-managed replicas,
+    // each running intra threads on its own block of cores when pinning is on
     int ct2InterThreads() const { return ct2InterThreads_; }
     int ct2IntraThreads() const { return ct2IntraThreads_; }
+    bool ct2PinCores() const { return ct2PinCores_; }
+    int ct2CoreOffset() const { return ct2CoreOffset_; }
+    void setCt2InterThreads(int threads) { ct2InterThreads_ = threads; }
+    void setCt2IntraThreads(int threads) { ct2IntraThreads_ = threads; }
+    void setCt2PinCores(bool pin) { ct2PinCores_ = pin; }
+    void setCt2CoreOffset(int offset) { ct2CoreOffset_ = offset; }
+    
+    // Weight/activation precision: int8, int8_float32, int16, float32 or auto
+    // (auto picks the fastest type the host CPU supports)
+    std::string computeType() const { return computeType_; }
+    void setComputeType(const std::string& type) { computeType_ = type; }
+    
+    // Restrict the decoder to the vocabulary map in ct2_dir (see tools/vmap_builder.cpp)
+    bool useVmap() const { return useVmap_; }
+    void setUseVmap(bool enabled) { useVmap_ = enabled; }
+    
+    // Tokenizer batch workers (SentencePiece processors)
+    int tokenizerThreads() const { return tokenizerThreads_; }
+    size_t tokenizerCacheSize() const { return tokenizerCacheSize_; }
     
     // Language Settings
     std::string sourceLang() const { return sourceLang_; }
@@ -40,13 +91,96 @@ public:
     // Server Settings
     std::string host() const { return host_; }
     int port() const { return port_; }
+    int restIoThreads() const { return restIoThreads_; }
+    int restWorkers() const { return restWorkers_; }
+    int restQueueCapacity() const { return restQueueCapacity_; }
+    
+    // Per-client rate limiting and fair queuing in the REST server
+    bool rateLimitEnabled() const { return rateLimitEnabled_; }
+    double rateLimitTextsPerSec() const { return rateLimitTextsPerSec_; }
+    double rateLimitTextsBurst() const { return rateLimitTextsBurst_; }
+    double rateLimitTokensPerSec() const { return rateLimitTokensPerSec_; }
+    double rateLimitTokensBurst() const { return rateLimitTokensBurst_; }
+    std::string apiKeyHeader() const { return apiKeyHeader_; }
+    // Fair-queuing weight by API key or client address (default 1)
+    double clientWeight(const std::string& client) const;
+    // True for API keys (or addresses) listed in client_weights
+    bool isKnownClient(const std::string& client) const;
     
     // Cache Settings
     size_t cacheSize() const { return cacheSize_; }
     
     // Limits
     int maxBatchSize() const { return maxBatchSize_; }
+    int maxBatchTokens() const { return maxBatchTokens_; }
+    void setMaxBatchTokens(int tokens) { maxBatchTokens_ = tokens; }
+    int pipelineQueueDepth() const { return pipelineQueueDepth_; }
+    double bulkMinShare() const { return bulkMinShare_; }  // share of batches reserved for bulk work
     int requestTimeout() const { return requestTimeout_; }
+    void setRequestTimeout(int seconds) { requestTimeout_ = seconds; }
+    // Refuse requests predicted to finish after request_timeout (see AdmissionController)
+    bool admissionEnabled() const { return admissionEnabled_; }
+    double admissionInitialThroughput() const { return admissionInitialThroughput_; }
+    void setAdmissionEnabled(bool enabled) { admissionEnabled_ = enabled; }
+    
+    // Graceful degradation under load (see DegradationController)
+    bool degradationEnabled() const { return degradationEnabled_; }
+    int degradeQueueDepth() const { return degradeQueueDepth_; }
+    int degradeLatencyMs() const { return degradeLatencyMs_; }
+    int recoverQueueDepth() const { return recoverQueueDepth_; }
+    int recoverLatencyMs() const { return recoverLatencyMs_; }
+    int degradationHoldMs() const { return degradationHoldMs_; }
+    std::vector<int> degradationBeamSteps() const { return degradationBeamSteps_; }
+    std::string smallCt2Dir() const { return smallCt2Dir_; }
+    void setDegradationEnabled(bool enabled) { degradationEnabled_ = enabled; }
+    
+    // Model cascade: short/simple segments on the small model (small_ct2_dir)
+    bool cascadeEnabled() const { return cascadeEnabled_; }
+    int cascadeMaxTokens() const { return cascadeMaxTokens_; }
+    int cascadeSimpleMaxTokens() const { return cascadeSimpleMaxTokens_; }
+    double cascadeMinSimplicity() const { return cascadeMinSimplicity_; }
+    double cascadeMinScore() const { return cascadeMinScore_; }
+    void setCascadeEnabled(bool enabled) { cascadeEnabled_ = enabled; }
+    
+    // Runaway-generation guard: decoder constraints plus loop detection and retry
+    int noRepeatNgramSize() const { return noRepeatNgramSize_; }
+    double repetitionPenalty() const { return repetitionPenalty_; }
+    bool repetitionGuard() const { return repetitionGuard_; }
+    int repetitionMaxNgram() const { return repetitionMaxNgram_; }
+    int repetitionMaxRepeats() const { return repetitionMaxRepeats_; }
+    void setRepetitionGuard(bool enabled) { repetitionGuard_ = enabled; }
+    
+    // Request tracing to a rotating Chrome trace JSON file (see Tracer); off while trace_file is empty
+    std::string traceFile() const { return traceFile_; }
+    double traceSampleRate() const { return traceSampleRate_; }
+    int traceMaxFileMb() const { return traceMaxFileMb_; }
+    int traceMaxFiles() const { return traceMaxFiles_; }
+    void setTraceFile(const std::string& path) { traceFile_ = path; }
+    
+    // Slow-request log: requests at or above slow_request_ms (0 disables) are logged and kept
+    double slowRequestMs() const { return slowRequestMs_; }
+    int slowRequestLogSize() const { return slowRequestLogSize_; }
+    bool slowRequestLogText() const { return slowRequestLogText_; }
+    void setSlowRequestMs(double ms) { slowRequestMs_ = ms; }
+    
+    // Logging (see Logger): debug, info, warning, error or off; text or json; empty file means stderr
+    std::string logLevel() const { return logLevel_; }
+    std::string logFormat() const { return logFormat_; }
+    std::string logFile() const { return logFile_; }
+    void setLogLevel(const std::string& level) { logLevel_ = level; }
+    
+    // Inference backend: auto (CTranslate2 when built with it), ctranslate2 or mock.
+    // The mock echoes its input after a simulated delay (see MockBackend).
+    std::string inferenceBackend() const { return inferenceBackend_; }
+    int mockBatchLatencyUs() const { return mockBatchLatencyUs_; }
+    int mockStepLatencyUs() const { return mockStepLatencyUs_; }
+    int mockTokenLatencyUs() const { return mockTokenLatencyUs_; }
+    void setInferenceBackend(const std::string& backend) { inferenceBackend_ = backend; }
+    void setMockLatencyUs(int batchUs, int stepUs, int tokenUs) {
+        mockBatchLatencyUs_ = batchUs;
+        mockStepLatencyUs_ = stepUs;
+        mockTokenLatencyUs_ = tokenUs;
+    }
     
     // Load configuration from JSON file or use environment variables
     bool loadFromFile(const std::string& configPath);
@@ -67,9 +201,26 @@ private:
     int maxMaxNewTokens_ = 8192;
     int maxSegmentChars_ = 800;
     
+    // Decoding profiles by name
+    std::map<std::string, DecodingProfile> decodingProfiles_;
+    std::string defaultProfile_ = "quality";
+    
+    // Segment packing
+    bool packShortSegments_ = false;
+    int packTargetTokens_ = 64;
+    int packMaxUnitTokens_ = 16;
+    
     // CTranslate2 threading
     int ct2InterThreads_ = 4;
     int ct2IntraThreads_ = 4;
+    bool ct2PinCores_ = false;
+    int ct2CoreOffset_ = 0;
+    std::string computeType_ = "auto";
+    bool useVmap_ = false;
+    
+    // Tokenizer batch workers
+    int tokenizerThreads_ = 2;
+    size_t tokenizerCacheSize_ = 4096;
     
     // Languages (FLORES-200 codes)
     std::string sourceLang_ = "spa_Latn";
@@ -79,13 +230,76 @@ private:
     // Server
     std::string host_ = "0.0.0.0";
     int port_ = 8000;
+    int restIoThreads_ = 2;
+    int restWorkers_ = 4;
+    int restQueueCapacity_ = 256;
+    
+    // Rate limiting
+    bool rateLimitEnabled_ = false;
+    double rateLimitTextsPerSec_ = 20.0;
+    double rateLimitTextsBurst_ = 100.0;
+    double rateLimitTokensPerSec_ = 2000.0;
+    double rateLimitTokensBurst_ = 10000.0;
+    std::string apiKeyHeader_ = "X-API-Key";
+    std::unordered_map<std::string, double> clientWeights_;
     
     // Cache
     size_t cacheSize_ = 1024;
     
     // Limits
     int maxBatchSize_ = 16;
+    int maxBatchTokens_ = 1024;
+    int pipelineQueueDepth_ = 4;
+    double bulkMinShare_ = 0.2;
     int requestTimeout_ = 300;
+    bool admissionEnabled_ = true;
+    double admissionInitialThroughput_ = 200.0;
+    
+    // Degradation
+    bool degradationEnabled_ = false;
+    int degradeQueueDepth_ = 8;
+    int degradeLatencyMs_ = 2000;
+    int recoverQueueDepth_ = 2;
+    int recoverLatencyMs_ = 800;
+    int degradationHoldMs_ = 3000;
+    std::vector<int> degradationBeamSteps_ = {2, 1};
+    std::string smallCt2Dir_;
+    
+    // Model cascade
+    bool cascadeEnabled_ = false;
+    int cascadeMaxTokens_ = 12;
+    int cascadeSimpleMaxTokens_ = 32;
+    double cascadeMinSimplicity_ = 0.9;
+    double cascadeMinScore_ = -1.5;
+    
+    // Runaway-generation guard
+    int noRepeatNgramSize_ = 0;
+    double repetitionPenalty_ = 1.0;
+    bool repetitionGuard_ = true;
+    int repetitionMaxNgram_ = 4;
+    int repetitionMaxRepeats_ = 4;
+    
+    // Tracing
+    std::string traceFile_;
+    double traceSampleRate_ = 0.0;
+    int traceMaxFileMb_ = 64;
+    int traceMaxFiles_ = 3;
+    
+    // Slow-request log
+    double slowRequestMs_ = 2000.0;
+    int slowRequestLogSize_ = 50;
+    bool slowRequestLogText_ = false;
+    
+    // Logging
+    std::string logLevel_ = "info";
+    std::string logFormat_ = "text";
+    std::string logFile_;
+    
+    // Inference backend
+    std::string inferenceBackend_ = "auto";
+    int mockBatchLatencyUs_ = 5000;
+    int mockStepLatencyUs_ = 1000;
+    int mockTokenLatencyUs_ = 100;
     
     // Helper to get environment variable or default
     template<typename T>
@@ -0,0 +1,157 @@
+#include "CpuInfo.h"
+#include <thread>
+#include <filesystem>
+#include <string>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define TRADUCTOR_X86 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define TRADUCTOR_X86 1
+#endif
+
+namespace traductor {
+
+namespace {
+
+#ifdef TRADUCTOR_X86
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(out[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+unsigned long long xgetbv0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+CpuInfo::Features detectFeatures() {
+    CpuInfo::Features f;
+#ifdef TRADUCTOR_X86
+    unsigned int regs[4] = {0, 0, 0, 0};
+    cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 7) {
+        return f;
+    }
+    
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool fma = (regs[2] >> 12) & 1;
+    if (!osxsave) {
+        return f;
+    }
+    
+    // The OS must save YMM state for AVX, and opmask/ZMM state for AVX-512
+    const unsigned long long xcr0 = xgetbv0();
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = ymmState && (xcr0 & 0xE0) == 0xE0;
+    
+    cpuid(7, 0, regs);
+    const unsigned int ebx7 = regs[1];
+    const unsigned int ecx7 = regs[2];
+    f.avx2 = ymmState && ((ebx7 >> 5) & 1);
+    f.fma = ymmState && fma;
+    f.avx512f = zmmState && ((ebx7 >> 16) & 1);
+    f.avx512bw = zmmState && ((ebx7 >> 30) & 1);
+    f.avx512vnni = f.avx512f && ((ecx7 >> 11) & 1);
+    
+    cpuid(7, 1, regs);
+    f.avxvnni = ymmState && ((regs[0] >> 4) & 1);
+#endif
+    return f;
+}
+
+} // namespace
+
+std::string CpuInfo::Features::toString() const {
+    std::string names;
+    auto add = [&names](bool present, const char* name) {
+        if (!present) return;
+        if (!names.empty()) names += " ";
+        names += name;
+    };
+    add(avx2, "avx2");
+    add(fma, "fma");
+    add(avx512f, "avx512f");
+    add(avx512bw, "avx512bw");
+    add(avx512vnni, "avx512_vnni");
+    add(avxvnni, "avx_vnni");
+    return names.empty() ? "none" : names;
+}
+
+const CpuInfo::Features& CpuInfo::features() {
+    static const Features detected = detectFeatures();
+    return detected;
+}
+
+int CpuInfo::logicalCores() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+bool CpuInfo::pinCurrentThread(const std::vector<int>& cores) {
+    if (cores.empty()) {
+        return false;
+    }
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int core : cores) {
+        if (core >= 0 && core < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << core;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        if (core >= 0 && core < CPU_SETSIZE) {
+            CPU_SET(core, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+int CpuInfo::numaNodeOfCore(int core) {
+#ifdef __linux__
+    // /sys/devices/system/cpu/cpuN/nodeM exists for the node owning the core
+    std::error_code ec;
+    std::filesystem::path cpuDir = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+    for (const auto& entry : std::filesystem::directory_iterator(cpuDir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) == 0 && name.size() > 4) {
+            return std::atoi(name.c_str() + 4);
+        }
+    }
+#else
+    (void)core;
+#endif
+    return 0;
+}
+
+} // namespace traductor
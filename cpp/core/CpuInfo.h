@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Host CPU topology helpers: core counts, thread affinity and ISA features.
+ * Affinity calls are best-effort and return false where unsupported.
+ */
+class CpuInfo {
+public:
+    // x86 vector extensions relevant to the int8/float32 GEMM kernels.
+    // Each flag is set only when the OS also saves the matching registers.
+    struct Features {
+        bool avx2 = false;
+        bool fma = false;
+        bool avx512f = false;
+        bool avx512bw = false;
+        bool avx512vnni = false;
+        bool avxvnni = false;  // VEX-encoded VNNI (Alder Lake and later)
+        
+        bool vnni() const { return avx512vnni || avxvnni; }
+        std::string toString() const;  // e.g. "avx2 fma avx512f avx512_vnni"
+    };
+    
+    // Detected once, then cached
+    static const Features& features();
+    
+    // Number of logical cores available to the process
+    static int logicalCores();
+    
+    // Restrict the calling thread to the given logical cores.
+    // Threads it creates afterwards inherit the mask.
+    static bool pinCurrentThread(const std::vector<int>& cores);
+    
+    // NUMA node of a logical core (0 if unknown)
+    static int numaNodeOfCore(int core);
+};
+
+} // namespace traductor
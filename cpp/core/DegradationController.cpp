@@ -0,0 +1,94 @@
+#include "DegradationController.h"
+#include <algorithm>
+
+namespace traductor {
+
+namespace {
+
+// Weight of the newest sample in the latency average; ~10 requests of memory
+constexpr double kLatencyAlpha = 0.2;
+
+} // namespace
+
+std::string DegradationController::Level::label() const {
+    if (useSmallModel) return "small-model";
+    if (maxBeam == 1) return "greedy";
+    if (maxBeam > 0) return "beam<=" + std::to_string(maxBeam);
+    return "normal";
+}
+
+DegradationController::DegradationController(Options options) : options_(std::move(options)) {}
+
+int DegradationController::maxLevel() const {
+    if (!options_.enabled) return 0;
+    return static_cast<int>(options_.beamSteps.size()) + (options_.smallModelStep ? 1 : 0);
+}
+
+DegradationController::Level DegradationController::levelAt(int index) const {
+    Level level;
+    level.index = index;
+    if (index <= 0) {
+        return level;
+    }
+    
+    const int beamLevels = static_cast<int>(options_.beamSteps.size());
+    if (index <= beamLevels) {
+        level.maxBeam = options_.beamSteps[index - 1];
+    } else {
+        // The small model runs greedy: it is only reached when even that was not enough
+        level.maxBeam = 1;
+        level.useSmallModel = true;
+    }
+    return level;
+}
+
+void DegradationController::observe(size_t queueDepth, double latencyMs, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    latencyEwmaMs_ = haveLatency_ ? kLatencyAlpha * latencyMs + (1.0 - kLatencyAlpha) * latencyEwmaMs_
+                                  : latencyMs;
+    haveLatency_ = true;
+    lastQueueDepth_ = queueDepth;
+    
+    if (!options_.enabled || now - lastChange_ < options_.holdTime) {
+        return;
+    }
+    
+    const bool overloaded = queueDepth > options_.degradeQueueDepth ||
+                            latencyEwmaMs_ > options_.degradeLatencyMs;
+    const bool relaxed = queueDepth <= options_.recoverQueueDepth &&
+                         latencyEwmaMs_ <= options_.recoverLatencyMs;
+    
+    if (overloaded && level_ < maxLevel()) {
+        level_++;
+    } else if (relaxed && level_ > 0) {
+        level_--;
+    } else {
+        return;
+    }
+    levelChanges_++;
+    lastChange_ = now;
+}
+
+void DegradationController::setSmallModelAvailable(bool available) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_.smallModelStep = available;
+    level_ = std::min(level_, maxLevel());
+}
+
+DegradationController::Level DegradationController::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return levelAt(level_);
+}
+
+DegradationController::Stats DegradationController::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.level = levelAt(level_);
+    stats.latencyEwmaMs = latencyEwmaMs_;
+    stats.lastQueueDepth = lastQueueDepth_;
+    stats.levelChanges = levelChanges_;
+    return stats;
+}
+
+} // namespace traductor
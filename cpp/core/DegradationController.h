@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Load-adaptive quality control. The engine reports its queue depth and each
+ * request's latency; when either crosses the degrade threshold the controller
+ * steps down one level (smaller beam, then greedy, then the small model), and
+ * it steps back up only once both are below the lower recover thresholds.
+ * Level changes are at least holdTime apart, so it does not flap.
+ */
+class DegradationController {
+public:
+    struct Options {
+        bool enabled = false;
+        size_t degradeQueueDepth = 8;
+        double degradeLatencyMs = 2000.0;
+        size_t recoverQueueDepth = 2;
+        double recoverLatencyMs = 800.0;
+        std::chrono::milliseconds holdTime{3000};
+        std::vector<int> beamSteps = {2, 1};  // beam cap of each level
+        bool smallModelStep = false;          // last level switches to the small model
+    };
+    
+    struct Level {
+        int index = 0;              // 0 = full quality
+        int maxBeam = 0;            // 0 = no cap
+        bool useSmallModel = false;
+        
+        bool degraded() const { return index > 0; }
+        std::string label() const;  // "normal", "beam<=2", "small-model", ...
+    };
+    
+    struct Stats {
+        Level level;
+        double latencyEwmaMs = 0.0;
+        size_t lastQueueDepth = 0;
+        size_t levelChanges = 0;
+    };
+    
+    using Clock = std::chrono::steady_clock;
+    
+    explicit DegradationController(Options options);
+    
+    // Record one finished request and move at most one level
+    void observe(size_t queueDepth, double latencyMs, Clock::time_point now = Clock::now());
+    
+    // The small-model level only exists once a small model is loaded
+    void setSmallModelAvailable(bool available);
+    
+    Level current() const;
+    Stats getStats() const;
+    int maxLevel() const;
+
+private:
+    Options options_;
+    mutable std::mutex mutex_;
+    int level_ = 0;
+    double latencyEwmaMs_ = 0.0;
+    bool haveLatency_ = false;
+    size_t lastQueueDepth_ = 0;
+    size_t levelChanges_ = 0;
+    Clock::time_point lastChange_{};
+    
+    Level levelAt(int index) const;
+};
+
+} // namespace traductor
@@ -0,0 +1,95 @@
+#include "FairQueue.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace traductor {
+
+FairQueue::FairQueue(size_t workers, size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1) {
+    workers = std::max<size_t>(1, workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&FairQueue::workerLoop, this);
+    }
+}
+
+FairQueue::~FairQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool FairQueue::submit(const std::string& client, double weight, double cost, Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || queue_.size() >= capacity_) {
+            rejected_++;
+            return false;
+        }
+        
+        double& last = lastFinish_[client];
+        double finish = std::max(virtualTime_, last) + std::max(cost, 1.0) / std::max(weight, 1e-3);
+        last = finish;
+        queue_.emplace(Key{finish, arrivals_++}, Entry{client, std::move(job)});
+        queuedPerClient_[client]++;
+    }
+    ready_.notify_one();
+    return true;
+}
+
+FairQueue::Stats FairQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.queued = queue_.size();
+    stats.running = running_;
+    stats.dispatched = dispatched_;
+    stats.rejected = rejected_;
+    return stats;
+}
+
+size_t FairQueue::queuedFor(const std::string& client) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queuedPerClient_.find(client);
+    return it == queuedPerClient_.end() ? 0 : it->second;
+}
+
+void FairQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        // Drain what is queued before stopping, so no accepted request goes unanswered
+        ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+        
+        auto head = queue_.begin();
+        virtualTime_ = head->first.first;
+        Entry entry = std::move(head->second);
+        queue_.erase(head);
+        if (--queuedPerClient_[entry.client] == 0) {
+            queuedPerClient_.erase(entry.client);
+        }
+        // Once a client has nothing queued its tag can fall behind V; drop it
+        if (lastFinish_[entry.client] <= virtualTime_ && !queuedPerClient_.count(entry.client)) {
+            lastFinish_.erase(entry.client);
+        }
+        running_++;
+        dispatched_++;
+        lock.unlock();
+        
+        try {
+            entry.job();
+        } catch (const std::exception& e) {
+            TRADUCTOR_LOG(Error, "rest") << "Queued request failed: " << e.what();
+        }
+        
+        lock.lock();
+        running_--;
+    }
+}
+
+} // namespace traductor
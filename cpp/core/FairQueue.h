@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Weighted fair queue in front of a fixed set of worker threads (self-clocked
+ * fair queuing). Each job gets a finish tag max(V, client's last tag) + cost / weight,
+ * and workers always run the smallest tag next, so a client flooding the queue
+ * only delays its own later jobs. V is the tag of the job dispatched last.
+ */
+class FairQueue {
+public:
+    using Job = std::function<void()>;
+    
+    struct Stats {
+        size_t queued = 0;
+        size_t running = 0;
+        size_t dispatched = 0;
+        size_t rejected = 0;  // queue full
+    };
+    
+    FairQueue(size_t workers, size_t capacity);
+    ~FairQueue();
+    
+    FairQueue(const FairQueue&) = delete;
+    FairQueue& operator=(const FairQueue&) = delete;
+    
+    // Queue a job; false (job not run) when the queue is full or shutting down
+    bool submit(const std::string& client, double weight, double cost, Job job);
+    
+    Stats getStats() const;
+    size_t queuedFor(const std::string& client) const;
+
+private:
+    struct Entry {
+        std::string client;
+        Job job;
+    };
+    
+    // Ordered by (finish tag, arrival) so equal tags keep FIFO order
+    using Key = std::pair<double, size_t>;
+    
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::map<Key, Entry> queue_;
+    std::unordered_map<std::string, double> lastFinish_;
+    std::unordered_map<std::string, size_t> queuedPerClient_;
+    double virtualTime_ = 0.0;
+    size_t arrivals_ = 0;
+    size_t running_ = 0;
+    size_t dispatched_ = 0;
+    size_t rejected_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+    
+    void workerLoop();
+};
+
+} // namespace traductor
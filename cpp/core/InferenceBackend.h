@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Sequence-to-sequence model behind the replica pool. The engine hands it
+ * token ids from the Tokenizer and decodes the ids it returns; everything
+ * around the call (batching, loop guards, retries, escalation) stays in the
+ * engine. Each replica owns its own backend and only calls it from the
+ * replica's thread, so implementations need not be thread-safe.
+ */
+class InferenceBackend {
+public:
+    // Decoding settings for one call, mirroring the CTranslate2 options the engine uses
+    struct Options {
+        size_t beamSize = 1;
+        float lengthPenalty = 1.0f;
+        float patience = 1.0f;
+        size_t maxDecodingLength = 256;
+        bool useVmap = false;
+        bool returnScores = false;
+        size_t noRepeatNgramSize = 0;
+        float repetitionPenalty = 1.0f;
+        // Called per generated token; returning true stops that sequence.
+        // Backends may only call it for greedy search.
+        std::function<bool(size_t sequence, int tokenId)> stepCallback;
+    };
+
+    struct Hypothesis {
+        std::vector<int> ids;  // empty when the backend produced nothing
+        float score = 0.0f;    // log-probability, set when hasScore
+        bool hasScore = false;
+    };
+
+    virtual ~InferenceBackend() = default;
+
+    // Short name for logs and /health ("ctranslate2", "mock")
+    virtual const char* name() const = 0;
+
+    // One best hypothesis per source sequence, in order. targetLang (e.g.
+    // "dan_Latn") is the forced first target token. Throws on model errors.
+    virtual std::vector<Hypothesis> translateBatch(const std::vector<std::vector<int>>& sources,
+                                                   const std::string& targetLang,
+                                                   const Options& options) = 0;
+};
+
+} // namespace traductor
@@ -0,0 +1,141 @@
+#include "InferencePipeline.h"
+#include <stdexcept>
+
+namespace traductor {
+
+InferencePipeline::InferencePipeline(Stages stages, size_t queueCapacity)
+    : stages_(std::move(stages)),
+      preprocessQueue_(queueCapacity, 0.0),
+      inferenceQueue_(queueCapacity, 0.0),
+      completionQueue_(queueCapacity, 0.0) {
+    for (auto* queue : {&preprocessQueue_, &inferenceQueue_, &completionQueue_}) {
+        queue->setStalePolicy(isStopped, [this](Item item) { dropStopped(std::move(item)); });
+    }
+    for (Priority lane : {Priority::Interactive, Priority::Bulk}) {
+        preprocessThreads_.emplace_back([this, lane] {
+            runStage(preprocessQueue_, lane, &inferenceQueue_, stages_.preprocess);
+        });
+        inferenceThreads_.emplace_back([this, lane] {
+            runStage(inferenceQueue_, lane, &completionQueue_, stages_.launch);
+        });
+        completionThreads_.emplace_back([this, lane] {
+            runStage(completionQueue_, lane, nullptr, [this](Batch& batch) {
+                if (batch.await) {
+                    batch.await(batch);
+                }
+                stages_.complete(batch);
+            });
+        });
+    }
+}
+
+InferencePipeline::~InferencePipeline() {
+    // Closing drains each queue in order, so queued batches still complete
+    preprocessQueue_.close();
+    for (auto& thread : preprocessThreads_) {
+        thread.join();
+    }
+    inferenceQueue_.close();
+    for (auto& thread : inferenceThreads_) {
+        thread.join();
+    }
+    completionQueue_.close();
+    for (auto& thread : completionThreads_) {
+        thread.join();
+    }
+}
+
+std::future<std::vector<std::string>> InferencePipeline::submit(std::unique_ptr<Batch> batch) {
+    Item item;
+    item.batch = std::move(batch);
+    item.batch->submittedAt = std::chrono::steady_clock::now();
+    item.batch->id = submitted_++;
+    auto future = item.result.get_future();
+    const Priority priority = item.batch->settings.priority;
+
+    if (!preprocessQueue_.push(std::move(item), priority)) {
+        std::promise<std::vector<std::string>> rejected;
+        rejected.set_exception(std::make_exception_ptr(std::runtime_error("Pipeline is shutting down")));
+        return rejected.get_future();
+    }
+    return future;
+}
+
+InferencePipeline::Stats InferencePipeline::getStats() const {
+    Stats stats;
+    stats.preprocessQueueDepth = preprocessQueue_.size();
+    stats.inferenceQueueDepth = inferenceQueue_.size();
+    stats.completionQueueDepth = completionQueue_.size();
+    stats.queueCapacity = preprocessQueue_.capacity();
+    stats.batchesSubmitted = submitted_.load();
+    stats.batchesCompleted = completed_.load();
+    stats.batchesCancelled = cancelled_.load();
+    for (const auto* queue : {&preprocessQueue_, &inferenceQueue_, &completionQueue_}) {
+        stats.interactiveQueued += queue->laneStats(Priority::Interactive).depth;
+        stats.bulkQueued += queue->laneStats(Priority::Bulk).depth;
+    }
+    return stats;
+}
+
+void InferencePipeline::dropInFlight(Batch& batch) {
+    // A launched replica job still references the batch. Greedy decoding sees
+    // the same token and stops at its next step; a beam search runs to the end,
+    // so only the completion stage (which would wait for it anyway) calls this.
+    if (batch.await) {
+        try {
+            batch.await(batch);
+        } catch (...) {
+        }
+        batch.await = nullptr;
+    }
+}
+
+bool InferencePipeline::isStopped(const Item& item) {
+    // A batch with its model call in flight is not dropped on push: that would
+    // make the pushing stage wait for the call. It keeps its slot until the
+    // completion stage pops it, waits for the call and fails it.
+    if (item.batch->await) {
+        return false;
+    }
+    const auto& cancel = item.batch->settings.cancel;
+    return cancel && cancel->stopRequested();
+}
+
+void InferencePipeline::dropStopped(Item item) {
+    cancelled_++;
+    completed_++;
+    item.result.set_exception(std::make_exception_ptr(OperationCancelled(item.batch->settings.cancel->reason())));
+}
+
+void InferencePipeline::runStage(PriorityScheduler<Item>& input, Priority lane,
+                                 PriorityScheduler<Item>* output, const std::function<void(Batch&)>& stage) {
+    while (auto item = input.pop(lane)) {
+        try {
+            const auto& cancel = item->batch->settings.cancel;
+            if (cancel) {
+                auto reason = cancel->reason();
+                if (reason != CancellationToken::Reason::None) {
+                    cancelled_++;
+                    dropInFlight(*item->batch);
+                    throw OperationCancelled(reason);
+                }
+            }
+            stage(*item->batch);
+        } catch (...) {
+            // A failed batch skips the remaining stages
+            completed_++;
+            item->result.set_exception(std::current_exception());
+            continue;
+        }
+
+        if (output) {
+            const Priority priority = item->batch->settings.priority;
+            output->push(std::move(*item), priority);
+        } else {
+            completed_++;
+            item->result.set_value(std::move(item->batch->translations));
+        }
+    }
+}
+
+} // namespace traductor
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CancellationToken.h"
+#include "Config.h"
+#include "PriorityScheduler.h"
+#include "SlowRequestLog.h"
+#include "Tokenizer.h"
+
+namespace traductor {
+
+class Glossary;
+
+/**
+ * Three-stage translation pipeline with bounded queues between the stages:
+ *   preprocess (tokenization) -> inference (async model call) -> complete
+ *   (wait for the model, detokenize).
+ * Each stage runs on its own threads, so batch N+1 is tokenized while batch N
+ * decodes and batch N-1 is being detokenized. Language post-processing and
+ * glossary restoration run on each whole text once its segments are rejoined.
+ * Every queue has an interactive and a bulk lane, and every stage runs one
+ * thread per lane: a stage blocked on bulk work (a full bulk lane downstream,
+ * a full replica queue, a long decode) never holds back an interactive batch.
+ * The bulk share between lanes is enforced where they compete for the model,
+ * in the ReplicaPool queue.
+ * A batch whose request was cancelled or passed its deadline is failed with
+ * OperationCancelled when its next stage pops it, or earlier if a push needs
+ * its queue slot (the queues drop stopped batches from a full lane). A batch
+ * whose model call is already running is only failed by the completion stage,
+ * after the call returns.
+ */
+class InferencePipeline {
+public:
+    // Per-request decoding settings, shared by every batch of the request
+    struct Settings {
+        std::string direction;
+        int maxNewTokens = -1;
+        bool formal = false;
+        const Glossary* glossary = nullptr;  // restored by the caller after rejoining
+        DecodingProfile profile;
+        bool useSmallModel = false;          // run on the small model replicas
+        bool escalateLowConfidence = false;  // cascade: redo low-score output on the large model
+        Priority priority = Priority::Interactive;
+        std::shared_ptr<const CancellationToken> cancel;  // request's stop flag and deadline
+        uint64_t traceId = 0;  // nonzero when the request is traced (see Tracer)
+        std::shared_ptr<SlowRequestLog::Breakdown> breakdown;  // per-request stage times, when logging slow requests
+    };
+
+    struct Batch {
+        // Input sequences (glossary-protected, segmented and packed)
+        std::vector<std::string> sources;
+        Settings settings;
+        std::chrono::steady_clock::time_point submittedAt;  // set by submit()
+        uint64_t id = 0;                                    // set by submit(), unique per pipeline
+
+        // Filled by the stages
+        Tokenizer::TokenBatch tokens;
+        Tokenizer::TokenBatch output;
+        std::function<void(Batch&)> await;  // set by launch when inference is asynchronous
+        std::vector<std::string> translations;
+    };
+
+    struct Stages {
+        std::function<void(Batch&)> preprocess;
+        std::function<void(Batch&)> launch;
+        std::function<void(Batch&)> complete;
+    };
+
+    struct Stats {
+        size_t preprocessQueueDepth = 0;
+        size_t inferenceQueueDepth = 0;
+        size_t completionQueueDepth = 0;
+        size_t queueCapacity = 0;
+        size_t batchesSubmitted = 0;
+        size_t batchesCompleted = 0;
+        size_t batchesCancelled = 0;   // dropped between stages after their request stopped
+        size_t interactiveQueued = 0;  // batches waiting in any stage queue, per lane
+        size_t bulkQueued = 0;
+    };
+
+    // queueCapacity is per lane
+    InferencePipeline(Stages stages, size_t queueCapacity);
+    ~InferencePipeline();
+
+    InferencePipeline(const InferencePipeline&) = delete;
+    InferencePipeline& operator=(const InferencePipeline&) = delete;
+
+    // Queue a batch; the future yields one translation per source sequence
+    std::future<std::vector<std::string>> submit(std::unique_ptr<Batch> batch);
+
+    Stats getStats() const;
+
+private:
+    struct Item {
+        std::unique_ptr<Batch> batch;
+        std::promise<std::vector<std::string>> result;
+    };
+
+    Stages stages_;
+    PriorityScheduler<Item> preprocessQueue_;
+    PriorityScheduler<Item> inferenceQueue_;
+    PriorityScheduler<Item> completionQueue_;
+
+    std::atomic<size_t> submitted_{0};
+    std::atomic<size_t> completed_{0};
+    std::atomic<size_t> cancelled_{0};
+
+    // One thread per lane for each stage
+    std::vector<std::thread> preprocessThreads_;
+    std::vector<std::thread> inferenceThreads_;
+    std::vector<std::thread> completionThreads_;
+
+    // Pop from one lane of input, run stage, push to output (or fulfil the promise at the end)
+    void runStage(PriorityScheduler<Item>& input, Priority lane, PriorityScheduler<Item>* output,
+                  const std::function<void(Batch&)>& stage);
+    static void dropInFlight(Batch& batch);
+    static bool isStopped(const Item& item);
+    void dropStopped(Item item);
+};
+
+} // namespace traductor
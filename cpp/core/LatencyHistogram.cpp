@@ -0,0 +1,109 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace traductor {
+
+size_t LatencyHistogram::bucketFor(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    // Top 5 significant bits: the leading one picks the power of two, the next 4 the sub-bucket
+    const int exponent = std::bit_width(value) - 1;
+    const int shift = exponent - 4;
+    const size_t sub = static_cast<size_t>(value >> shift) - kSubBuckets;
+    return kSubBuckets + static_cast<size_t>(shift) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const size_t shift = (bucket - kSubBuckets) / kSubBuckets;
+    const size_t sub = (bucket - kSubBuckets) % kSubBuckets;
+    return static_cast<uint64_t>(kSubBuckets + sub) << shift;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets_[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = min_.load(std::memory_order_relaxed);
+    while (value < seen && !min_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+    seen = max_.load(std::memory_order_relaxed);
+    while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t n = count_.load(std::memory_order_relaxed);
+    return n > 0 ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+}
+
+double LatencyHistogram::percentile(double q) const {
+    // Counts are read bucket by bucket while writers continue, so use their own total
+    std::array<uint64_t, kBuckets> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            const double low = static_cast<double>(bucketLowerBound(i));
+            const double high = i + 1 < kBuckets ? static_cast<double>(bucketLowerBound(i + 1)) : low;
+            const double value = i < kSubBuckets ? low : (low + high) / 2.0;
+            // The exact extremes are known, keep the estimate inside them
+            const double lowest = static_cast<double>(min_.load(std::memory_order_relaxed));
+            const double highest = static_cast<double>(max_.load(std::memory_order_relaxed));
+            return lowest <= highest ? std::clamp(value, lowest, highest) : value;
+        }
+    }
+    return static_cast<double>(max_.load(std::memory_order_relaxed));
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary(double scale) const {
+    Summary summary;
+    summary.count = static_cast<size_t>(count());
+    if (summary.count == 0) {
+        return summary;
+    }
+    summary.mean = mean() * scale;
+    summary.min = static_cast<double>(min_.load(std::memory_order_relaxed)) * scale;
+    summary.max = static_cast<double>(max_.load(std::memory_order_relaxed)) * scale;
+    summary.p50 = percentile(0.50) * scale;
+    summary.p90 = percentile(0.90) * scale;
+    summary.p99 = percentile(0.99) * scale;
+    summary.p999 = percentile(0.999) * scale;
+    summary.sum = static_cast<double>(sum_.load(std::memory_order_relaxed)) * scale;
+    return summary;
+}
+
+std::vector<uint64_t> LatencyHistogram::cumulativeCounts(const std::vector<double>& bounds, double scale) const {
+    std::vector<uint64_t> counts(bounds.size(), 0);
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < kBuckets && next < bounds.size(); ++i) {
+        const double low = static_cast<double>(bucketLowerBound(i)) * scale;
+        while (next < bounds.size() && low > bounds[next]) {
+            counts[next++] = seen;
+        }
+        seen += buckets_[i].load(std::memory_order_relaxed);
+    }
+    while (next < bounds.size()) {
+        counts[next++] = seen;
+    }
+    return counts;
+}
+
+} // namespace traductor
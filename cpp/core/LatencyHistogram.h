@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Lock-free log-linear histogram (HDR style) over non-negative integer values.
+ * Every power of two is split into 16 linear sub-buckets, so any recorded value
+ * is reported within 1/16 (about 6%) of its true value over the whole 64-bit
+ * range. record() is a handful of relaxed atomic adds, cheap enough for per-batch
+ * and per-text timing on the hot path; summaries are computed on read.
+ */
+class LatencyHistogram {
+public:
+    // Percentiles and moments of the recorded values, multiplied by a scale
+    // (e.g. 0.001 to report microsecond recordings in milliseconds)
+    struct Summary {
+        size_t count = 0;
+        double mean = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double sum = 0.0;
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value);
+    void recordDuration(std::chrono::steady_clock::duration elapsed) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        record(us > 0 ? static_cast<uint64_t>(us) : 0);
+    }
+
+    size_t count() const { return count_.load(std::memory_order_relaxed); }
+    double mean() const;
+    // Value at quantile q in [0, 1], bucket midpoint; 0 when empty
+    double percentile(double q) const;
+    Summary summary(double scale = 1.0) const;
+    // Cumulative counts at each (scaled) upper bound, for exporters with fixed buckets.
+    // A bucket straddling a bound counts as below it, so counts may run up to 6% early.
+    std::vector<uint64_t> cumulativeCounts(const std::vector<double>& bounds, double scale = 1.0) const;
+
+    // Records the lifetime of the scope in microseconds
+    class Timer {
+    public:
+        explicit Timer(LatencyHistogram& histogram)
+            : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+        ~Timer() { histogram_.recordDuration(std::chrono::steady_clock::now() - start_); }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        LatencyHistogram& histogram_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    static constexpr size_t kSubBuckets = 16;
+    static constexpr size_t kBuckets = kSubBuckets + (64 - 4) * kSubBuckets;
+
+    static size_t bucketFor(uint64_t value);
+    static uint64_t bucketLowerBound(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace traductor
@@ -0,0 +1,306 @@
+#include "Logger.h"
+#include "Config.h"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace traductor {
+
+namespace {
+
+// Repeat windows are checked this often even when nothing is logged
+constexpr std::chrono::milliseconds kSweepInterval{1000};
+constexpr std::chrono::milliseconds kIdleWait{200};
+
+std::string timestamp(Logger::Clock::time_point time) {
+    auto seconds = Logger::Clock::to_time_t(time);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char buffer[32];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &utc);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03dZ", static_cast<int>(millis));
+    return buffer;
+}
+
+} // namespace
+
+Logger::Options Logger::Options::fromConfig(const Config& config) {
+    Options options;
+    if (!parseLogLevel(config.logLevel(), options.level)) {
+        std::cerr << "Warning: unknown log_level '" << config.logLevel() << "', using info" << std::endl;
+    }
+    options.format = config.logFormat() == "json" ? Format::Json : Format::Text;
+    options.path = config.logFile();
+    return options;
+}
+
+Logger& Logger::instance() {
+    // Never destroyed: objects torn down at exit may still log. The atexit
+    // handler drains the ring first, after which lines are written directly.
+    static Logger* logger = [] {
+        auto* created = new Logger();
+        std::atexit([] { Logger::instance().shutdown(); });
+        return created;
+    }();
+    return *logger;
+}
+
+Logger::Logger()
+    : slots_(std::make_unique<std::array<Slot, kCapacity>>()), lastSweep_(Clock::now()) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+        (*slots_)[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer_ = std::thread([this] { run(); });
+}
+
+bool Logger::configure(const Options& options) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    bool ok = true;
+    if (options.path != options_.path || !file_.is_open()) {
+        file_.close();
+        if (!options.path.empty()) {
+            file_.open(options.path, std::ios::out | std::ios::app);
+            ok = file_.is_open();
+            if (!ok) {
+                std::cerr << "Warning: cannot open log file " << options.path << ", logging to stderr" << std::endl;
+            }
+        }
+    }
+    options_ = options;
+    level_.store(options.level, std::memory_order_relaxed);
+    return ok;
+}
+
+void Logger::log(LogLevel level, const char* component, std::string message) {
+    if (!enabled(level)) {
+        return;
+    }
+    Record record{level, Clock::now(), component, std::move(message)};
+
+    if (stopped_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(outputMutex_);
+        write(record);
+        std::cerr.flush();
+        if (file_.is_open()) {
+            file_.flush();
+        }
+        return;
+    }
+
+    if (!tryPush(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pushed_.fetch_add(1, std::memory_order_release);
+
+    // Only an idle writer needs waking; taking the mutex orders this with its wait
+    if (writerWaiting_.load(std::memory_order_acquire)) {
+        { std::lock_guard<std::mutex> lock(wakeMutex_); }
+        wake_.notify_one();
+    }
+}
+
+void Logger::flush() {
+    const uint64_t target = pushed_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+    while (processed_.load(std::memory_order_acquire) < target && !stopped_.load(std::memory_order_acquire)) {
+        drained_.wait_for(lock, kIdleWait);
+    }
+}
+
+void Logger::shutdown() {
+    if (stopping_.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wake_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    stopped_.store(true, std::memory_order_release);
+    drained_.notify_all();
+
+    // Anything pushed while the writer was finishing
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    Record record;
+    while (tryPop(record)) {
+        write(record);
+    }
+    sweepRepeats(Clock::now(), true);
+    std::cerr.flush();
+    if (file_.is_open()) {
+        file_.flush();
+    }
+}
+
+Logger::Stats Logger::getStats() const {
+    Stats stats;
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.suppressed = suppressed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool Logger::tryPush(Record& record) {
+    auto& slots = *slots_;
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & (kCapacity - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // full
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::tryPop(Record& record) {
+    auto& slots = *slots_;
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & (kCapacity - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                record = std::move(slot.record);
+                slot.sequence.store(pos + kCapacity, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // empty
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::run() {
+    Record record;
+    for (;;) {
+        bool wrote = false;
+        uint64_t popped = 0;
+        {
+            std::lock_guard<std::mutex> lock(outputMutex_);
+            while (tryPop(record)) {
+                write(record);
+                popped++;
+                wrote = true;
+            }
+            const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+            if (dropped > droppedReported_) {
+                emit(Record{LogLevel::Warning, Clock::now(), "logger",
+                            std::to_string(dropped - droppedReported_) + " lines dropped, queue full"}, "");
+                droppedReported_ = dropped;
+                wrote = true;
+            }
+            auto now = Clock::now();
+            if (now - lastSweep_ >= kSweepInterval) {
+                wrote = sweepRepeats(now, false) || wrote;
+                lastSweep_ = now;
+            }
+            if (wrote) {
+                (file_.is_open() ? static_cast<std::ostream&>(file_) : std::cerr).flush();
+            }
+        }
+        // Counted once on disk, so flush() callers see the lines
+        processed_.fetch_add(popped, std::memory_order_release);
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        drained_.notify_all();
+        if (wrote) {
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        writerWaiting_.store(true, std::memory_order_release);
+        wake_.wait_for(lock, kIdleWait, [this] {
+            return stopping_.load(std::memory_order_acquire) ||
+                   head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_acquire);
+        });
+        writerWaiting_.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::write(const Record& record) {
+    if (options_.repeatBurst == 0) {
+        emit(record, "");
+        return;
+    }
+    std::string key = std::to_string(static_cast<int>(record.level)) + record.component + '\x1f' + record.message;
+    auto [it, inserted] = repeats_.try_emplace(std::move(key));
+    Repeat& repeat = it->second;
+    if (inserted) {
+        repeat.windowStart = record.time;
+    } else if (record.time - repeat.windowStart >= options_.repeatWindow) {
+        if (repeat.count > options_.repeatBurst) {
+            emit(repeat.last, " (repeated " + std::to_string(repeat.count - options_.repeatBurst) + " more times)");
+        }
+        repeat.windowStart = record.time;
+        repeat.count = 0;
+    }
+
+    repeat.count++;
+    if (repeat.count <= options_.repeatBurst) {
+        emit(record, "");
+    } else {
+        repeat.last = record;
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::emit(const Record& record, const std::string& suffix) {
+    std::string line;
+    if (options_.format == Format::Json) {
+        nlohmann::json json;
+        json["ts"] = timestamp(record.time);
+        json["level"] = logLevelName(record.level);
+        json["component"] = record.component;
+        json["msg"] = record.message + suffix;
+        line = json.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    } else {
+        line = timestamp(record.time) + " " + logLevelName(record.level) + " [" + record.component + "] " +
+               record.message + suffix;
+    }
+    line += '\n';
+    std::ostream& out = file_.is_open() ? static_cast<std::ostream&>(file_) : std::cerr;
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Logger::sweepRepeats(Clock::time_point now, bool all) {
+    bool emitted = false;
+    for (auto it = repeats_.begin(); it != repeats_.end();) {
+        Repeat& repeat = it->second;
+        if (!all && now - repeat.windowStart < options_.repeatWindow) {
+            ++it;
+            continue;
+        }
+        if (repeat.count > options_.repeatBurst) {
+            emit(repeat.last, " (repeated " + std::to_string(repeat.count - options_.repeatBurst) + " more times)");
+            emitted = true;
+        }
+        it = repeats_.erase(it);
+    }
+    return emitted;
+}
+
+} // namespace traductor
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace traductor {
+
+class Config;
+
+enum class LogLevel { Debug = 0, Info = 1, Warning = 2, Error = 3, Off = 4 };
+
+inline const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warning: return "warning";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: break;
+    }
+    return "off";
+}
+
+// Returns false for unknown names
+inline bool parseLogLevel(const std::string& name, LogLevel& level) {
+    for (auto candidate : {LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error, LogLevel::Off}) {
+        if (name == logLevelName(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Process-wide asynchronous logger. Callers format a line and push it into a
+ * lock-free bounded ring (no global lock, no I/O on the calling thread); a
+ * background thread writes it as text or JSON to stderr or a file. When the
+ * ring is full the line is dropped and counted rather than blocking the hot
+ * path. Identical lines beyond a small burst per window are suppressed and
+ * summarized once the window ends, so a failing batch cannot flood the log.
+ * Lines still queued at exit are written by an atexit handler.
+ */
+class Logger {
+public:
+    using Clock = std::chrono::system_clock;
+
+    enum class Format { Text, Json };
+
+    struct Options {
+        LogLevel level = LogLevel::Info;
+        Format format = Format::Text;
+        std::string path;                         // empty writes to stderr
+        size_t repeatBurst = 5;                   // identical lines written per window
+        std::chrono::milliseconds repeatWindow{10000};
+
+        // log_level, log_format and log_file; unknown names keep the defaults
+        static Options fromConfig(const Config& config);
+    };
+
+    static Logger& instance();
+
+    // Applies to lines logged from now on; returns false if the file cannot be opened
+    bool configure(const Options& options);
+
+    bool enabled(LogLevel level) const {
+        return level != LogLevel::Off && level >= level_.load(std::memory_order_relaxed);
+    }
+
+    // component is a string literal naming the subsystem (engine, tokenizer, rest, ...)
+    void log(LogLevel level, const char* component, std::string message);
+
+    // Blocks until every line logged before the call has been written
+    void flush();
+
+    // Drains the ring and stops the writer; later lines are written synchronously
+    void shutdown();
+
+    struct Stats {
+        uint64_t written = 0;
+        uint64_t dropped = 0;     // ring full
+        uint64_t suppressed = 0;  // repeats over the burst
+    };
+    Stats getStats() const;
+
+    static constexpr size_t kCapacity = 4096;  // power of two
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    Logger();
+    ~Logger() = default;
+
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        Clock::time_point time;
+        const char* component = "";
+        std::string message;
+    };
+
+    // Bounded MPMC ring (Vyukov): each slot's sequence says whose turn it is
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+    bool tryPush(Record& record);
+    bool tryPop(Record& record);
+
+    void run();  // writer thread
+    // Called with outputMutex_ held
+    void write(const Record& record);
+    void emit(const Record& record, const std::string& suffix);
+    // Summarizes and forgets repeats whose window ended; true if it wrote anything
+    bool sweepRepeats(Clock::time_point now, bool all);
+
+    std::atomic<LogLevel> level_{LogLevel::Info};
+    std::unique_ptr<std::array<Slot, kCapacity>> slots_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+
+    std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> suppressed_{0};
+    uint64_t droppedReported_ = 0;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    std::atomic<bool> writerWaiting_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> stopped_{false};
+    std::thread writer_;
+
+    // Output and repeat state, guarded by outputMutex_ (the writer holds it per batch)
+    std::mutex outputMutex_;
+    Options options_;
+    std::ofstream file_;
+    struct Repeat {
+        Clock::time_point windowStart;
+        size_t count = 0;
+        Record last;
+    };
+    std::unordered_map<std::string, Repeat> repeats_;
+    Clock::time_point lastSweep_;
+};
+
+// Collects one line with operator<< and hands it to the logger when destroyed
+class LogLine {
+public:
+    LogLine(LogLevel level, const char* component) : level_(level), component_(component) {}
+    ~LogLine() { Logger::instance().log(level_, component_, stream_.str()); }
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    template <typename T>
+    LogLine& operator<<(const T& value) {
+        stream_ << value;
+        return *this;
+    }
+
+private:
+    LogLevel level_;
+    const char* component_;
+    std::ostringstream stream_;
+};
+
+} // namespace traductor
+
+// TRADUCTOR_LOG(Warning, "engine") << "..."; the operands are not evaluated when the level is off
+#define TRADUCTOR_LOG(level, component)                                              \
+    if (!::traductor::Logger::instance().enabled(::traductor::LogLevel::level)) {    \
+    } else                                                                           \
+        ::traductor::LogLine(::traductor::LogLevel::level, component)
@@ -0,0 +1,188 @@
+#include "MetricsExporter.h"
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace traductor {
+
+namespace {
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void describe(std::ostringstream& out, const std::string& name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+// labels is either empty or `key="value",...` without braces
+void sample(std::ostringstream& out, const std::string& name, const std::string& labels, double value) {
+    out << name;
+    if (!labels.empty()) {
+        out << '{' << labels << '}';
+    }
+    out << ' ' << value << '\n';
+}
+
+// scale converts the series unit to the exported one (ms -> seconds)
+void histogram(std::ostringstream& out, const std::string& name, const std::string& labels,
+               const TranslatorEngine::MetricsSnapshot::Series& series, double scale) {
+    const std::string prefix = labels.empty() ? "" : labels + ",";
+    for (const auto& [bound, count] : series.buckets) {
+        std::ostringstream le;
+        le << bound * scale;
+        sample(out, name + "_bucket", prefix + "le=\"" + le.str() + "\"", static_cast<double>(count));
+    }
+    sample(out, name + "_bucket", prefix + "le=\"+Inf\"", static_cast<double>(series.summary.count));
+    sample(out, name + "_sum", labels, series.summary.sum * scale);
+    sample(out, name + "_count", labels, static_cast<double>(series.summary.count));
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(std::vector<std::string> endpoints)
+    : endpoints_(endpoints.begin(), endpoints.end()) {}
+
+void MetricsExporter::recordRequest(const std::string& endpoint, const std::string& direction, int status) {
+    // Labels come from the client: keep them to a fixed set so series stay bounded
+    const std::string endpointLabel = endpoints_.count(endpoint) ? endpoint : "other";
+    const std::string directionLabel =
+        direction.empty() || TranslatorEngine::validateDirection(direction) ? direction : "invalid";
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_[{endpointLabel, directionLabel, status}]++;
+}
+
+std::string MetricsExporter::render(const TranslatorEngine::HealthInfo& health,
+                                    const TranslatorEngine::MetricsSnapshot& metrics) const {
+    std::ostringstream out;
+    out.precision(12);
+
+    describe(out, "traductor_http_requests_total", "counter", "HTTP responses by endpoint, direction and status.");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, count] : requests_) {
+            const auto& [endpoint, direction, status] = key;
+            sample(out, "traductor_http_requests_total",
+                   "endpoint=\"" + escapeLabel(endpoint) + "\",direction=\"" + escapeLabel(direction) +
+                   "\",status=\"" + std::to_string(status) + "\"",
+                   static_cast<double>(count));
+        }
+    }
+
+    // Latency histograms: end to end, then one labelled series per stage.
+    // Each family's samples follow its own HELP/TYPE lines.
+    describe(out, "traductor_request_duration_seconds", "histogram", "End-to-end translate() latency.");
+    if (const auto* request = metrics.find("request")) {
+        histogram(out, "traductor_request_duration_seconds", "", *request, 0.001);
+    }
+    describe(out, "traductor_stage_duration_seconds", "histogram", "Latency of each translation stage.");
+    for (const auto& series : metrics.series) {
+        if (series.unit == "ms" && series.name != "request") {
+            histogram(out, "traductor_stage_duration_seconds", "stage=\"" + series.name + "\"", series, 0.001);
+        }
+    }
+    if (const auto* batchSize = metrics.find("batch_size")) {
+        describe(out, "traductor_batch_size", "histogram", "Sequences per decoder batch.");
+        histogram(out, "traductor_batch_size", "", *batchSize, 1.0);
+    }
+    if (const auto* rate = metrics.find("tokens_per_second")) {
+        describe(out, "traductor_decode_tokens_per_second", "histogram", "Generated tokens per second of inference, per batch.");
+        histogram(out, "traductor_decode_tokens_per_second", "", *rate, 1.0);
+    }
+
+    describe(out, "traductor_tokens_total", "counter", "Tokens through the decoder.");
+    sample(out, "traductor_tokens_total", "kind=\"source\"", static_cast<double>(health.tokensIn));
+    sample(out, "traductor_tokens_total", "kind=\"generated\"", static_cast<double>(health.tokensOut));
+
+    describe(out, "traductor_queue_depth", "gauge", "Batches waiting in front of each stage.");
+    sample(out, "traductor_queue_depth", "queue=\"preprocess\"", static_cast<double>(health.preprocessQueueDepth));
+    sample(out, "traductor_queue_depth", "queue=\"inference\"", static_cast<double>(health.inferenceQueueDepth));
+    sample(out, "traductor_queue_depth", "queue=\"completion\"", static_cast<double>(health.completionQueueDepth));
+    sample(out, "traductor_queue_depth", "queue=\"replica\"", static_cast<double>(health.replicaQueueDepth));
+    describe(out, "traductor_queued_batches", "gauge", "Batches queued per priority lane.");
+    sample(out, "traductor_queued_batches", "priority=\"interactive\"", static_cast<double>(health.interactiveQueued));
+    sample(out, "traductor_queued_batches", "priority=\"bulk\"", static_cast<double>(health.bulkQueued));
+
+    describe(out, "traductor_cache_hits_total", "counter", "Cache hits per tier.");
+    sample(out, "traductor_cache_hits_total", "tier=\"translation\"", static_cast<double>(health.cacheHits));
+    sample(out, "traductor_cache_hits_total", "tier=\"tokenizer_encode\"", static_cast<double>(health.tokenizerEncodeHits));
+    sample(out, "traductor_cache_hits_total", "tier=\"tokenizer_decode\"", static_cast<double>(health.tokenizerDecodeHits));
+    describe(out, "traductor_cache_misses_total", "counter", "Cache misses per tier.");
+    sample(out, "traductor_cache_misses_total", "tier=\"translation\"", static_cast<double>(health.cacheMisses));
+    sample(out, "traductor_cache_misses_total", "tier=\"tokenizer_encode\"", static_cast<double>(health.tokenizerEncodeMisses));
+    sample(out, "traductor_cache_misses_total", "tier=\"tokenizer_decode\"", static_cast<double>(health.tokenizerDecodeMisses));
+    describe(out, "traductor_cache_entries", "gauge", "Entries in the translation cache.");
+    sample(out, "traductor_cache_entries", "tier=\"translation\"", static_cast<double>(health.cacheSize));
+
+    describe(out, "traductor_replica_utilization", "gauge", "Share of pool uptime each replica was busy.");
+    for (size_t i = 0; i < health.replicas.size(); ++i) {
+        sample(out, "traductor_replica_utilization", "replica=\"" + std::to_string(i) + "\"", health.replicas[i].utilization);
+    }
+    describe(out, "traductor_replica_batches_total", "counter", "Batches run by each replica.");
+    for (size_t i = 0; i < health.replicas.size(); ++i) {
+        sample(out, "traductor_replica_batches_total", "replica=\"" + std::to_string(i) + "\"",
+               static_cast<double>(health.replicas[i].batches));
+    }
+
+    describe(out, "traductor_admission_rejections_total", "counter", "Requests refused by admission control.");
+    sample(out, "traductor_admission_rejections_total", "reason=\"overloaded\"", static_cast<double>(health.admission.rejectedOverloaded));
+    sample(out, "traductor_admission_rejections_total", "reason=\"too_large\"", static_cast<double>(health.admission.rejectedTooLarge));
+    describe(out, "traductor_cancellations_total", "counter", "Requests stopped before completion.");
+    sample(out, "traductor_cancellations_total", "reason=\"cancelled\"", static_cast<double>(health.cancelledRequests));
+    sample(out, "traductor_cancellations_total", "reason=\"deadline_exceeded\"", static_cast<double>(health.deadlineExceeded));
+    describe(out, "traductor_slow_requests_total", "counter", "Requests that took at least slow_request_ms.");
+    sample(out, "traductor_slow_requests_total", "", static_cast<double>(health.slowRequests));
+    describe(out, "traductor_degradation_level", "gauge", "Current load degradation level (0 = full quality).");
+    sample(out, "traductor_degradation_level", "", health.degradationLevel);
+
+    describe(out, "traductor_model_loaded", "gauge", "1 when the CTranslate2 model is loaded.");
+    sample(out, "traductor_model_loaded", "", health.modelLoaded ? 1.0 : 0.0);
+    describe(out, "traductor_model_load_seconds", "gauge", "Time taken to load the model and tokenizer.");
+    sample(out, "traductor_model_load_seconds", "", static_cast<double>(health.loadTime.count()) / 1000.0);
+    describe(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+    sample(out, "process_resident_memory_bytes", "", static_cast<double>(residentMemoryBytes()));
+
+    return out.str();
+}
+
+size_t MetricsExporter::residentMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#elif defined(__linux__)
+    // Second field of statm: resident pages
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+} // namespace traductor
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "TranslatorEngine.h"
+
+namespace traductor {
+
+/**
+ * Prometheus text exposition (format 0.0.4) for the REST /metrics endpoint.
+ * Counts served requests by endpoint, direction and HTTP status, and renders
+ * them together with the engine's HealthInfo and MetricsSnapshot: latency
+ * histograms in seconds, token counters, queue depths, cache tiers, replica
+ * utilization, process RSS and model load time.
+ */
+class MetricsExporter {
+public:
+    // endpoints are the registered routes; other paths are counted as "other"
+    explicit MetricsExporter(std::vector<std::string> endpoints);
+
+    // Thread-safe; called once per response. A direction the engine does not
+    // serve is counted as "invalid"; an empty one (no body) is kept empty.
+    void recordRequest(const std::string& endpoint, const std::string& direction, int status);
+
+    std::string render(const TranslatorEngine::HealthInfo& health,
+                       const TranslatorEngine::MetricsSnapshot& metrics) const;
+
+    // Resident set size of this process in bytes (0 where unsupported)
+    static size_t residentMemoryBytes();
+
+private:
+    const std::set<std::string> endpoints_;
+    mutable std::mutex mutex_;
+    std::map<std::tuple<std::string, std::string, int>, uint64_t> requests_;
+};
+
+} // namespace traductor
@@ -0,0 +1,96 @@
+#include "MockBackend.h"
+#include <algorithm>
+#include <thread>
+
+namespace traductor {
+
+MockBackend::MockBackend() : MockBackend(Options{}) {}
+
+MockBackend::MockBackend(Options options) : options_(options) {}
+
+std::chrono::microseconds MockBackend::expectedLatency(const std::vector<std::vector<int>>& sources,
+                                                       const InferenceBackend::Options& options) const {
+    // Sequences still generating at each step: the longest output sets the step count
+    std::vector<size_t> lengths;
+    lengths.reserve(sources.size());
+    for (const auto& source : sources) {
+        lengths.push_back(std::min(source.size(), options.maxDecodingLength));
+    }
+    std::sort(lengths.begin(), lengths.end());
+
+    const auto beam = static_cast<int64_t>(std::max<size_t>(1, options.beamSize));
+    auto total = options_.batchLatency;
+    size_t step = 0;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        const auto active = static_cast<int64_t>(lengths.size() - i);
+        for (; step < lengths[i]; ++step) {
+            total += (options_.stepLatency + options_.tokenLatency * active) * beam;
+        }
+    }
+    return total;
+}
+
+std::vector<InferenceBackend::Hypothesis> MockBackend::translateBatch(
+    const std::vector<std::vector<int>>& sources,
+    const std::string& /*targetLang*/,
+    const InferenceBackend::Options& options) {
+
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    sequences_.fetch_add(sources.size(), std::memory_order_relaxed);
+    auto deadline = std::chrono::steady_clock::now() + options_.batchLatency;
+
+    std::vector<Hypothesis> hypotheses(sources.size());
+    size_t steps = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        size_t length = std::min(sources[i].size(), options.maxDecodingLength);
+        hypotheses[i].ids.assign(sources[i].begin(), sources[i].begin() + static_cast<std::ptrdiff_t>(length));
+        steps = std::max(steps, length);
+    }
+
+    if (!options.stepCallback) {
+        waitUntil(deadline + expectedLatency(sources, options) - options_.batchLatency);
+    } else {
+        // Step by step, so a stopped sequence no longer costs anything
+        waitUntil(deadline);
+        const auto beam = static_cast<int64_t>(std::max<size_t>(1, options.beamSize));
+        std::vector<bool> stopped(sources.size(), false);
+        for (size_t step = 0; step < steps; ++step) {
+            int64_t active = 0;
+            for (size_t i = 0; i < hypotheses.size(); ++i) {
+                active += !stopped[i] && step < hypotheses[i].ids.size();
+            }
+            if (active == 0) {
+                break;
+            }
+            deadline += (options_.stepLatency + options_.tokenLatency * active) * beam;
+            waitUntil(deadline);
+
+            for (size_t i = 0; i < hypotheses.size(); ++i) {
+                auto& ids = hypotheses[i].ids;
+                if (!stopped[i] && step < ids.size() && options.stepCallback(i, ids[step])) {
+                    ids.resize(step + 1);
+                    stopped[i] = true;
+                }
+            }
+        }
+    }
+
+    if (options.returnScores) {
+        for (auto& hypothesis : hypotheses) {
+            hypothesis.score = options_.tokenLogProb * static_cast<float>(hypothesis.ids.size());
+            hypothesis.hasScore = true;
+        }
+    }
+    return hypotheses;
+}
+
+void MockBackend::waitUntil(std::chrono::steady_clock::time_point deadline) const {
+    if (options_.busyWait) {
+        while (std::chrono::steady_clock::now() < deadline) {
+        }
+    } else {
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+} // namespace traductor
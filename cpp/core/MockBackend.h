@@ -0,0 +1,54 @@
+#pragma once
+
+#include "InferenceBackend.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace traductor {
+
+/**
+ * Deterministic stand-in for the model, for benchmarking and testing the
+ * scheduler, batching and caching without the 600M weights. Each sequence's
+ * output is its source ids (capped at max_decoding_length), so without a
+ * SentencePiece model the translation is the source text. Latency follows a
+ * simple cost model: a fixed cost per call (the encoder), then per decoding
+ * step a fixed cost plus a cost per sequence still generating, scaled by the
+ * beam size. The step callback is honoured, so cancellation and loop guards
+ * work as with the real model.
+ */
+class MockBackend : public InferenceBackend {
+public:
+    struct Options {
+        std::chrono::microseconds batchLatency{0};  // per call
+        std::chrono::microseconds stepLatency{0};   // per decoding step, shared by the batch
+        std::chrono::microseconds tokenLatency{0};  // per token of each sequence still generating
+        float tokenLogProb = -0.1f;                 // score per output token when scores are asked for
+        bool busyWait = false;                      // spin instead of sleeping, to load a core like inference
+    };
+
+    MockBackend();
+    explicit MockBackend(Options options);
+
+    const char* name() const override { return "mock"; }
+
+    std::vector<Hypothesis> translateBatch(const std::vector<std::vector<int>>& sources,
+                                           const std::string& targetLang,
+                                           const InferenceBackend::Options& options) override;
+
+    // Simulated time one call takes when nothing is stopped early
+    std::chrono::microseconds expectedLatency(const std::vector<std::vector<int>>& sources,
+                                              const InferenceBackend::Options& options) const;
+
+    uint64_t calls() const { return calls_.load(std::memory_order_relaxed); }
+    uint64_t sequences() const { return sequences_.load(std::memory_order_relaxed); }
+
+private:
+    void waitUntil(std::chrono::steady_clock::time_point deadline) const;
+
+    Options options_;
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> sequences_{0};
+};
+
+} // namespace traductor
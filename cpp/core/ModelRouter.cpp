@@ -0,0 +1,71 @@
+#include "ModelRouter.h"
+#include "Segmenter.h"
+#include <cctype>
+
+namespace traductor {
+
+ModelRouter::ModelRouter(Options options) : options_(options) {}
+
+double ModelRouter::simplicity(const std::string& text) {
+    if (text.empty()) {
+        return 1.0;
+    }
+    
+    size_t plain = 0;
+    for (unsigned char c : text) {
+        // Bytes >= 0x80 are UTF-8 letters here (á, ñ, æ, ø, å, ...)
+        if (c >= 0x80 || std::isalpha(c) || c == ' ' || c == ',' || c == '.' ||
+            c == '!' || c == '?' || c == '\'' || c == '-') {
+            plain++;
+        }
+    }
+    return static_cast<double>(plain) / static_cast<double>(text.size());
+}
+
+ModelRouter::Model ModelRouter::route(const std::string& sequence) const {
+    if (!active()) {
+        return Model::Large;
+    }
+    
+    // Packed units and glossary placeholders ([[SEG]], [[TERM::..]], [[KEEP::..]])
+    // must survive translation; the large model is far better at that
+    if (sequence.find("[[") != std::string::npos) {
+        return Model::Large;
+    }
+    
+    size_t tokens = Segmenter::estimateTokens(sequence);
+    if (tokens <= options_.maxTokens) {
+        return Model::Small;
+    }
+    if (tokens <= options_.maxSimpleTokens && simplicity(sequence) >= options_.minSimplicity) {
+        return Model::Small;
+    }
+    return Model::Large;
+}
+
+void ModelRouter::record(Model model, size_t sequences, double ms) {
+    Counters& counters = counters_[static_cast<int>(model)];
+    counters.sequences += sequences;
+    counters.batches++;
+    counters.totalUs += static_cast<int64_t>(ms * 1000.0);
+}
+
+void ModelRouter::recordEscalations(size_t sequences) {
+    escalations_ += sequences;
+}
+
+std::vector<ModelRouter::ModelStats> ModelRouter::getStats() const {
+    std::vector<ModelStats> stats(smallAvailable_ ? 2 : 1);
+    for (size_t i = 0; i < stats.size(); ++i) {
+        stats[i].name = i == 0 ? "large" : "small";
+        stats[i].sequences = counters_[i].sequences.load();
+        stats[i].batches = counters_[i].batches.load();
+        stats[i].totalMs = static_cast<double>(counters_[i].totalUs.load()) / 1000.0;
+    }
+    if (stats.size() > 1) {
+        stats[1].escalations = escalations_.load();
+    }
+    return stats;
+}
+
+} // namespace traductor
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Model cascade router. Short or simple sequences (greetings, "Gracias",
+ * sign-offs) go to the small distilled model; long ones, and anything carrying
+ * glossary or packing markers, go to the large model. Small-model hypotheses
+ * whose per-token score falls below minScore are escalated to the large model.
+ */
+class ModelRouter {
+public:
+    enum class Model { Large = 0, Small = 1 };
+    
+    struct Options {
+        bool enabled = false;
+        size_t maxTokens = 12;          // always small up to this many estimated tokens
+        size_t maxSimpleTokens = 32;    // small up to this length if simple enough
+        double minSimplicity = 0.9;     // share of plain letters/spaces/punctuation
+        float minScore = -1.5f;         // per-token log-prob below which we escalate
+    };
+    
+    struct ModelStats {
+        std::string name;
+        size_t sequences = 0;   // sequences decoded by the model
+        size_t batches = 0;
+        double totalMs = 0.0;
+        size_t escalations = 0; // small only: sequences handed on to the large model
+        
+        double avgBatchMs() const { return batches > 0 ? totalMs / static_cast<double>(batches) : 0.0; }
+    };
+    
+    explicit ModelRouter(Options options);
+    
+    // Routing to the small model needs it loaded; until then everything is Large
+    void setSmallModelAvailable(bool available) { smallAvailable_ = available; }
+    bool active() const { return options_.enabled && smallAvailable_; }
+    
+    Model route(const std::string& sequence) const;
+    bool shouldEscalate(float scorePerToken) const { return scorePerToken < options_.minScore; }
+    
+    // Cheap heuristic: 1.0 for plain prose, lower with digits, symbols and markup
+    static double simplicity(const std::string& text);
+    
+    void record(Model model, size_t sequences, double ms);
+    void recordEscalations(size_t sequences);
+    std::vector<ModelStats> getStats() const;
+
+private:
+    struct Counters {
+        std::atomic<size_t> sequences{0};
+        std::atomic<size_t> batches{0};
+        std::atomic<int64_t> totalUs{0};
+    };
+    
+    Options options_;
+    std::atomic<bool> smallAvailable_{false};
+    Counters counters_[2];
+    std::atomic<size_t> escalations_{0};
+};
+
+} // namespace traductor
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace traductor {
+
+// Request priority class: interactive (Qt, REST users) or bulk (batch jobs)
+enum class Priority { Interactive = 0, Bulk = 1 };
+
+inline const char* priorityName(Priority priority) {
+    return priority == Priority::Bulk ? "bulk" : "interactive";
+}
+
+// Empty means interactive; returns false for unknown names
+inline bool parsePriority(const std::string& name, Priority& priority) {
+    if (name.empty() || name == "interactive") {
+        priority = Priority::Interactive;
+        return true;
+    }
+    if (name == "bulk") {
+        priority = Priority::Bulk;
+        return true;
+    }
+    return false;
+}
+
+// Empty leaves the lane unset (the caller's default applies); returns false for unknown names
+inline bool parsePriority(const std::string& name, std::optional<Priority>& priority) {
+    if (name.empty()) {
+        priority.reset();
+        return true;
+    }
+    Priority parsed;
+    if (!parsePriority(name, parsed)) {
+        return false;
+    }
+    priority = parsed;
+    return true;
+}
+
+/**
+ * Blocking two-lane queue: push() waits while the item's lane is full, pop()
+ * waits while both are empty, and after close() push() fails while pop() drains
+ * what is left, then returns nullopt. pop() serves interactive
+ * items first, but while bulk items are waiting at least bulkShare of the pops
+ * go to the bulk lane, so bulk work keeps moving under interactive load.
+ * Each lane has its own capacity, so a full bulk lane never blocks interactive pushes.
+ * A consumer may also serve a single lane with pop(priority), so a consumer
+ * stuck on a slow bulk item never holds back interactive ones.
+ * With a stale-item policy, a push that finds its lane full first removes the
+ * lane's stale items (e.g. of cancelled requests) and hands them to the policy,
+ * so dead work never holds a slot that live work is waiting for.
+ */
+template <typename T>
+class PriorityScheduler {
+public:
+    struct LaneStats {
+        size_t depth = 0;
+        size_t dispatched = 0;
+    };
+
+    PriorityScheduler(size_t laneCapacity, double bulkShare)
+        : capacity_(laneCapacity > 0 ? laneCapacity : 1),
+          bulkEvery_(bulkShare > 0.0 ? std::max<size_t>(1, static_cast<size_t>(1.0 / std::min(bulkShare, 1.0) + 0.5)) : 0) {}
+
+    // Set before the queue is used. drop runs on the pushing thread, without the lock.
+    void setStalePolicy(std::function<bool(const T&)> isStale, std::function<void(T)> drop) {
+        isStale_ = std::move(isStale);
+        drop_ = std::move(drop);
+    }
+
+    bool push(T item, Priority priority) {
+        Lane& lane = lanes_[static_cast<size_t>(priority)];
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!closed_ && lane.items.size() >= capacity_) {
+            if (!isStale_) {
+                lane.notFull.wait(lock);
+                continue;
+            }
+            auto stale = takeStale(lane);
+            if (stale.empty()) {
+                // Items can go stale while we wait (deadlines), so look again now and then
+                lane.notFull.wait_for(lock, kStaleSweepInterval);
+                continue;
+            }
+            lock.unlock();
+            for (auto& staleItem : stale) {
+                drop_(std::move(staleItem));
+            }
+            lock.lock();
+        }
+        if (closed_) {
+            return false;
+        }
+        lane.items.push_back(std::move(item));
+        lock.unlock();
+        notEmpty_.notify_one();
+        lane.notEmpty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !empty(); });
+        if (empty()) {
+            return std::nullopt;
+        }
+
+        Lane& lane = lanes_[static_cast<size_t>(nextLane())];
+        T item = std::move(lane.items.front());
+        lane.items.pop_front();
+        lane.dispatched++;
+        lock.unlock();
+        lane.notFull.notify_one();
+        return item;
+    }
+
+    // Pop from one lane only; the lane's items stay in FIFO order
+    std::optional<T> pop(Priority priority) {
+        Lane& lane = lanes_[static_cast<size_t>(priority)];
+        std::unique_lock<std::mutex> lock(mutex_);
+        lane.notEmpty.wait(lock, [this, &lane] { return closed_ || !lane.items.empty(); });
+        if (lane.items.empty()) {
+            return std::nullopt;
+        }
+
+        T item = std::move(lane.items.front());
+        lane.items.pop_front();
+        lane.dispatched++;
+        lock.unlock();
+        lane.notFull.notify_one();
+        return item;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        for (auto& lane : lanes_) {
+            lane.notFull.notify_all();
+            lane.notEmpty.notify_all();
+        }
+        notEmpty_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lanes_[0].items.size() + lanes_[1].items.size();
+    }
+
+    LaneStats laneStats(Priority priority) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Lane& lane = lanes_[static_cast<size_t>(priority)];
+        return {lane.items.size(), lane.dispatched};
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr std::chrono::milliseconds kStaleSweepInterval{20};
+
+    struct Lane {
+        std::deque<T> items;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;  // for single-lane consumers
+        size_t dispatched = 0;
+    };
+
+    const size_t capacity_;
+    const size_t bulkEvery_;  // one bulk pop in this many while both lanes wait (0 = strict priority)
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::array<Lane, 2> lanes_;
+    size_t interactiveStreak_ = 0;
+    bool closed_ = false;
+    std::function<bool(const T&)> isStale_;
+    std::function<void(T)> drop_;
+
+    bool empty() const { return lanes_[0].items.empty() && lanes_[1].items.empty(); }
+
+    // Caller holds mutex_
+    std::vector<T> takeStale(Lane& lane) {
+        std::vector<T> stale;
+        for (auto it = lane.items.begin(); it != lane.items.end();) {
+            if (isStale_(*it)) {
+                stale.push_back(std::move(*it));
+                it = lane.items.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return stale;
+    }
+
+    // Caller holds mutex_ and at least one lane is non-empty
+    Priority nextLane() {
+        if (lanes_[1].items.empty()) {
+            interactiveStreak_ = 0;
+            return Priority::Interactive;
+        }
+        if (lanes_[0].items.empty() || (bulkEvery_ > 0 && interactiveStreak_ + 1 >= bulkEvery_)) {
+            interactiveStreak_ = 0;
+            return Priority::Bulk;
+        }
+        interactiveStreak_++;
+        return Priority::Interactive;
+    }
+};
+
+} // namespace traductor
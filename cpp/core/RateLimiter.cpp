@@ -0,0 +1,137 @@
+#include "RateLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace traductor {
+
+RateLimiter::RateLimiter(Options options) : options_(options) {
+    options_.textsPerSecond = std::max(options_.textsPerSecond, 1e-3);
+    options_.tokensPerSecond = std::max(options_.tokensPerSecond, 1e-3);
+    options_.textsBurst = std::max(options_.textsBurst, 1.0);
+    options_.tokensBurst = std::max(options_.tokensBurst, 1.0);
+}
+
+void RateLimiter::Bucket::refill(double rate, double burst, double seconds) {
+    level = std::min(burst, level + rate * seconds);
+}
+
+double RateLimiter::Bucket::waitFor(double cost, double rate, double burst) const {
+    double needed = std::min(cost, burst);
+    return level >= needed ? 0.0 : (needed - level) / rate;
+}
+
+RateLimiter::Decision RateLimiter::admit(const std::string& client, size_t texts, size_t tokens,
+                                         Clock::time_point now) {
+    Decision decision;
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (++admitsSinceSweep_ >= 1024) {
+        admitsSinceSweep_ = 0;
+        evictIdle(now);
+    }
+    
+    Client& state = clientFor(client, now);
+    state.lastSeen = now;
+    if (options_.enabled) {
+        refill(state, now);
+        double wait = std::max(
+            state.texts.waitFor(static_cast<double>(texts), options_.textsPerSecond, options_.textsBurst),
+            state.tokens.waitFor(static_cast<double>(tokens), options_.tokensPerSecond, options_.tokensBurst));
+        if (wait > 0.0) {
+            state.rejected++;
+            decision.allowed = false;
+            decision.retryAfterSeconds = std::max(1, static_cast<int>(std::ceil(wait)));
+            return decision;
+        }
+        state.texts.level -= static_cast<double>(texts);
+        state.tokens.level -= static_cast<double>(tokens);
+    }
+    
+    state.requests++;
+    state.textCount += texts;
+    state.tokenCount += tokens;
+    return decision;
+}
+
+void RateLimiter::refund(const std::string& client, size_t texts, size_t tokens, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(client);
+    if (it == clients_.end()) {
+        return;
+    }
+    Client& state = it->second;
+    if (options_.enabled) {
+        refill(state, now);
+        state.texts.level = std::min(options_.textsBurst, state.texts.level + static_cast<double>(texts));
+        state.tokens.level = std::min(options_.tokensBurst, state.tokens.level + static_cast<double>(tokens));
+    }
+    state.requests -= std::min(state.requests, size_t{1});
+    state.textCount -= std::min(state.textCount, texts);
+    state.tokenCount -= std::min(state.tokenCount, tokens);
+}
+
+std::vector<RateLimiter::ClientStats> RateLimiter::getClientStats(Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<ClientStats> stats;
+    stats.reserve(clients_.size());
+    for (auto& [name, state] : clients_) {
+        refill(state, now);
+        ClientStats s;
+        s.client = name;
+        s.requests = state.requests;
+        s.rejected = state.rejected;
+        s.texts = state.textCount;
+        s.tokens = state.tokenCount;
+        s.textsAvailable = state.texts.level;
+        s.tokensAvailable = state.tokens.level;
+        stats.push_back(std::move(s));
+    }
+    
+    // Heaviest users first
+    std::sort(stats.begin(), stats.end(), [](const ClientStats& a, const ClientStats& b) {
+        return a.tokens != b.tokens ? a.tokens > b.tokens : a.client < b.client;
+    });
+    return stats;
+}
+
+RateLimiter::Client& RateLimiter::clientFor(const std::string& client, Clock::time_point now) {
+    auto it = clients_.find(client);
+    if (it == clients_.end()) {
+        // New clients start with full buckets
+        Client state;
+        state.texts.level = options_.textsBurst;
+        state.tokens.level = options_.tokensBurst;
+        state.lastRefill = now;
+        it = clients_.emplace(client, state).first;
+    }
+    return it->second;
+}
+
+void RateLimiter::refill(Client& client, Clock::time_point now) const {
+    double seconds = std::chrono::duration<double>(now - client.lastRefill).count();
+    if (seconds <= 0.0) {
+        return;
+    }
+    client.texts.refill(options_.textsPerSecond, options_.textsBurst, seconds);
+    client.tokens.refill(options_.tokensPerSecond, options_.tokensBurst, seconds);
+    client.lastRefill = now;
+}
+
+void RateLimiter::evictIdle(Clock::time_point now) {
+    for (auto it = clients_.begin(); it != clients_.end();) {
+        Client& state = it->second;
+        bool idle = now - state.lastSeen > options_.idleEviction;
+        if (idle) {
+            refill(state, now);
+        }
+        // Only clients whose buckets are full again: evicting them changes no decision
+        if (idle && state.texts.level >= options_.textsBurst && state.tokens.level >= options_.tokensBurst) {
+            it = clients_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace traductor
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Per-client token-bucket limits on texts/s and tokens/s, with usage counters.
+ * A request is admitted when both buckets hold its cost; a request larger than
+ * a bucket's burst is admitted from a full bucket and leaves it in debt, so
+ * oversize requests are slowed down rather than refused forever.
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Options {
+        bool enabled = false;
+        double textsPerSecond = 20.0;
+        double textsBurst = 100.0;
+        double tokensPerSecond = 2000.0;
+        double tokensBurst = 10000.0;
+        std::chrono::seconds idleEviction{600};  // forget idle clients with full buckets
+    };
+    
+    struct Decision {
+        bool allowed = true;
+        int retryAfterSeconds = 0;  // for the Retry-After header when refused
+    };
+    
+    struct ClientStats {
+        std::string client;
+        size_t requests = 0;   // admitted
+        size_t rejected = 0;
+        size_t texts = 0;
+        size_t tokens = 0;
+        double textsAvailable = 0.0;
+        double tokensAvailable = 0.0;
+    };
+    
+    explicit RateLimiter(Options options);
+    
+    Decision admit(const std::string& client, size_t texts, size_t tokens, Clock::time_point now = Clock::now());
+    // Undo an admitted request that was refused further on (e.g. by admission control)
+    void refund(const std::string& client, size_t texts, size_t tokens, Clock::time_point now = Clock::now());
+    std::vector<ClientStats> getClientStats(Clock::time_point now = Clock::now()) const;
+    bool enabled() const { return options_.enabled; }
+
+private:
+    struct Bucket {
+        double level = 0.0;
+        
+        void refill(double rate, double burst, double seconds);
+        // Seconds until the bucket can pay cost (capped at burst); 0 if it already can
+        double waitFor(double cost, double rate, double burst) const;
+    };
+    
+    struct Client {
+        Bucket texts;
+        Bucket tokens;
+        Clock::time_point lastRefill;
+        Clock::time_point lastSeen;
+        size_t requests = 0;
+        size_t rejected = 0;
+        size_t textCount = 0;
+        size_t tokenCount = 0;
+    };
+    
+    Options options_;
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, Client> clients_;
+    size_t admitsSinceSweep_ = 0;
+    
+    Client& clientFor(const std::string& client, Clock::time_point now);
+    void refill(Client& client, Clock::time_point now) const;
+    void evictIdle(Clock::time_point now);
+};
+
+} // namespace traductor
@@ -0,0 +1,59 @@
+#include "RepetitionDetector.h"
+#include <algorithm>
+
+namespace traductor {
+
+RepetitionDetector::RepetitionDetector(size_t maxNgram, size_t maxRepeats)
+    : maxNgram_(std::max<size_t>(1, maxNgram)),
+      maxRepeats_(std::max<size_t>(2, maxRepeats)) {}
+
+bool RepetitionDetector::push(int token) {
+    tokens_.push_back(token);
+    if (looping_) {
+        return true;
+    }
+    
+    for (size_t n = 1; n <= maxNgram_; ++n) {
+        if (repeatsAt(tokens_, tokens_.size(), n, maxRepeats_)) {
+            looping_ = true;
+            break;
+        }
+    }
+    return looping_;
+}
+
+void RepetitionDetector::reset() {
+    tokens_.clear();
+    looping_ = false;
+}
+
+size_t RepetitionDetector::findLoop(const std::vector<int>& ids, size_t maxNgram, size_t maxRepeats) {
+    maxNgram = std::max<size_t>(1, maxNgram);
+    maxRepeats = std::max<size_t>(2, maxRepeats);
+    
+    // Earliest window end wins, so the kept prefix holds a single copy
+    for (size_t end = 1; end <= ids.size(); ++end) {
+        for (size_t n = 1; n <= maxNgram; ++n) {
+            if (repeatsAt(ids, end, n, maxRepeats)) {
+                return end - n * (maxRepeats - 1);
+            }
+        }
+    }
+    return ids.size();
+}
+
+bool RepetitionDetector::repeatsAt(const std::vector<int>& ids, size_t end, size_t n, size_t repeats) {
+    if (end < n * repeats) {
+        return false;
+    }
+    
+    size_t start = end - n * repeats;
+    for (size_t i = start + n; i < end; ++i) {
+        if (ids[i] != ids[i - n]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace traductor
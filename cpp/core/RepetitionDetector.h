@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Detects runaway generation ("de de de de ...") in decoder output.
+ * A loop is any n-gram (n <= maxNgram) repeated maxRepeats times in a row.
+ * push() checks the tail after every token, so it can drive the decoder's
+ * step callback; findLoop() scans a finished hypothesis.
+ */
+class RepetitionDetector {
+public:
+    RepetitionDetector(size_t maxNgram, size_t maxRepeats);
+    
+    // Append one generated token; true once the output ends in a loop
+    bool push(int token);
+    bool looping() const { return looping_; }
+    void reset();
+    
+    // Index just past the first copy of the looping n-gram, or ids.size() if none
+    static size_t findLoop(const std::vector<int>& ids, size_t maxNgram, size_t maxRepeats);
+
+private:
+    size_t maxNgram_;
+    size_t maxRepeats_;
+    std::vector<int> tokens_;
+    bool looping_ = false;
+    
+    // True if the n-gram ending at end repeats maxRepeats times back to back
+    static bool repeatsAt(const std::vector<int>& ids, size_t end, size_t n, size_t repeats);
+};
+
+} // namespace traductor
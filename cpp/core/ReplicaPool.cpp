@@ -0,0 +1,145 @@
+#include "ReplicaPool.h"
+#include "CpuInfo.h"
+#include <stdexcept>
+
+namespace traductor {
+
+ReplicaPool::ReplicaPool(const Options& options, ReplicaInit init)
+    : options_(options), init_(std::move(init)), queue_(options.queueCapacity, options.bulkShare) {
+    if (options_.replicas == 0) {
+        options_.replicas = 1;
+    }
+    if (options_.threadsPerReplica == 0) {
+        options_.threadsPerReplica = 1;
+    }
+    
+    auto cores = plannedCores(options_);
+    for (size_t i = 0; i < options_.replicas; ++i) {
+        auto replica = std::make_unique<Replica>();
+        if (!cores.empty()) {
+            auto first = cores.begin() + static_cast<std::ptrdiff_t>(i * options_.threadsPerReplica);
+            replica->cores.assign(first, first + static_cast<std::ptrdiff_t>(options_.threadsPerReplica));
+            replica->numaNode = CpuInfo::numaNodeOfCore(replica->cores.front());
+        }
+        replicas_.push_back(std::move(replica));
+    }
+}
+
+ReplicaPool::~ReplicaPool() {
+    queue_.close();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::vector<int> ReplicaPool::plannedCores(const Options& options) {
+    std::vector<int> cores;
+    if (!options.pinCores) {
+        return cores;
+    }
+    
+    // Consecutive blocks of threadsPerReplica cores, wrapping if oversubscribed
+    const int available = CpuInfo::logicalCores();
+    const size_t total = options.replicas * options.threadsPerReplica;
+    cores.reserve(total);
+    for (size_t i = 0; i < total; ++i) {
+        cores.push_back(static_cast<int>((options.coreOffset + static_cast<int>(i)) % available));
+    }
+    return cores;
+}
+
+bool ReplicaPool::start(std::string& error) {
+    startTime_ = std::chrono::steady_clock::now();
+    
+    std::vector<std::future<void>> ready;
+    for (size_t i = 0; i < replicas_.size(); ++i) {
+        std::promise<void> promise;
+        ready.push_back(promise.get_future());
+        workers_.emplace_back(&ReplicaPool::workerLoop, this, i, std::move(promise));
+    }
+    
+    bool ok = true;
+    for (auto& future : ready) {
+        try {
+            future.get();
+        } catch (const std::exception& e) {
+            if (ok) {
+                error = e.what();
+            }
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+std::future<void> ReplicaPool::submit(Job job, Priority priority) {
+    Task task;
+    task.job = std::move(job);
+    auto future = task.done.get_future();
+    if (!queue_.push(std::move(task), priority)) {
+        std::promise<void> rejected;
+        rejected.set_exception(std::make_exception_ptr(std::runtime_error("Replica pool is shutting down")));
+        return rejected.get_future();
+    }
+    return future;
+}
+
+std::vector<ReplicaPool::ReplicaStats> ReplicaPool::getStats() const {
+    double uptimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime_).count();
+    
+    std::vector<ReplicaStats> stats;
+    stats.reserve(replicas_.size());
+    for (const auto& replica : replicas_) {
+        ReplicaStats s;
+        s.cores = replica->cores;
+        s.numaNode = replica->numaNode;
+        s.batches = replica->batches.load();
+        s.busyMs = static_cast<double>(replica->busyNs.load()) / 1e6;
+        s.utilization = uptimeMs > 0 ? s.busyMs / uptimeMs : 0.0;
+        stats.push_back(std::move(s));
+    }
+    return stats;
+}
+
+void ReplicaPool::workerLoop(size_t index, std::promise<void> ready) {
+    Replica& replica = *replicas_[index];
+    
+    // Pin before building the replica so its allocations land on the local node
+    if (!replica.cores.empty()) {
+        CpuInfo::pinCurrentThread(replica.cores);
+    }
+    
+    try {
+        init_(index);
+        ready.set_value();
+    } catch (...) {
+        ready.set_exception(std::current_exception());
+        return;
+    }
+    
+    while (auto task = queue_.pop()) {
+        auto begin = std::chrono::steady_clock::now();
+        std::exception_ptr failure;
+        try {
+            task->job(index);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        
+        // Account before waking the waiter, so stats never lag completed work
+        replica.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+        replica.batches++;
+        
+        if (failure) {
+            task->done.set_exception(failure);
+        } else {
+            task->done.set_value();
+        }
+    }
+}
+
+} // namespace traductor
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PriorityScheduler.h"
+
+namespace traductor {
+
+/**
+ * Engine-managed pool of model replicas, one worker thread each.
+ * Workers are optionally pinned to their own block of cores and build their
+ * replica on that thread, so the model weights are first touched (and thus
+ * allocated) on the replica's NUMA node. A shared two-lane queue feeds them:
+ * a free replica takes the next interactive batch before any bulk batch, so
+ * interactive work pre-empts bulk work between batches, never inside one.
+ */
+class ReplicaPool {
+public:
+    struct Options {
+        size_t replicas = 1;
+        size_t threadsPerReplica = 1;
+        bool pinCores = false;
+        int coreOffset = 0;
+        size_t queueCapacity = 8;  // per priority lane
+        double bulkShare = 0.2;    // minimum share of bulk jobs while both lanes wait
+    };
+    
+    struct ReplicaStats {
+        std::vector<int> cores;
+        int numaNode = 0;
+        size_t batches = 0;
+        double busyMs = 0.0;
+        double utilization = 0.0;  // busy time / pool uptime
+    };
+    
+    // Called once on each worker thread (after pinning) to build replica i
+    using ReplicaInit = std::function<void(size_t replica)>;
+    // Runs on a worker thread with the index of the replica to use
+    using Job = std::function<void(size_t replica)>;
+    
+    ReplicaPool(const Options& options, ReplicaInit init);
+    ~ReplicaPool();
+    
+    ReplicaPool(const ReplicaPool&) = delete;
+    ReplicaPool& operator=(const ReplicaPool&) = delete;
+    
+    // Start the workers and wait until every replica is built.
+    // Returns false (with the reason in error) if any replica failed.
+    bool start(std::string& error);
+    
+    // Queue a job; blocks while its priority lane is full
+    std::future<void> submit(Job job, Priority priority = Priority::Interactive);
+    
+    size_t size() const { return options_.replicas; }
+    size_t queueDepth() const { return queue_.size(); }
+    size_t laneDepth(Priority priority) const { return queue_.laneStats(priority).depth; }
+    std::vector<ReplicaStats> getStats() const;
+    
+    // Cores the replicas will be pinned to (empty when pinning is off)
+    static std::vector<int> plannedCores(const Options& options);
+
+private:
+    struct Task {
+        Job job;
+        std::promise<void> done;
+    };
+    
+    struct Replica {
+        std::vector<int> cores;
+        int numaNode = 0;
+        std::atomic<size_t> batches{0};
+        std::atomic<int64_t> busyNs{0};
+    };
+    
+    Options options_;
+    ReplicaInit init_;
+    PriorityScheduler<Task> queue_;
+    std::vector<std::unique_ptr<Replica>> replicas_;
+    std::vector<std::thread> workers_;
+    std::chrono::steady_clock::time_point startTime_;
+    
+    void workerLoop(size_t index, std::promise<void> ready);
+};
+
+} // namespace traductor
@@ -0,0 +1,96 @@
+#include "SegmentStream.h"
+#include "Segmenter.h"
+#include <algorithm>
+#include <cctype>
+
+namespace traductor {
+
+namespace {
+
+bool isBlank(const std::string& line) {
+    return std::all_of(line.begin(), line.end(),
+                       [](unsigned char c) { return std::isspace(c); });
+}
+
+} // namespace
+
+SegmentStream::SegmentStream(std::istream& input, const Segmenter& segmenter, size_t maxParagraphChars)
+    : input_(&input),
+      segmenter_(segmenter),
+      maxParagraphChars_(maxParagraphChars > 0 ? maxParagraphChars : 16 * segmenter.getMaxSegmentChars()) {}
+
+SegmentStream::SegmentStream(std::string_view buffer, const Segmenter& segmenter, size_t maxParagraphChars)
+    : buffer_(buffer),
+      segmenter_(segmenter),
+      maxParagraphChars_(maxParagraphChars > 0 ? maxParagraphChars : 16 * segmenter.getMaxSegmentChars()) {}
+
+bool SegmentStream::next(Segment& segment) {
+    while (pending_.empty()) {
+        if (exhausted_ || !fillPending()) {
+            return false;
+        }
+    }
+
+    segment = std::move(pending_.front());
+    pending_.pop_front();
+    return true;
+}
+
+bool SegmentStream::readLine(std::string& line) {
+    if (input_) {
+        if (!std::getline(*input_, line)) {
+            return false;
+        }
+        bytesConsumed_ += line.size() + 1;
+        return true;
+    }
+
+    if (bufferPos_ >= buffer_.size()) {
+        return false;
+    }
+    size_t end = buffer_.find('\n', bufferPos_);
+    if (end == std::string_view::npos) {
+        end = buffer_.size();
+    }
+    line.assign(buffer_.substr(bufferPos_, end - bufferPos_));
+    bytesConsumed_ += end - bufferPos_ + 1;
+    bufferPos_ = end + 1;
+    return true;
+}
+
+bool SegmentStream::fillPending() {
+    std::string paragraph;
+    std::string line;
+    bool sawText = false;
+
+    // Collect lines up to a blank line, or until the paragraph budget is spent
+    while (readLine(line)) {
+        if (isBlank(line)) {
+            if (sawText) break;
+            continue;
+        }
+        if (!paragraph.empty()) paragraph += "\n";
+        paragraph += line;
+        sawText = true;
+
+        if (paragraph.length() >= maxParagraphChars_) break;
+    }
+
+    if (!sawText) {
+        exhausted_ = true;
+        return false;
+    }
+
+    auto segments = segmenter_.segment(paragraph);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].empty()) continue;
+        pending_.push_back({std::move(segments[i]), paragraphIndex_, false});
+    }
+    if (!pending_.empty()) {
+        pending_.back().endsParagraph = true;
+    }
+    paragraphIndex_++;
+    return true;
+}
+
+} // namespace traductor
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <deque>
+
+namespace traductor {
+
+class Segmenter;
+
+/**
+ * Pull-based segment generator for huge documents.
+ * Reads an input stream (or an already mapped buffer) one paragraph at a time
+ * and hands out segments lazily, so memory stays bounded by the paragraph size.
+ */
+class SegmentStream {
+public:
+    struct Segment {
+        std::string text;
+        size_t paragraphIndex = 0;
+        bool endsParagraph = false;
+    };
+
+    // maxParagraphChars = 0 uses 16 x the segmenter's maxSegmentChars
+    SegmentStream(std::istream& input, const Segmenter& segmenter, size_t maxParagraphChars = 0);
+    SegmentStream(std::string_view buffer, const Segmenter& segmenter, size_t maxParagraphChars = 0);
+    ~SegmentStream() = default;
+
+    // Fetch the next segment; returns false once the input is exhausted
+    bool next(Segment& segment);
+
+    // Progress
+    size_t bytesConsumed() const { return bytesConsumed_; }
+    size_t paragraphsRead() const { return paragraphIndex_; }
+
+private:
+    std::istream* input_ = nullptr;
+    std::string_view buffer_;
+    size_t bufferPos_ = 0;
+    const Segmenter& segmenter_;
+    size_t maxParagraphChars_;
+
+    std::deque<Segment> pending_;
+    size_t paragraphIndex_ = 0;
+    size_t bytesConsumed_ = 0;
+    bool exhausted_ = false;
+
+    // Read one line from the stream or buffer (without the trailing newline)
+    bool readLine(std::string& line);
+
+    // Read the next paragraph and queue its segments
+    bool fillPending();
+};
+
+} // namespace traductor
@@ -86,6 +86,88 @@ std::string Segmenter::rejoinSegments(const std::vector<std::string>& segments)
     return oss.str();
 }
 
+std::vector<Segmenter::PackedSegment> Segmenter::pack(const std::vector<std::string>& units) const {
+    std::vector<PackedSegment> packed;
+    packed.reserve(units.size());
+    
+    if (!packing_.enabled) {
+        for (const auto& unit : units) {
+            packed.push_back({unit, 1});
+        }
+        return packed;
+    }
+    
+    const std::string separator = std::string(" ") + kPackMarker + " ";
+    const size_t markerTokens = estimateTokens(separator);
+    
+    PackedSegment current;
+    size_t currentTokens = 0;
+    bool open = false;
+    
+    for (const auto& unit : units) {
+        size_t unitTokens = estimateTokens(unit);
+        bool isShort = unitTokens <= packing_.maxUnitTokens;
+        
+        // Close the open group if this unit cannot join it
+        if (open && (!isShort ||
+                     currentTokens + markerTokens + unitTokens > packing_.targetTokens ||
+                     current.text.length() + separator.length() + unit.length() > maxSegmentChars_)) {
+            packed.push_back(std::move(current));
+            current = PackedSegment{};
+            currentTokens = 0;
+            open = false;
+        }
+        
+        if (!isShort) {
+            packed.push_back({unit, 1});
+            continue;
+        }
+        
+        if (open) {
+            current.text += separator + unit;
+            current.unitCount++;
+            currentTokens += markerTokens + unitTokens;
+        } else {
+            current = PackedSegment{unit, 1};
+            currentTokens = unitTokens;
+            open = true;
+        }
+    }
+    
+    if (open) {
+        packed.push_back(std::move(current));
+    }
+    
+    return packed;
+}
+
+std::vector<std::string> Segmenter::unpack(const std::string& translated, size_t unitCount) const {
+    if (unitCount <= 1) {
+        return {translated};
+    }
+    
+    // The model may add or drop spaces around the marker, so match it loosely
+    static const std::regex markerRegex(R"(\s*\[\[\s*SEG\s*\]\]\s*)");
+    std::sregex_token_iterator iter(translated.begin(), translated.end(), markerRegex, -1);
+    std::sregex_token_iterator end;
+    
+    std::vector<std::string> units;
+    units.reserve(unitCount);
+    for (; iter != end; ++iter) {
+        units.push_back(std::regex_replace(iter->str(), std::regex(R"(^\s+|\s+$)"), ""));
+    }
+    
+    if (units.size() != unitCount) {
+        return {};
+    }
+    
+    return units;
+}
+
+size_t Segmenter::estimateTokens(const std::string& text) {
+    return (text.length() + 3) / 4;
+}
+
 std::vector<std::string> Segmenter::splitByParagraphs(const std::string& text) const {
     std::vector<std::string> paragraphs;
     
@@ -11,6 +11,22 @@ namespace traductor {
  */
 class Segmenter {
 public:
+    // Packing of adjacent short units into a single decoder sequence
+    struct PackingOptions {
+        bool enabled = false;
+        size_t targetTokens = 64;    // Stop packing once this estimated length is reached
+        size_t maxUnitTokens = 16;   // Only units up to this estimated length are packed
+    };
+    
+    // Several short units translated together; unitCount markers-1 separate them
+    struct PackedSegment {
+        std::string text;
+        size_t unitCount = 1;
+    };
+    
+    // Boundary marker placed between packed units (same [[...]] family as Glossary)
+    static constexpr const char* kPackMarker = "[[SEG]]";
+
     explicit Segmenter(size_t maxSegmentChars = 800);
     ~Segmenter() = default;
 
@@ -26,9 +42,24 @@ public:
     // Configure segment size
     void setMaxSegmentChars(size_t maxChars) { maxSegmentChars_ = maxChars; }
     size_t getMaxSegmentChars() const { return maxSegmentChars_; }
+    
+    // Merge adjacent short units up to the target token length
+    std::vector<PackedSegment> pack(const std::vector<std::string>& units) const;
+    
+    // Split a translated packed segment back into its units.
+    // Returns an empty vector if the markers did not survive translation.
+    std::vector<std::string> unpack(const std::string& translated, size_t unitCount) const;
+    
+    // Configure packing
+    void setPackingOptions(const PackingOptions& options) { packing_ = options; }
+    const PackingOptions& getPackingOptions() const { return packing_; }
+    
+    // Cheap token estimate used for packing decisions (~4 bytes per SentencePiece token)
+    static size_t estimateTokens(const std::string& text);
 
 private:
     size_t maxSegmentChars_;
+    PackingOptions packing_;
     
     // Helper methods
     std::vector<std::string> splitByParagraphs(const std::string& text) const;
@@ -0,0 +1,137 @@
+#include "SlowRequestLog.h"
+#include "Logger.h"
+
+namespace traductor {
+
+const char* SlowRequestLog::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::CacheLookup: return "cache_lookup";
+        case Stage::Glossary: return "glossary";
+        case Stage::Segmentation: return "segmentation";
+        case Stage::Tokenization: return "tokenization";
+        case Stage::QueueWait: return "queue_wait";
+        case Stage::Inference: return "inference";
+        case Stage::Detokenization: return "detokenization";
+        case Stage::Postprocessing: return "postprocessing";
+        case Stage::Count: break;
+    }
+    return "unknown";
+}
+
+void SlowRequestLog::Breakdown::addStage(Stage stage, std::chrono::steady_clock::duration elapsed) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    stageMicros_[static_cast<size_t>(stage)].fetch_add(us > 0 ? static_cast<uint64_t>(us) : 0,
+                                                        std::memory_order_relaxed);
+}
+
+void SlowRequestLog::Breakdown::addTokens(size_t in, size_t out) {
+    tokensIn_.fetch_add(in, std::memory_order_relaxed);
+    tokensOut_.fetch_add(out, std::memory_order_relaxed);
+}
+
+void SlowRequestLog::Breakdown::addBatch(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(id);
+}
+
+std::array<double, SlowRequestLog::kStages> SlowRequestLog::Breakdown::stageMs() const {
+    std::array<double, kStages> ms{};
+    for (size_t i = 0; i < kStages; ++i) {
+        ms[i] = static_cast<double>(stageMicros_[i].load(std::memory_order_relaxed)) / 1000.0;
+    }
+    return ms;
+}
+
+std::vector<uint64_t> SlowRequestLog::Breakdown::batches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_;
+}
+
+SlowRequestLog::SlowRequestLog(const Options& options) : options_(options) {}
+
+bool SlowRequestLog::record(Entry entry) {
+    if (!enabled() || entry.latencyMs < options_.thresholdMs) {
+        return false;
+    }
+    if (!options_.logText) {
+        entry.text.clear();
+    }
+    total_.fetch_add(1, std::memory_order_relaxed);
+
+    // One line per request so log shippers keep it whole; logged text may be
+    // invalid UTF-8, which is replaced rather than thrown on
+    TRADUCTOR_LOG(Warning, "slow_request")
+        << toJson(entry).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_front(std::move(entry));
+    while (entries_.size() > options_.capacity) {
+        entries_.pop_back();
+    }
+    return true;
+}
+
+std::vector<SlowRequestLog::Entry> SlowRequestLog::recent() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<Entry>(entries_.begin(), entries_.end());
+}
+
+nlohmann::json SlowRequestLog::toJson(const Entry& entry) {
+    nlohmann::json json;
+    json["timestamp_ms"] = entry.timestampMs;
+    json["latency_ms"] = entry.latencyMs;
+    json["direction"] = entry.direction;
+    json["profile"] = entry.profile;
+    json["priority"] = entry.priority;
+    json["outcome"] = entry.outcome;
+    json["texts"] = entry.texts;
+    json["input_bytes"] = entry.inputBytes;
+    json["segments"] = entry.segments;
+    json["cache_hits"] = entry.cacheHits;
+    json["tokens_in"] = entry.tokensIn;
+    json["tokens_out"] = entry.tokensOut;
+    json["batches"] = entry.batches;
+    for (size_t i = 0; i < kStages; ++i) {
+        json["stages_ms"][stageName(static_cast<Stage>(i))] = entry.stageMs[i];
+    }
+    if (entry.traceId != 0) {
+        json["trace_id"] = entry.traceId;
+    }
+    if (entry.text.empty()) {
+        json["text"] = "[redacted]";
+    } else {
+        json["text"] = entry.text;
+    }
+    return json;
+}
+
+nlohmann::json SlowRequestLog::toJson() const {
+    nlohmann::json json;
+    json["threshold_ms"] = options_.thresholdMs;
+    json["total"] = total();
+    json["text_logged"] = options_.logText;
+    json["requests"] = nlohmann::json::array();
+    for (const auto& entry : recent()) {
+        json["requests"].push_back(toJson(entry));
+    }
+    return json;
+}
+
+std::vector<std::string> SlowRequestLog::excerpt(const std::vector<std::string>& texts, size_t maxBytes) {
+    std::vector<std::string> excerpts;
+    excerpts.reserve(texts.size());
+    for (const auto& text : texts) {
+        if (text.size() <= maxBytes) {
+            excerpts.push_back(text);
+            continue;
+        }
+        size_t cut = maxBytes;
+        while (cut > 0 && (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80) {
+            cut--;
+        }
+        excerpts.push_back(text.substr(0, cut) + "...");
+    }
+    return excerpts;
+}
+
+} // namespace traductor
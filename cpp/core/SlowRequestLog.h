@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace traductor {
+
+/**
+ * Slow-request log. Requests that take at least the threshold are written to
+ * stderr as one structured JSON line and kept in a ring buffer of the last N,
+ * served at /debug/slow. Each entry carries the request's size, segment and
+ * token counts, cache hits, the pipeline batches it ran in and its time per
+ * stage. Source text is redacted unless logging it is explicitly enabled.
+ */
+class SlowRequestLog {
+public:
+    enum class Stage {
+        CacheLookup,
+        Glossary,
+        Segmentation,
+        Tokenization,
+        QueueWait,
+        Inference,
+        Detokenization,
+        Postprocessing,
+        Count
+    };
+    static constexpr size_t kStages = static_cast<size_t>(Stage::Count);
+    static const char* stageName(Stage stage);
+
+    // Collected while a request runs. Its batches may run concurrently, so stage
+    // times are summed over batches and can add up to more than the wall time.
+    class Breakdown {
+    public:
+        void addStage(Stage stage, std::chrono::steady_clock::duration elapsed);
+        void addTokens(size_t in, size_t out);
+        void addBatch(uint64_t id);
+
+        std::array<double, kStages> stageMs() const;
+        size_t tokensIn() const { return tokensIn_.load(std::memory_order_relaxed); }
+        size_t tokensOut() const { return tokensOut_.load(std::memory_order_relaxed); }
+        std::vector<uint64_t> batches() const;
+
+    private:
+        std::array<std::atomic<uint64_t>, kStages> stageMicros_{};
+        std::atomic<size_t> tokensIn_{0};
+        std::atomic<size_t> tokensOut_{0};
+        mutable std::mutex mutex_;
+        std::vector<uint64_t> batches_;
+    };
+
+    struct Entry {
+        int64_t timestampMs = 0;     // wall clock, ms since the epoch
+        double latencyMs = 0.0;
+        std::string direction;
+        std::string profile;
+        std::string priority;
+        std::string outcome;         // ok, cancelled, deadline_exceeded, failed
+        size_t texts = 0;
+        size_t inputBytes = 0;
+        size_t segments = 0;
+        size_t cacheHits = 0;
+        size_t tokensIn = 0;
+        size_t tokensOut = 0;
+        std::vector<uint64_t> batches;
+        std::array<double, kStages> stageMs{};
+        uint64_t traceId = 0;
+        std::vector<std::string> text;  // only when text logging is enabled
+    };
+
+    struct Options {
+        double thresholdMs = 2000.0;  // 0 disables the log
+        size_t capacity = 50;
+        bool logText = false;
+    };
+
+    explicit SlowRequestLog(const Options& options);
+
+    bool enabled() const { return options_.thresholdMs > 0.0 && options_.capacity > 0; }
+    bool logsText() const { return options_.logText; }
+    double thresholdMs() const { return options_.thresholdMs; }
+
+    // Logs and keeps the entry when it is slow enough; returns whether it was
+    bool record(Entry entry);
+
+    // Newest first
+    std::vector<Entry> recent() const;
+    size_t total() const { return total_.load(std::memory_order_relaxed); }
+
+    static nlohmann::json toJson(const Entry& entry);
+    // Threshold, total and the kept entries, as served at /debug/slow
+    nlohmann::json toJson() const;
+    // Texts kept for a log entry: truncated, never split inside a UTF-8 character
+    static std::vector<std::string> excerpt(const std::vector<std::string>& texts, size_t maxBytes = 200);
+
+private:
+    const Options options_;
+    std::atomic<size_t> total_{0};
+    mutable std::mutex mutex_;
+    std::deque<Entry> entries_;
+};
+
+} // namespace traductor
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+namespace traductor {
+
+/**
+ * Minimal fixed-size worker pool.
+ * Tasks run in FIFO order; submit() returns a future that also carries exceptions.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t numThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task for execution on a worker thread
+    std::future<void> submit(std::function<void()> task);
+
+    // Number of worker threads
+    size_t size() const { return workers_.size(); }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::packaged_task<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    void workerLoop();
+};
+
+} // namespace traductor
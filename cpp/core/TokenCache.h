@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace traductor {
+
+/**
+ * Small sharded LRU cache for tokenizer results.
+ * Each shard has its own mutex, so concurrent encode/decode calls rarely contend.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class TokenCache {
+public:
+    explicit TokenCache(size_t capacity, size_t numShards = 16)
+        : numShards_(numShards > 0 ? numShards : 1),
+          shardCapacity_((capacity + numShards_ - 1) / numShards_),
+          shards_(std::make_unique<Shard[]>(numShards_)) {}
+
+    // Copy the cached value into out; returns false on a miss
+    bool get(const Key& key, Value& out) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        shard.order.splice(shard.order.end(), shard.order, it->second);
+        out = it->second->second;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void put(const Key& key, const Value& value) {
+        if (shardCapacity_ == 0) {
+            return;
+        }
+
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = value;
+            shard.order.splice(shard.order.end(), shard.order, it->second);
+            return;
+        }
+
+        if (shard.index.size() >= shardCapacity_) {
+            shard.index.erase(shard.order.front().first);
+            shard.order.pop_front();
+        }
+        shard.order.emplace_back(key, value);
+        shard.index.emplace(key, std::prev(shard.order.end()));
+    }
+
+    size_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    size_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<Key, Value>> order;  // most recent at end
+        std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+    };
+
+    size_t numShards_;
+    size_t shardCapacity_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+
+    Shard& shardFor(const Key& key) {
+        return shards_[Hash{}(key) % numShards_];
+    }
+};
+
+// FNV-1a over token IDs, for caching detokenized output
+struct TokenIdsHash {
+    size_t operator()(const std::vector<int>& ids) const {
+        uint64_t hash = 1469598103934665603ULL;
+        for (int id : ids) {
+            hash ^= static_cast<uint32_t>(id);
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+} // namespace traductor
@@ -1,5 +1,6 @@
 #include "Tokenizer.h"
-#include <iostream>
+#include "ThreadPool.h"
+#include "Logger.h"
 #include <algorithm>
 #include <filesystem>
 
@@ -9,10 +10,42 @@
 
 namespace traductor {
 
+Tokenizer::Tokenizer() = default;
+
+Tokenizer::~Tokenizer() = default;
+
+void Tokenizer::setCacheSize(size_t entries) {
+    if (entries == 0) {
+        encodeCache_.reset();
+        decodeCache_.reset();
+        return;
+    }
+    encodeCache_ = std::make_unique<TokenCache<std::string, std::vector<int>>>(entries);
+    decodeCache_ = std::make_unique<TokenCache<std::vector<int>, std::string, TokenIdsHash>>(entries);
+}
+
+Tokenizer::CacheStats Tokenizer::getCacheStats() const {
+    CacheStats stats;
+    if (encodeCache_) {
+        stats.encodeHits = encodeCache_->hits();
+        stats.encodeMisses = encodeCache_->misses();
+    }
+    if (decodeCache_) {
+        stats.decodeHits = decodeCache_->hits();
+        stats.decodeMisses = decodeCache_->misses();
+    }
+    return stats;
+}
+
+void Tokenizer::setNumWorkers(size_t workers) {
+    numWorkers_ = workers > 0 ? workers : 1;
+    pool_ = numWorkers_ > 1 ? std::make_unique<ThreadPool>(numWorkers_) : nullptr;
+}
+
 bool Tokenizer::load(const std::string& modelPath) {
     try {
         if (!std::filesystem::exists(modelPath)) {
-            std::cerr << "Tokenizer model file not found: " << modelPath << std::endl;
+            TRADUCTOR_LOG(Error, "tokenizer") << "Tokenizer model file not found: " << modelPath;
             return false;
         }
         
@@ -21,21 +54,30 @@ bool Tokenizer::load(const std::string& modelPath) {
         
         auto status = processor_->Load(modelPath);
         if (!status.ok()) {
-            std::cerr << "Failed to load SentencePiece model: " << status.ToString() << std::endl;
+            TRADUCTOR_LOG(Error, "tokenizer") << "Failed to load SentencePiece model: " << status.ToString();
             processor_.reset();
             return false;
         }
         
-        std::cout << "SentencePiece tokenizer loaded from: " << modelPath << std::endl;
+        // One processor per batch worker; worker 0 shares processor_
+        workerProcessors_.clear();
+        for (size_t i = 1; i < numWorkers_; ++i) {
+            auto extra = std::make_unique<sentencepiece::SentencePieceProcessor>();
+            if (!extra->Load(modelPath).ok()) {
+                break;
+            }
+            workerProcessors_.push_back(std::move(extra));
+        }
+        
+        TRADUCTOR_LOG(Info, "tokenizer") << "SentencePiece tokenizer loaded from: " << modelPath;
         initializeLanguageMappings();
-        return true;
 #else
-        std::cout << "SentencePiece not available, using simplified tokenizer" << std::endl;
+        TRADUCTOR_LOG(Info, "tokenizer") << "SentencePiece not available, using simplified tokenizer";
         initializeLanguageMappings();
-        return true;
 #endif
+        return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading tokenizer: " << e.what() << std::endl;
+        TRADUCTOR_LOG(Error, "tokenizer") << "Error loading tokenizer: " << e.what();
         return false;
     }
 }
@@ -125,49 +167,26 @@ bool Tokenizer::isValidLanguageCode(const std::string& languageCode) const {
 }
 
 std::vector<int> Tokenizer::encode(const std::string& text, const std::string& sourceLang) {
-#ifdef HAVE_SENTENCEPIECE
-    if (processor_) {
-        std::vector<int> ids;
-        auto status = processor_->Encode(text, &ids);
-        if (status.ok()) {
-            return addSourceLanguageToken(ids, sourceLang);
-        }
-    }
-#endif
-    // Fallback: simplified encoding
     std::vector<int> result;
-    for (char c : text) {
-        result.push_back(static_cast<int>(c));
-    }
+    std::vector<int> scratch;
+    encodeInto(0, text, sourceLang, scratch, result);
     return result;
 }
 
 std::vector<std::vector<int>> Tokenizer::encode(const std::vector<std::string>& texts, const std::string& sourceLang) {
+    TokenBatch batch;
+    encodeBatch(texts, sourceLang, batch);
+    
     std::vector<std::vector<int>> result;
-    for (const auto& text : texts) {
-        result.push_back(encode(text, sourceLang));
+    result.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        result.push_back(batch.sequence(i));
     }
     return result;
 }
 
-std::string Tokenizer::decode(const std::vector<int>& tokenIds, bool skipSpecialTokens) {
-#ifdef HAVE_SENTENCEPIECE
-    if (processor_) {
-        std::string result;
-        auto status = processor_->Decode(tokenIds, &result);
-        if (status.ok()) {
-            return result;
-        }
-    }
-#endif
-    // Fallback: simple character conversion
-    std::string result;
-    for (int id : tokenIds) {
-        if (id > 0 && id < 256) { // Simple ASCII range check
-            result += static_cast<char>(id);
-        }
-    }
-    return result;
+std::string Tokenizer::decode(const std::vector<int>& tokenIds, bool /*skipSpecialTokens*/) {
+    return decodeWith(0, tokenIds.data(), tokenIds.size());
 }
 
 std::vector<std::string> Tokenizer::decode(const std::vector<std::vector<int>>& tokenIdLists, bool skipSpecialTokens) {
@@ -178,6 +197,57 @@ std::vector<std::string> Tokenizer::decode(const std::vector<std::vector<int>>&
     return result;
 }
 
+void Tokenizer::encodeBatch(const std::vector<std::string>& texts, const std::string& sourceLang, TokenBatch& out) {
+    out.clear();
+    out.offsets.reserve(texts.size() + 1);
+    out.offsets.push_back(0);
+    
+    // Reserve the arena once: NLLB averages well under one token per 3 bytes
+    size_t totalBytes = 0;
+    for (const auto& text : texts) {
+        totalBytes += text.size();
+    }
+    out.ids.reserve(totalBytes / 3 + texts.size());
+    
+    // Each worker fills its own contiguous chunk, then chunks are appended in order
+    const size_t workers = pool_ ? pool_->size() : 1;
+    std::vector<std::vector<int>> chunkIds(workers);
+    std::vector<std::vector<size_t>> chunkLengths(workers);
+    
+    forEachChunk(texts.size(), [&](size_t worker, size_t begin, size_t end) {
+        auto& ids = chunkIds[worker];
+        auto& lengths = chunkLengths[worker];
+        ids.reserve(totalBytes / 3 / workers + (end - begin));
+        lengths.reserve(end - begin);
+        
+        std::vector<int> scratch;
+        for (size_t i = begin; i < end; ++i) {
+            size_t before = ids.size();
+            encodeInto(worker, texts[i], sourceLang, scratch, ids);
+            lengths.push_back(ids.size() - before);
+        }
+    });
+    
+    for (size_t w = 0; w < workers; ++w) {
+        for (size_t length : chunkLengths[w]) {
+            out.offsets.push_back(out.offsets.back() + length);
+        }
+        out.ids.insert(out.ids.end(), chunkIds[w].begin(), chunkIds[w].end());
+    }
+}
+
+std::vector<std::string> Tokenizer::decodeBatch(const TokenBatch& batch, bool /*skipSpecialTokens*/) {
+    std::vector<std::string> result(batch.size());
+    
+    forEachChunk(batch.size(), [&](size_t worker, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = decodeWith(worker, batch.data(i), batch.length(i));
+        }
+    });
+    
+    return result;
+}
+
 std::vector<int> Tokenizer::tokensToIds(const std::vector<std::string>& tokens) {
     std::vector<int> result;
     for (const auto& token : tokens) {
@@ -213,13 +283,109 @@ const std::vector<std::string>& Tokenizer::getSupportedLanguages() {
     return languages;
 }
 
-std::vector<int> Tokenizer::addSourceLanguageToken(const std::vector<int>& tokens, const std::string& sourceLang) {
-    std::vector<int> result;
-    if (auto it = langCodeToId_.find(sourceLang); it != langCodeToId_.end()) {
-        result.push_back(it->second);
+void Tokenizer::encodeInto(size_t worker, const std::string& text, const std::string& sourceLang,
+                           std::vector<int>& scratch, std::vector<int>& out) const {
+    std::string cacheKey;
+    if (encodeCache_ && text.size() <= kMaxCachedTextBytes) {
+        cacheKey.reserve(sourceLang.size() + 1 + text.size());
+        cacheKey.append(sourceLang).push_back('\0');
+        cacheKey.append(text);
+        if (encodeCache_->get(cacheKey, scratch)) {
+            out.insert(out.end(), scratch.begin(), scratch.end());
+            return;
+        }
+    }
+    const size_t start = out.size();
+    bool encoded = false;
+    
+#ifdef HAVE_SENTENCEPIECE
+    // SentencePieceProcessor::Encode is const, so a worker may share processor_
+    const auto* processor = (worker > 0 && worker <= workerProcessors_.size())
+        ? workerProcessors_[worker - 1].get() : processor_.get();
+    if (processor && processor->Encode(text, &scratch).ok()) {
+        // Language token goes straight into the arena ahead of the pieces
+        if (auto it = langCodeToId_.find(sourceLang); it != langCodeToId_.end()) {
+            out.push_back(it->second);
+        }
+        out.insert(out.end(), scratch.begin(), scratch.end());
+        encoded = true;
+    }
+#else
+    (void)worker;
+#endif
+    if (!encoded) {
+        // Fallback: simplified encoding, one id per byte (decodeUncached maps them back)
+        for (unsigned char c : text) {
+            out.push_back(static_cast<int>(c));
+        }
+    }
+    
+    if (!cacheKey.empty()) {
+        encodeCache_->put(cacheKey, std::vector<int>(out.begin() + start, out.end()));
+    }
+}
+
+std::string Tokenizer::decodeWith(size_t worker, const int* ids, size_t length) const {
+    if (!decodeCache_ || length > kMaxCachedIds) {
+        return decodeUncached(worker, ids, length);
+    }
+    
+    std::vector<int> key(ids, ids + length);
+    std::string result;
+    if (decodeCache_->get(key, result)) {
+        return result;
+    }
+    result = decodeUncached(worker, ids, length);
+    decodeCache_->put(key, result);
+    return result;
+}
+
+std::string Tokenizer::decodeUncached(size_t worker, const int* ids, size_t length) const {
+#ifdef HAVE_SENTENCEPIECE
+    const auto* processor = (worker > 0 && worker <= workerProcessors_.size())
+        ? workerProcessors_[worker - 1].get() : processor_.get();
+    if (processor) {
+        std::string result;
+        if (processor->Decode(std::vector<int>(ids, ids + length), &result).ok()) {
+            return result;
+        }
+    }
+#else
+    (void)worker;
+#endif
+    // Fallback: simple character conversion
+    std::string result;
+    for (size_t i = 0; i < length; ++i) {
+        if (ids[i] > 0 && ids[i] < 256) {
+            result += static_cast<char>(ids[i]);
+        }
     }
-    result.insert(result.end(), tokens.begin(), tokens.end());
     return result;
 }
 
+void Tokenizer::forEachChunk(size_t count, const std::function<void(size_t, size_t, size_t)>& fn) {
+    size_t chunks = std::min(pool_ ? pool_->size() : size_t{1}, count);
+    if (chunks <= 1) {
+        if (count > 0) {
+            fn(0, 0, count);
+        }
+        return;
+    }
+    
+    size_t perChunk = (count + chunks - 1) / chunks;
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks);
+    for (size_t worker = 0; worker < chunks; ++worker) {
+        size_t begin = worker * perChunk;
+        size_t end = std::min(count, begin + perChunk);
+        if (begin >= end) {
+            break;
+        }
+        pending.push_back(pool_->submit([&fn, worker, begin, end] { fn(worker, begin, end); }));
+    }
+    for (auto& future : pending) {
+        future.get();
+    }
+}
+
 } // namespace traductor
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <functional>
+#include "TokenCache.h"
 
 #ifdef HAVE_SENTENCEPIECE
 #include "sentencepiece_processor.h"
@@ -11,18 +13,49 @@
 
 namespace traductor {
 
+class ThreadPool;
+
 /**
  * NLLB SentencePiece tokenizer wrapper.
  * Handles tokenization/detokenization and language-specific tokens.
  */
 class Tokenizer {
 public:
-    Tokenizer() = default;
-    ~Tokenizer() = default;
+    // Flat token ID arena for a batch: sequence i is ids[offsets[i], offsets[i + 1])
+    struct TokenBatch {
+        std::vector<int> ids;
+        std::vector<size_t> offsets;
+        
+        size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+        size_t length(size_t i) const { return offsets[i + 1] - offsets[i]; }
+        const int* data(size_t i) const { return ids.data() + offsets[i]; }
+        std::vector<int> sequence(size_t i) const { return {data(i), data(i) + length(i)}; }
+        void clear() { ids.clear(); offsets.clear(); }
+    };
+
+    // Encode/decode cache counters
+    struct CacheStats {
+        size_t encodeHits = 0;
+        size_t encodeMisses = 0;
+        size_t decodeHits = 0;
+        size_t decodeMisses = 0;
+    };
+    
+    Tokenizer();
+    ~Tokenizer();
 
     // Initialize from model path
     bool load(const std::string& modelPath);
     
+    // Number of SentencePiece processors/threads used by the batch API.
+    // Must be called before load().
+    void setNumWorkers(size_t workers);
+    size_t numWorkers() const { return numWorkers_; }
+    
+    // Cache frequent segments (greetings, footers) and output sequences; 0 disables
+    void setCacheSize(size_t entries);
+    CacheStats getCacheStats() const;
+    
     // Tokenization interface
     std::vector<std::string> tokenize(const std::string& text);
     std::vector<std::vector<std::string>> tokenize(const std::vector<std::string>& texts);
@@ -43,6 +76,10 @@ public:
     std::string decode(const std::vector<int>& tokenIds, bool skipSpecialTokens = true);
     std::vector<std::string> decode(const std::vector<std::vector<int>>& tokenIdLists, bool skipSpecialTokens = true);
     
+    // Batch API: fans out across the processor pool and writes into one arena
+    void encodeBatch(const std::vector<std::string>& texts, const std::string& sourceLang, TokenBatch& out);
+    std::vector<std::string> decodeBatch(const TokenBatch& batch, bool skipSpecialTokens = true);
+    
     // Convert between tokens and IDs
     std::vector<int> tokensToIds(const std::vector<std::string>& tokens);
     std::vector<std::string> idsToTokens(const std::vector<int>& ids);
@@ -56,10 +93,24 @@ public:
 private:
 #ifdef HAVE_SENTENCEPIECE
     std::unique_ptr<sentencepiece::SentencePieceProcessor> processor_;
+    // Extra processors for the batch API (processor_ serves worker 0)
+    std::vector<std::unique_ptr<sentencepiece::SentencePieceProcessor>> workerProcessors_;
 #else
     void* processor_ = nullptr;  // Placeholder for simplified build
 #endif
     
+    size_t numWorkers_ = 1;
+    std::unique_ptr<ThreadPool> pool_;
+    
+    // Only short texts/sequences are worth caching: long ones rarely repeat
+    static constexpr size_t kMaxCachedTextBytes = 512;
+    static constexpr size_t kMaxCachedIds = 128;
+    
+    // sourceLang + '\0' + text -> IDs (including the language token)
+    std::unique_ptr<TokenCache<std::string, std::vector<int>>> encodeCache_;
+    // output IDs -> detokenized text
+    std::unique_ptr<TokenCache<std::vector<int>, std::string, TokenIdsHash>> decodeCache_;
+    
     // NLLB language code to token ID mapping
     std::unordered_map<std::string, int> langCodeToId_;
     std::unordered_map<int, std::string> idToLangCode_;
@@ -67,8 +118,15 @@ private:
     // Initialize language mappings
     void initializeLanguageMappings();
     
-    // Add source language token to beginning if needed
-    std::vector<int> addSourceLanguageToken(const std::vector<int>& tokens, const std::string& sourceLang);
+    // Encode one text with the given worker's processor, appending to out.
+    // The source language token (if known) is written ahead of the pieces.
+    void encodeInto(size_t worker, const std::string& text, const std::string& sourceLang,
+                    std::vector<int>& scratch, std::vector<int>& out) const;
+    std::string decodeWith(size_t worker, const int* ids, size_t length) const;
+    std::string decodeUncached(size_t worker, const int* ids, size_t length) const;
+    
+    // Run fn(worker, begin, end) over count items split into contiguous chunks
+    void forEachChunk(size_t count, const std::function<void(size_t, size_t, size_t)>& fn);
 };
 
 } // namespace traductor
@@ -0,0 +1,157 @@
+#include "Tracer.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+
+namespace traductor {
+
+namespace {
+
+// Small stable per-thread ids read better in the trace viewer than hashed std::thread::ids
+uint32_t currentThreadId() {
+    static std::atomic<uint32_t> next{1};
+    thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+} // namespace
+
+Tracer::Tracer(const Options& options)
+    : options_(options), enabled_(!options.path.empty()), origin_(Clock::now()) {
+    if (enabled_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        openFile();
+    }
+}
+
+Tracer::~Tracer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        file_ << "\n]\n";
+    }
+}
+
+uint64_t Tracer::startTrace(bool force) {
+    if (!enabled_) {
+        return 0;
+    }
+    // Deterministic sampling: trace request n when n * rate crosses an integer
+    const uint64_t n = requests_.fetch_add(1, std::memory_order_relaxed);
+    const double rate = std::min(1.0, std::max(0.0, options_.sampleRate));
+    const bool sampled = std::floor(static_cast<double>(n + 1) * rate) > std::floor(static_cast<double>(n) * rate);
+    if (!force && !sampled) {
+        return 0;
+    }
+    return nextTraceId_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::record(uint64_t traceId, const char* name, const char* category,
+                    Clock::time_point start, Clock::time_point end, const std::string& args) {
+    if (!enabled_ || traceId == 0) {
+        return;
+    }
+    auto micros = [this](Clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t - origin_).count();
+    };
+
+    std::ostringstream event;
+    event << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1"
+          << ",\"tid\":" << currentThreadId() << ",\"ts\":" << micros(start)
+          << ",\"dur\":" << std::max<int64_t>(0, micros(end) - micros(start))
+          << ",\"args\":{\"request\":" << traceId << (args.empty() ? "" : ",") << args << "}}";
+    const std::string text = event.str();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_.is_open()) {
+        return;
+    }
+    if (fileBytes_ + text.size() > options_.maxFileBytes && !firstEvent_) {
+        rotate();
+    }
+    file_ << (firstEvent_ ? "\n" : ",\n") << text;
+    fileBytes_ += text.size() + 2;
+    firstEvent_ = false;
+    events_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        file_.flush();
+    }
+}
+
+void Tracer::Span::arg(const char* key, const std::string& value) {
+    if (!tracer_) {
+        return;
+    }
+    args_ += (args_.empty() ? "\"" : ",\"") + std::string(key) + "\":\"" + escape(value) + "\"";
+}
+
+void Tracer::Span::arg(const char* key, double value) {
+    if (!tracer_) {
+        return;
+    }
+    std::ostringstream number;
+    number << value;
+    args_ += (args_.empty() ? "\"" : ",\"") + std::string(key) + "\":" + number.str();
+}
+
+std::string Tracer::escape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+void Tracer::openFile() {
+    // JSON array format; viewers accept a missing closing bracket, so a crash still leaves a usable file
+    file_.open(options_.path, std::ios::out | std::ios::trunc);
+    if (!file_.is_open()) {
+        TRADUCTOR_LOG(Warning, "tracer") << "Cannot open trace file " << options_.path;
+        return;
+    }
+    file_ << "[";
+    fileBytes_ = 1;
+    firstEvent_ = true;
+}
+
+void Tracer::rotate() {
+    file_ << "\n]\n";
+    file_.close();
+
+    // path.N-1 -> path.N, ..., path -> path.1; the oldest falls off
+    std::error_code ec;
+    const std::string& path = options_.path;
+    if (options_.maxFiles == 0) {
+        std::filesystem::remove(path, ec);
+    } else {
+        std::filesystem::remove(path + "." + std::to_string(options_.maxFiles), ec);
+        for (size_t i = options_.maxFiles; i > 1; --i) {
+            std::filesystem::rename(path + "." + std::to_string(i - 1), path + "." + std::to_string(i), ec);
+        }
+        std::filesystem::rename(path, path + ".1", ec);
+    }
+    openFile();
+}
+
+} // namespace traductor
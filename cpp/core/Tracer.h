@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace traductor {
+
+/**
+ * Opt-in request tracing in the Chrome trace event format, for chrome://tracing
+ * or Perfetto. A request is traced when it asks for it or is sampled; its spans
+ * (stages, batches) carry its trace id in args.request, and each span is drawn
+ * on the track of the thread that ran it, so replica threads show which
+ * requests' batches they ran back to back. Events are appended to a JSON array
+ * file that is rotated (path.1 ... path.N) once it reaches the size limit.
+ * Requests that are not traced get id 0 and every call is a cheap no-op.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string path;            // empty disables tracing
+        double sampleRate = 0.0;     // share of requests traced without asking
+        size_t maxFileBytes = 64 * 1024 * 1024;
+        size_t maxFiles = 3;         // rotated files kept besides the current one
+    };
+
+    explicit Tracer(const Options& options);
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    bool enabled() const { return enabled_; }
+
+    // Trace id for a new request: nonzero when forced or sampled, 0 otherwise
+    uint64_t startTrace(bool force);
+
+    // args is a JSON object body without braces, e.g. "\"sequences\":4"
+    void record(uint64_t traceId, const char* name, const char* category,
+                Clock::time_point start, Clock::time_point end, const std::string& args = {});
+
+    // Push buffered events to disk (called when a traced request ends)
+    void flush();
+
+    size_t eventsWritten() const { return events_.load(std::memory_order_relaxed); }
+
+    // Records the lifetime of the scope as one complete ("X") event
+    class Span {
+    public:
+        Span(Tracer* tracer, uint64_t traceId, const char* name, const char* category)
+            : tracer_(traceId != 0 ? tracer : nullptr), traceId_(traceId), name_(name), category_(category),
+              start_(tracer_ ? Clock::now() : Clock::time_point{}) {}
+        ~Span() {
+            if (tracer_) {
+                tracer_->record(traceId_, name_, category_, start_, Clock::now(), args_);
+            }
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        bool active() const { return tracer_ != nullptr; }
+        void arg(const char* key, const std::string& value);
+        void arg(const char* key, double value);
+
+    private:
+        Tracer* tracer_;
+        uint64_t traceId_;
+        const char* name_;
+        const char* category_;
+        Clock::time_point start_;
+        std::string args_;
+    };
+
+    static std::string escape(const std::string& text);
+
+private:
+    const Options options_;
+    const bool enabled_;
+    const Clock::time_point origin_;
+    std::atomic<uint64_t> nextTraceId_{1};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<size_t> events_{0};
+
+    std::mutex mutex_;
+    std::ofstream file_;
+    size_t fileBytes_ = 0;
+    bool firstEvent_ = true;
+
+    // Caller holds mutex_
+    void openFile();
+    void rotate();
+};
+
+} // namespace traductor
@@ -3,27 +3,111 @@
 #include "Tokenizer.h"
 #include "LRUCache.h"
 #include "Segmenter.h"
+#include "SegmentStream.h"
 #include "Glossary.h"
 #include "PostprocessDA.h"
 #include "PostprocessES.h"
-#include <iostream>
+#include "RepetitionDetector.h"
+#include "Logger.h"
+#include "CTranslate2Backend.h"
+#include "MockBackend.h"
 #include <sstream>
 #include <algorithm>
+#include <exception>
 #include <regex>
 #include <filesystem>
 
-#ifdef HAVE_CTRANSLATE2
-#include <ctranslate2/translator.h>
-#include <ctranslate2/translation_options.h>
-#endif
-
 namespace traductor {
 
+namespace {
+
+// Polled between texts, batches and decoding steps
+void throwIfStopped(const std::shared_ptr<const CancellationToken>& cancel) {
+    if (cancel) {
+        auto reason = cancel->reason();
+        if (reason != CancellationToken::Reason::None) {
+            throw OperationCancelled(reason);
+        }
+    }
+}
+
+// Times one stage into the engine histogram and, when set, the request's breakdown
+class StageTimer {
+public:
+    StageTimer(LatencyHistogram& histogram, SlowRequestLog::Breakdown* breakdown, SlowRequestLog::Stage stage)
+        : histogram_(histogram), breakdown_(breakdown), stage_(stage), start_(std::chrono::steady_clock::now()) {}
+    ~StageTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        histogram_.recordDuration(elapsed);
+        if (breakdown_) {
+            breakdown_->addStage(stage_, elapsed);
+        }
+    }
+    
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+    
+private:
+    LatencyHistogram& histogram_;
+    SlowRequestLog::Breakdown* breakdown_;
+    SlowRequestLog::Stage stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace
+
 TranslatorEngine::TranslatorEngine(const Config& config) : config_(config) {
     // Initialize components with configuration values
     cache_ = std::make_unique<LRUCache>(config.cacheSize());
     segmenter_ = std::make_unique<Segmenter>(config.maxSegmentChars());
+    
+    Segmenter::PackingOptions packing;
+    packing.enabled = config.packShortSegments();
+    packing.targetTokens = static_cast<size_t>(config.packTargetTokens());
+    packing.maxUnitTokens = static_cast<size_t>(config.packMaxUnitTokens());
+    segmenter_->setPackingOptions(packing);
     tokenizer_ = std::make_unique<Tokenizer>();
+    tokenizer_->setNumWorkers(static_cast<size_t>(std::max(1, config.tokenizerThreads())));
+    tokenizer_->setCacheSize(config.tokenizerCacheSize());
+    
+    computeType_ = resolveComputeType(config.computeType(), CpuInfo::features());
+    
+    DegradationController::Options degradation;
+    degradation.enabled = config.degradationEnabled();
+    degradation.degradeQueueDepth = static_cast<size_t>(std::max(0, config.degradeQueueDepth()));
+    degradation.degradeLatencyMs = config.degradeLatencyMs();
+    degradation.recoverQueueDepth = static_cast<size_t>(std::max(0, config.recoverQueueDepth()));
+    degradation.recoverLatencyMs = config.recoverLatencyMs();
+    degradation.holdTime = std::chrono::milliseconds(std::max(0, config.degradationHoldMs()));
+    degradation.beamSteps = config.degradationBeamSteps();
+    degradation_ = std::make_unique<DegradationController>(degradation);
+    
+    ModelRouter::Options routing;
+    routing.enabled = config.cascadeEnabled();
+    routing.maxTokens = static_cast<size_t>(std::max(0, config.cascadeMaxTokens()));
+    routing.maxSimpleTokens = static_cast<size_t>(std::max(0, config.cascadeSimpleMaxTokens()));
+    routing.minSimplicity = config.cascadeMinSimplicity();
+    routing.minScore = static_cast<float>(config.cascadeMinScore());
+    router_ = std::make_unique<ModelRouter>(routing);
+    
+    AdmissionController::Options admission;
+    admission.enabled = config.admissionEnabled();
+    admission.deadlineSeconds = static_cast<double>(std::max(1, config.requestTimeout()));
+    admission.initialThroughput = config.admissionInitialThroughput();
+    admission_ = std::make_unique<AdmissionController>(admission);
+    
+    Tracer::Options tracing;
+    tracing.path = config.traceFile();
+    tracing.sampleRate = config.traceSampleRate();
+    tracing.maxFileBytes = static_cast<size_t>(std::max(1, config.traceMaxFileMb())) * 1024 * 1024;
+    tracing.maxFiles = static_cast<size_t>(std::max(0, config.traceMaxFiles()));
+    tracer_ = std::make_unique<Tracer>(tracing);
+    
+    SlowRequestLog::Options slowLog;
+    slowLog.thresholdMs = config.slowRequestMs();
+    slowLog.capacity = static_cast<size_t>(std::max(0, config.slowRequestLogSize()));
+    slowLog.logText = config.slowRequestLogText();
+    slowLog_ = std::make_unique<SlowRequestLog>(slowLog);
 }
 
 TranslatorEngine::~TranslatorEngine() = default;
@@ -32,7 +116,7 @@ bool TranslatorEngine::initialize() {
     loadStartTime_ = std::chrono::steady_clock::now();
     
     try {
-        std::cout << "Loading translation models..." << std::endl;
+        TRADUCTOR_LOG(Info, "engine") << "Loading translation models...";
         
         // Load tokenizer first
         if (!loadTokenizer()) {
@@ -42,59 +126,246 @@ bool TranslatorEngine::initialize() {
         // Load translation model
         if (!loadModel()) {
 #ifdef SIMPLIFIED_MODE
-            std::cout << "Running in simplified mode (no CTranslate2)" << std::endl;
+            TRADUCTOR_LOG(Info, "engine") << "Running in simplified mode (no CTranslate2)";
+            if (!startReplicaPool(false)) {
+                return false;
+            }
             isReady_ = true;
 #else
-            lastError_ = "Failed to load CTranslate2 model";
+            setLastError("Failed to load CTranslate2 model");
             return false;
 #endif
         } else {
             isReady_ = true;
         }
         
+        // Stage threads: tokenization, inference and post-processing overlap
+        InferencePipeline::Stages stages;
+        stages.preprocess = [this](InferencePipeline::Batch& batch) { tokenizeBatch(batch); };
+        stages.launch = [this](InferencePipeline::Batch& batch) { launchBatch(batch); };
+        stages.complete = [this](InferencePipeline::Batch& batch) { completeBatch(batch); };
+        pipeline_ = std::make_unique<InferencePipeline>(
+            std::move(stages), static_cast<size_t>(std::max(1, config_.pipelineQueueDepth())));
+        
         loadTime_ = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - loadStartTime_);
         
-        std::cout << "Translation engine ready (" << loadTime_.count() << "ms)" << std::endl;
+        TRADUCTOR_LOG(Info, "engine") << "Translation engine ready (" << loadTime_.count() << "ms)";
         return true;
     } catch (const std::exception& e) {
-        lastError_ = e.what();
-        std::cerr << "Initialization error: " << e.what() << std::endl;
+        setLastError(e.what());
+        TRADUCTOR_LOG(Error, "engine") << "Initialization error: " << e.what();
         return false;
     }
 }
 
+void TranslatorEngine::setLastError(std::string error) {
+    std::lock_guard<std::mutex> lock(lastErrorMutex_);
+    lastError_ = std::move(error);
+}
+
 bool TranslatorEngine::loadModel() {
-#ifdef HAVE_CTRANSLATE2
-    try {
-        std::string modelPath = config_.ct2Dir();
-        
-        // Check if model directory exists
-        if (!std::filesystem::exists(modelPath)) {
-            lastError_ = "Model directory not found: " + modelPath;
+    const std::string backend = config_.inferenceBackend();
+    if (backend != "auto" && backend != "ctranslate2" && backend != "mock") {
+        TRADUCTOR_LOG(Warning, "engine") << "Unknown inference_backend '" << backend << "', using auto";
+    }
+    if (backend == "mock") {
+        if (!startReplicaPool(true)) {
             return false;
         }
-        
-        // Initialize CTranslate2 translator
-        ctranslate2::TranslatorConfig translatorConfig;
-        translatorConfig.device = ctranslate2::Device::CPU;
-        translatorConfig.device_index = 0;
-        translatorConfig.compute_type = ctranslate2::ComputeType::INT8;
-        translatorConfig.inter_threads = config_.ct2InterThreads();
-        translatorConfig.intra_threads = config_.ct2IntraThreads();
-        
-        translator_ = std::make_unique<ctranslate2::Translator>(modelPath, ctranslate2::Device::CPU, translatorConfig);
-        
-        std::cout << "CTranslate2 model loaded from: " << modelPath << std::endl;
+        TRADUCTOR_LOG(Info, "engine") << "Mock inference backend (" << replicas_.size() << " replicas, "
+                                      << config_.mockBatchLatencyUs() << "us/batch + "
+                                      << config_.mockStepLatencyUs() << "us/step + "
+                                      << config_.mockTokenLatencyUs() << "us/token)";
         return true;
-    } catch (const std::exception& e) {
-        lastError_ = "Failed to load CTranslate2 model: " + std::string(e.what());
+    }
+    
+#ifdef HAVE_CTRANSLATE2
+    std::string modelPath = config_.ct2Dir();
+    
+    // Check if model directory exists
+    if (!std::filesystem::exists(modelPath)) {
+        setLastError("Model directory not found: " + modelPath);
         return false;
     }
-#else
-    // In simplified mode, just return true
+    
+    TRADUCTOR_LOG(Info, "engine") << "CPU features: " << CpuInfo::features().toString()
+                                  << ", compute type: " << computeType_
+                                  << (config_.computeType() == "auto" ? " (auto)" : "");
+    
+    if (!startReplicaPool(true)) {
+        return false;
+    }
+    loadVocabularyMaps();
+    
+    TRADUCTOR_LOG(Info, "engine") << "CTranslate2 model loaded from: " << modelPath
+                                  << " (" << replicas_.size() << " replicas x "
+                                  << std::max(1, config_.ct2IntraThreads()) << " threads)";
     return true;
+#else
+    if (backend == "ctranslate2") {
+        TRADUCTOR_LOG(Warning, "engine") << "inference_backend 'ctranslate2' needs a build with CTranslate2";
+    }
+    // In simplified mode the replicas only run the fallback translation
+    return startReplicaPool(false);
+#endif
+}
+
+std::string TranslatorEngine::resolveComputeType(const std::string& requested,
+                                                 const CpuInfo::Features& cpu) {
+    if (requested == "int8" || requested == "int8_float32" ||
+        requested == "int16" || requested == "float32") {
+        return requested;
+    }
+    if (requested != "auto") {
+        TRADUCTOR_LOG(Warning, "engine") << "Unknown compute_type '" << requested << "', using auto";
+    }
+    
+    // VNNI (and AVX-512BW) run int8 GEMMs natively; plain AVX2 still wins with
+    // int8 weights but keeps float32 activations; without AVX2 the int8
+    // kernels fall back to scalar code and float32 is faster
+    if (cpu.vnni() || cpu.avx512bw) {
+        return "int8";
+    }
+    if (cpu.avx2) {
+        return "int8_float32";
+    }
+    return "float32";
+}
+
+ReplicaPool::Options TranslatorEngine::replicaOptions() const {
+    ReplicaPool::Options options;
+    options.replicas = static_cast<size_t>(std::max(1, config_.ct2InterThreads()));
+    options.threadsPerReplica = static_cast<size_t>(std::max(1, config_.ct2IntraThreads()));
+    options.pinCores = config_.ct2PinCores();
+    options.coreOffset = std::max(0, config_.ct2CoreOffset());
+    // Enough queued batches to keep every replica busy without hoarding work
+    options.queueCapacity = options.replicas;
+    options.bulkShare = config_.bulkMinShare();
+    return options;
+}
+
+bool TranslatorEngine::startReplicaPool(bool withModel) {
+    ReplicaPool::Options options = replicaOptions();
+    ReplicaPool::ReplicaInit init = [](size_t) {};
+    replicas_.clear();
+    smallReplicas_.clear();
+    
+    const bool mock = config_.inferenceBackend() == "mock";
+    if (withModel && mock) {
+        MockBackend::Options latency;
+        latency.batchLatency = std::chrono::microseconds(std::max(0, config_.mockBatchLatencyUs()));
+        latency.stepLatency = std::chrono::microseconds(std::max(0, config_.mockStepLatencyUs()));
+        latency.tokenLatency = std::chrono::microseconds(std::max(0, config_.mockTokenLatencyUs()));
+        replicas_.resize(options.replicas);
+        init = [this, latency](size_t replica) { replicas_[replica] = std::make_unique<MockBackend>(latency); };
+    }
+    
+#ifdef HAVE_CTRANSLATE2
+    if (withModel && !mock) {
+        // The small model (e.g. a distilled NLLB) shares the SentencePiece vocabulary
+        std::string smallModelPath = config_.smallCt2Dir();
+        if (!smallModelPath.empty() && !std::filesystem::exists(smallModelPath)) {
+            TRADUCTOR_LOG(Warning, "engine") << "small_ct2_dir not found: " << smallModelPath;
+            smallModelPath.clear();
+        }
+        
+        replicas_.resize(options.replicas);
+        if (!smallModelPath.empty()) {
+            smallReplicas_.resize(options.replicas);
+        }
+        init = [this, smallModelPath, threads = options.threadsPerReplica](size_t replica) {
+            // Runs on the (pinned) replica thread, so the weights are allocated
+            // on that thread's NUMA node
+            replicas_[replica] = std::make_unique<CTranslate2Backend>(config_.ct2Dir(), computeType_, threads);
+            if (!smallModelPath.empty()) {
+                smallReplicas_[replica] = std::make_unique<CTranslate2Backend>(smallModelPath, computeType_, threads);
+            }
+        };
+    }
 #endif
+    
+    replicaPool_ = std::make_unique<ReplicaPool>(options, std::move(init));
+    std::string error;
+    if (!replicaPool_->start(error)) {
+        setLastError("Failed to load CTranslate2 model: " + error);
+        replicaPool_.reset();
+        replicas_.clear();
+        smallReplicas_.clear();
+        return false;
+    }
+    
+    degradation_->setSmallModelAvailable(!smallReplicas_.empty());
+    router_->setSmallModelAvailable(!smallReplicas_.empty());
+    if (withModel && config_.cascadeEnabled() && smallReplicas_.empty()) {
+        TRADUCTOR_LOG(Warning, "engine") << "cascade_enabled needs small_ct2_dir; routing everything to the large model";
+    }
+    
+    if (options.pinCores) {
+        auto cores = ReplicaPool::plannedCores(options);
+        TRADUCTOR_LOG(Info, "engine") << "Replica threads pinned to cores " << cores.front() << "-" << cores.back();
+    }
+    return true;
+}
+
+void TranslatorEngine::loadVocabularyMaps() {
+    vmapLanguages_.clear();
+    if (!config_.useVmap()) {
+        return;
+    }
+    
+    // CTranslate2 reads <ct2_dir>/vmap.txt; the per-language files written next to
+    // it by traductor_vmap tell which target languages that map actually covers
+    std::filesystem::path modelDir = config_.ct2Dir();
+    if (!std::filesystem::exists(modelDir / "vmap.txt")) {
+        TRADUCTOR_LOG(Warning, "engine") << "use_vmap is set but " << (modelDir / "vmap.txt").string()
+                                         << " does not exist; decoding with the full vocabulary";
+        return;
+    }
+    for (const auto& lang : {std::string("spa_Latn"), std::string("dan_Latn")}) {
+        if (std::filesystem::exists(modelDir / ("vmap." + lang + ".txt"))) {
+            vmapLanguages_.push_back(lang);
+        }
+    }
+    
+    if (vmapLanguages_.empty()) {
+        TRADUCTOR_LOG(Warning, "engine") << "vmap.txt has no per-language maps (vmap.<lang>.txt); "
+                                         << "decoding with the full vocabulary";
+        return;
+    }
+    std::string languages;
+    for (const auto& lang : vmapLanguages_) {
+        languages += " " + lang;
+    }
+    TRADUCTOR_LOG(Info, "engine") << "Vocabulary map enabled for:" << languages;
+}
+
+bool TranslatorEngine::usesVmap(const std::string& targetLang) const {
+    return std::find(vmapLanguages_.begin(), vmapLanguages_.end(), targetLang) != vmapLanguages_.end();
+}
+
+DecodingProfile TranslatorEngine::applyDegradation(DecodingProfile profile,
+                                                   const DegradationController::Level& level) const {
+    if (level.maxBeam > 0) {
+        profile.beamSize = std::min(profile.beamSize, level.maxBeam);
+    }
+    return profile;
+}
+
+size_t TranslatorEngine::currentQueueDepth() const {
+    size_t depth = activeRequests_.load();
+    if (pipeline_) {
+        auto stats = pipeline_->getStats();
+        depth += stats.preprocessQueueDepth + stats.inferenceQueueDepth + stats.completionQueueDepth;
+    }
+    if (replicaPool_) {
+        depth += replicaPool_->queueDepth();
+    }
+    return depth;
+}
+
+std::vector<int> TranslatorEngine::getInferenceCores() const {
+    return ReplicaPool::plannedCores(replicaOptions());
 }
 
 bool TranslatorEngine::loadTokenizer() {
@@ -111,7 +382,7 @@ bool TranslatorEngine::loadTokenizer() {
         for (const auto& path : possiblePaths) {
             if (std::filesystem::exists(path)) {
                 if (tokenizer_->load(path)) {
-                    std::cout << "Tokenizer loaded from: " << path << std::endl;
+                    TRADUCTOR_LOG(Info, "engine") << "Tokenizer loaded from: " << path;
                     loaded = true;
                     break;
                 }
@@ -119,13 +390,13 @@ bool TranslatorEngine::loadTokenizer() {
         }
         
         if (!loaded) {
-            std::cout << "Warning: No tokenizer model found, using simplified mode" << std::endl;
+            TRADUCTOR_LOG(Warning, "engine") << "No tokenizer model found, using simplified mode";
             // Don't fail, just use simplified tokenization
         }
         
         return true;
     } catch (const std::exception& e) {
-        lastError_ = "Failed to load tokenizer: " + std::string(e.what());
+        setLastError("Failed to load tokenizer: " + std::string(e.what()));
         return false;
     }
 }
@@ -135,7 +406,8 @@ TranslatorEngine::TranslationResult TranslatorEngine::translate(
     const std::string& direction,
     int maxNewTokens,
     bool formal,
-    const TermMap& glossary
+    const TermMap& glossary,
+    const RequestOptions& options
 ) {
     TranslationResult result;
     result.direction = direction;
@@ -143,100 +415,208 @@ TranslatorEngine::TranslationResult TranslatorEngine::translate(
     result.targetLang = getLanguageCode(direction, false);
     
     if (!isReady_) {
-        lastError_ = "Translator engine not initialized";
+        setLastError("Translator engine not initialized");
         return result;
     }
     
     if (!validateDirection(direction)) {
-        lastError_ = "Invalid direction: " + direction;
+        setLastError("Invalid direction: " + direction);
         return result;
     }
     
-    std::lock_guard<std::mutex> lock(translateMutex_);
+    DecodingProfile profile;
+    if (!config_.findDecodingProfile(options.profile, profile)) {
+        setLastError("Unknown decoding profile: " + options.profile);
+        return result;
+    }
+    result.profile = profile.name;
+    result.priority = options.priority.value_or(profile.priority);
+    
+    // Refuse up front what cannot finish before the deadline
+    auto ticket = options.admission;
+    if (!ticket) {
+        auto decision = admit(texts);
+        if (!decision.admitted()) {
+            result.rejected = true;
+            result.rejection = AdmissionController::reasonName(decision.reason);
+            result.retryAfterSeconds = decision.retryAfterSeconds;
+            setLastError("Request refused by admission control (" + result.rejection + ")");
+            return result;
+        }
+        ticket = decision.ticket;
+    }
+    
+    // Load seen by this request: other requests in flight plus their queued batches
     auto startTime = std::chrono::steady_clock::now();
+    const size_t queueDepth = currentQueueDepth();
+    activeRequests_++;
+    result.traceId = tracer_->startTrace(options.trace);
+    // Stage times of this request, kept only for the slow-request log
+    auto breakdown = slowLog_->enabled() ? std::make_shared<SlowRequestLog::Breakdown>() : nullptr;
+    size_t cacheHits = 0;
+    size_t segments = 0;
+    bool failed = false;
+    
+    auto level = degradation_->current();
+    result.degraded = level.degraded();
+    result.degradation = level.label();
     
     try {
-        std::vector<std::string> finalTranslations;
-        finalTranslations.reserve(texts.size());
+        InferencePipeline::Settings settings;
+        settings.direction = direction;
+        settings.maxNewTokens = maxNewTokens;
+        settings.formal = formal;
+        settings.profile = applyDegradation(profile, level);
+        settings.useSmallModel = level.useSmallModel;
+        settings.priority = result.priority;
+        settings.cancel = requestToken(options);
+        settings.traceId = result.traceId;
+        settings.breakdown = breakdown;
+        
+        std::vector<std::string> finalTranslations(texts.size());
+        
+        // Prepare glossary if provided (shared by every text of the request)
+        Glossary glossaryProcessor;
+        if (!glossary.empty()) {
+            glossaryProcessor.setTerms(glossary);
+        }
+        settings.glossary = glossary.empty() ? nullptr : &glossaryProcessor;
+        
+        // Texts that missed the cache, with their segments
+        std::vector<size_t> pendingIndices;
+        std::vector<std::string> pendingKeys;
+        std::vector<std::vector<std::string>> pendingUnits;
         
-        // Process each text
         for (size_t i = 0; i < texts.size(); ++i) {
             const std::string& text = texts[i];
             
             if (text.empty()) {
-                finalTranslations.push_back("");
                 continue;
             }
+            throwIfStopped(settings.cancel);
             
             // Check cache first
-            std::string cacheKey = makeCacheKey(text, direction);
-            std::string cachedResult = cache_->get(cacheKey);
+            std::string cacheKey = makeCacheKey(text, direction, profile.name);
+            std::string cachedResult;
+            {
+                StageTimer timer(histograms_.cacheLookup, breakdown.get(), SlowRequestLog::Stage::CacheLookup);
+                Tracer::Span span(tracer_.get(), settings.traceId, "cache_lookup", "stage");
+                cachedResult = cache_->get(cacheKey);
+            }
             if (!cachedResult.empty()) {
-                finalTranslations.push_back(cachedResult);
+                finalTranslations[i] = cachedResult;
                 result.usedCache = true;
+                cacheHits++;
                 continue;
             }
             
-            // Prepare glossary if provided
-            Glossary glossaryProcessor;
-            if (!glossary.empty()) {
-                glossaryProcessor.setTerms(glossary);
-            }
-            
             // Preprocess text (glossary protection)
-            std::string processedText = glossary.empty() ? text : 
-                                       glossaryProcessor.applyPreProcessing(text);
-            
-            // Segment text if needed
-            auto segments = segmenter_->segment(processedText);
-            std::vector<std::string> translatedSegments;
-            
-            // Translate each segment
-            for (const auto& segment : segments) {
-                std::string segmentTranslation;
-                
-#ifdef HAVE_CTRANSLATE2
-                if (translator_) {
-                    // Use CTranslate2 for real translation
-                    segmentTranslation = translateSegment(segment, direction, maxNewTokens, formal);
-                } else {
-#endif
-                    // Fallback to simplified translation
-                    segmentTranslation = translateSegmentSimple(segment, direction, formal);
-#ifdef HAVE_CTRANSLATE2
-                }
-#endif
-                translatedSegments.push_back(segmentTranslation);
+            std::string processedText;
+            if (settings.glossary) {
+                StageTimer timer(histograms_.glossary, breakdown.get(), SlowRequestLog::Stage::Glossary);
+                Tracer::Span span(tracer_.get(), settings.traceId, "glossary", "stage");
+                processedText = glossaryProcessor.applyPreProcessing(text);
+            } else {
+                processedText = text;
             }
             
-            // Rejoin segments
-            std::string joinedTranslation = segmenter_->rejoinSegments(translatedSegments);
+            // Segment text if needed
+            pendingIndices.push_back(i);
+            pendingKeys.push_back(std::move(cacheKey));
+            StageTimer timer(histograms_.segmentation, breakdown.get(), SlowRequestLog::Stage::Segmentation);
+            Tracer::Span span(tracer_.get(), settings.traceId, "segmentation", "stage");
+            pendingUnits.push_back(segmenter_->segment(processedText));
+            segments += pendingUnits.back().size();
+            span.arg("segments", static_cast<double>(pendingUnits.back().size()));
+        }
+        
+        // Translate the segments of all texts together so batches fill up
+        auto translatedUnits = translateUnits(pendingUnits, settings);
+        
+        for (size_t k = 0; k < pendingIndices.size(); ++k) {
+            // Rejoin segments, then post-process the text as a whole
+            std::string joinedTranslation = finishTranslation(
+                segmenter_->rejoinSegments(translatedUnits[k]), settings);
             
-            // Postprocess (glossary restoration and language-specific processing)
-            std::string postprocessed = postprocessTranslation(joinedTranslation, direction, formal);
-            if (!glossary.empty()) {
-                postprocessed = glossaryProcessor.applyPostProcessing(postprocessed);
+            // Cache the result (degraded output must not outlive the overload)
+            if (!result.degraded) {
+                cache_->put(pendingKeys[k], joinedTranslation);
             }
-            
-            // Cache the result
-            cache_->put(cacheKey, postprocessed);
-            finalTranslations.push_back(postprocessed);
+            finalTranslations[pendingIndices[k]] = std::move(joinedTranslation);
         }
         
         result.translations = std::move(finalTranslations);
         
+        // Only texts that reached the model count toward the measured throughput
+        size_t decodedTokens = 0;
+        for (size_t index : pendingIndices) {
+            decodedTokens += Segmenter::estimateTokens(texts[index]);
+        }
+        ticket->setCompletedTokens(decodedTokens);
+        
         auto endTime = std::chrono::steady_clock::now();
         result.latency_ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
         
         // Update metrics
-        totalTranslations_++;
-        avgLatency_ = (avgLatency_ * (totalTranslations_ - 1) + result.latency_ms) / totalTranslations_;
+        histograms_.request.recordDuration(endTime - startTime);
+        if (result.degraded) {
+            degradedResponses_++;
+        }
+        degradation_->observe(queueDepth, result.latency_ms);
         
+    } catch (const OperationCancelled& e) {
+        // Queued batches of this request were dropped by the pipeline; nothing is cached
+        result.translations.clear();
+        result.cancelled = true;
+        result.cancellation = CancellationToken::reasonName(e.reason());
+        setLastError(e.what());
+        recordCancellation(e.reason());
     } catch (const std::exception& e) {
-        lastError_ = e.what();
-        std::cerr << "Translation error: " << e.what() << std::endl;
+        failed = true;
+        setLastError(e.what());
+        TRADUCTOR_LOG(Error, "engine") << "Translation error: " << e.what();
+    }
+    
+    if (breakdown) {
+        auto endTime = std::chrono::steady_clock::now();
+        SlowRequestLog::Entry entry;
+        entry.latencyMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        if (entry.latencyMs >= slowLog_->thresholdMs()) {
+            entry.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            entry.direction = direction;
+            entry.profile = result.profile;
+            entry.priority = priorityName(result.priority);
+            entry.outcome = result.cancelled ? result.cancellation : failed ? "failed" : "ok";
+            entry.texts = texts.size();
+            for (const auto& text : texts) {
+                entry.inputBytes += text.size();
+            }
+            entry.segments = segments;
+            entry.cacheHits = cacheHits;
+            entry.tokensIn = breakdown->tokensIn();
+            entry.tokensOut = breakdown->tokensOut();
+            entry.batches = breakdown->batches();
+            entry.stageMs = breakdown->stageMs();
+            entry.traceId = result.traceId;
+            if (slowLog_->logsText()) {
+                entry.text = SlowRequestLog::excerpt(texts);
+            }
+            slowLog_->record(std::move(entry));
+        }
     }
     
+    if (result.traceId != 0) {
+        std::string args = "\"texts\":" + std::to_string(texts.size()) +
+                           ",\"direction\":\"" + Tracer::escape(direction) +
+                           "\",\"profile\":\"" + Tracer::escape(result.profile) +
+                           "\",\"priority\":\"" + priorityName(result.priority) +
+                           "\",\"cancelled\":" + (result.cancelled ? "true" : "false");
+        tracer_->record(result.traceId, "translate", "request", startTime, std::chrono::steady_clock::now(), args);
+        tracer_->flush();
+    }
+    
+    activeRequests_--;
     return result;
 }
 
@@ -245,12 +625,114 @@ std::string TranslatorEngine::translate(
     const std::string& direction,
     int maxNewTokens,
     bool formal,
-    const TermMap& glossary
+    const TermMap& glossary,
+    const RequestOptions& options
 ) {
-    auto result = translate(std::vector<std::string>{text}, direction, maxNewTokens, formal, glossary);
+    auto result = translate(std::vector<std::string>{text}, direction, maxNewTokens, formal, glossary, options);
     return result.translations.empty() ? "" : result.translations[0];
 }
 
+TranslatorEngine::StreamResult TranslatorEngine::translateStream(
+    std::istream& input,
+    const ParagraphCallback& emit,
+    const std::string& direction,
+    int maxNewTokens,
+    bool formal,
+    const TermMap& glossary,
+    const RequestOptions& options
+) {
+    StreamResult result;
+    if (!isReady_) {
+        setLastError("Translator engine not initialized");
+        return result;
+    }
+    
+    if (!validateDirection(direction)) {
+        setLastError("Invalid direction: " + direction);
+        return result;
+    }
+    
+    DecodingProfile profile;
+    if (!config_.findDecodingProfile(options.profile, profile)) {
+        setLastError("Unknown decoding profile: " + options.profile);
+        return result;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    Glossary glossaryProcessor;
+    if (!glossary.empty()) {
+        glossaryProcessor.setTerms(glossary);
+    }
+    InferencePipeline::Settings settings;
+    settings.direction = direction;
+    settings.maxNewTokens = maxNewTokens;
+    settings.formal = formal;
+    settings.glossary = glossary.empty() ? nullptr : &glossaryProcessor;
+    settings.priority = options.priority.value_or(profile.priority);
+    // A document can take far longer than any one request, so without a deadline
+    // from the caller request_timeout is restarted for every paragraph
+    auto token = options.cancel ? options.cancel : std::make_shared<CancellationToken>();
+    const bool paragraphDeadline = !token->hasDeadline() && config_.requestTimeout() > 0;
+    settings.cancel = token;
+    settings.traceId = tracer_->startTrace(options.trace);
+    
+    SegmentStream stream(input, *segmenter_);
+    SegmentStream::Segment segment;
+    std::vector<std::string> paragraphUnits;
+    size_t& paragraphs = result.paragraphs;
+    
+    try {
+        while (stream.next(segment)) {
+            // Glossary protection is local to each segment
+            paragraphUnits.push_back(glossary.empty() ? std::move(segment.text) :
+                                     glossaryProcessor.applyPreProcessing(segment.text));
+            if (!segment.endsParagraph) {
+                continue;
+            }
+            if (paragraphDeadline) {
+                token->setTimeout(std::chrono::seconds(config_.requestTimeout()));
+            }
+            throwIfStopped(settings.cancel);
+            
+            // Follow the current load level paragraph by paragraph
+            auto level = degradation_->current();
+            settings.profile = applyDegradation(profile, level);
+            settings.useSmallModel = level.useSmallModel;
+            auto units = translateUnits({paragraphUnits}, settings);
+            std::string translated = finishTranslation(segmenter_->rejoinSegments(units[0]), settings);
+            
+            emit(translated);
+            paragraphUnits.clear();
+            paragraphs++;
+        }
+        
+        histograms_.request.recordDuration(std::chrono::steady_clock::now() - startTime);
+        result.complete = true;
+        
+    } catch (const OperationCancelled& e) {
+        // Paragraphs already emitted stay emitted
+        result.cancelled = true;
+        result.cancellation = CancellationToken::reasonName(e.reason());
+        setLastError(std::string(e.what()) + " after " + std::to_string(paragraphs) + " paragraphs");
+        recordCancellation(e.reason());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        TRADUCTOR_LOG(Error, "engine") << "Streaming translation error: " << e.what();
+    }
+    
+    if (settings.traceId != 0) {
+        tracer_->record(settings.traceId, "translate_stream", "request", startTime, std::chrono::steady_clock::now(),
+                        "\"paragraphs\":" + std::to_string(paragraphs));
+        tracer_->flush();
+    }
+    if (paragraphDeadline) {
+        token->setTimeout(CancellationToken::Clock::duration::zero());  // the caller's token outlives the stream
+    }
+    
+    return result;
+}
+
 std::string TranslatorEngine::translateHtml(
     const std::string& html,
     const std::string& direction,
@@ -262,21 +744,143 @@ std::string TranslatorEngine::translateHtml(
     return "[HTML TRANSLATED: " + direction + "] " + html;
 }
 
+std::shared_ptr<CancellationToken> TranslatorEngine::requestToken(const RequestOptions& options) const {
+    auto token = options.cancel ? options.cancel : std::make_shared<CancellationToken>();
+    if (!token->hasDeadline() && config_.requestTimeout() > 0) {
+        token->setTimeout(std::chrono::seconds(config_.requestTimeout()));
+    }
+    return token;
+}
+
+void TranslatorEngine::recordCancellation(CancellationToken::Reason reason) {
+    if (reason == CancellationToken::Reason::DeadlineExceeded) {
+        deadlineExceeded_++;
+    } else {
+        cancelledRequests_++;
+    }
+}
+
+AdmissionController::Decision TranslatorEngine::admit(const std::vector<std::string>& texts) {
+    size_t tokens = 0;
+    for (const auto& text : texts) {
+        tokens += Segmenter::estimateTokens(text);
+    }
+    return admission_->admit(tokens);
+}
+
 TranslatorEngine::HealthInfo TranslatorEngine::getHealthInfo() const {
     HealthInfo info;
-#ifdef HAVE_CTRANSLATE2
-    info.modelLoaded = translator_ != nullptr;
-#else
-    info.modelLoaded = false;
-#endif
+    info.modelLoaded = !replicas_.empty();
+    info.inferenceBackend = replicas_.empty() || !replicas_.front() ? "simplified" : replicas_.front()->name();
     info.tokenizerLoaded = tokenizer_ != nullptr;
-    info.lastError = lastError_;
+    {
+        std::lock_guard<std::mutex> lock(lastErrorMutex_);
+        info.lastError = lastError_;
+    }
     info.loadTime = loadTime_;
-    info.cacheSize = cache_ ? cache_->size() : 0;
-    info.cacheHitRate = cache_ ? cache_->hitRate() : 0.0;
+    info.computeType = computeType_;
+    info.cpuFeatures = CpuInfo::features().toString();
+    info.vmapLanguages = vmapLanguages_;
+    if (cache_) {
+        auto cacheStats = cache_->getStats();
+        info.cacheSize = cacheStats.size;
+        info.cacheHitRate = cacheStats.hitRate;
+        info.cacheHits = cacheStats.hits;
+        info.cacheMisses = cacheStats.misses;
+    }
+    
+    if (tokenizer_) {
+        auto tokenStats = tokenizer_->getCacheStats();
+        info.tokenizerEncodeHits = tokenStats.encodeHits;
+        info.tokenizerEncodeMisses = tokenStats.encodeMisses;
+        info.tokenizerDecodeHits = tokenStats.decodeHits;
+        info.tokenizerDecodeMisses = tokenStats.decodeMisses;
+    }
+    
+    info.decoderSequences = decoderSequences_.load();
+    info.packedSegments = packedSegments_.load();
+    info.packingFallbacks = packingFallbacks_.load();
+    info.tokensIn = tokensIn_.load();
+    info.tokensOut = tokensOut_.load();
+    
+    if (pipeline_) {
+        auto stats = pipeline_->getStats();
+        info.preprocessQueueDepth = stats.preprocessQueueDepth;
+        info.inferenceQueueDepth = stats.inferenceQueueDepth;
+        info.completionQueueDepth = stats.completionQueueDepth;
+        info.pipelineQueueCapacity = stats.queueCapacity;
+        info.batchesCompleted = stats.batchesCompleted;
+        info.interactiveQueued = stats.interactiveQueued;
+        info.bulkQueued = stats.bulkQueued;
+        info.batchesCancelled = stats.batchesCancelled;
+    }
+    info.slowRequests = slowLog_->total();
+    
+    if (replicaPool_) {
+        info.replicas = replicaPool_->getStats();
+        info.replicaQueueDepth = replicaPool_->queueDepth();
+        info.interactiveQueued += replicaPool_->laneDepth(Priority::Interactive);
+        info.bulkQueued += replicaPool_->laneDepth(Priority::Bulk);
+    }
+    
+    auto degradation = degradation_->getStats();
+    info.degradationLevel = degradation.level.index;
+    info.degradation = degradation.level.label();
+    info.latencyEwmaMs = degradation.latencyEwmaMs;
+    info.degradationChanges = degradation.levelChanges;
+    info.degradedResponses = degradedResponses_.load();
+    info.smallModelLoaded = !smallReplicas_.empty();
+    info.models = router_->getStats();
+    info.repetitionLoops = repetitionLoops_.load();
+    info.repetitionRecovered = repetitionRecovered_.load();
+    info.admission = admission_->getStats();
+    info.cancelledRequests = cancelledRequests_.load();
+    info.deadlineExceeded = deadlineExceeded_.load();
     return info;
 }
 
+const TranslatorEngine::MetricsSnapshot::Series* TranslatorEngine::MetricsSnapshot::find(
+    const std::string& name) const {
+    for (const auto& entry : series) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+TranslatorEngine::MetricsSnapshot TranslatorEngine::getMetricsSnapshot() const {
+    // Export buckets, in each series' unit
+    static const std::vector<double> kMsBounds = {0.1, 0.5, 1, 5, 10, 25, 50, 100, 250, 500,
+                                                  1000, 2500, 5000, 10000, 30000, 60000};
+    static const std::vector<double> kBatchBounds = {1, 2, 4, 8, 16, 32, 64, 128};
+    static const std::vector<double> kRateBounds = {10, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+    constexpr double kMs = 0.001;
+    
+    MetricsSnapshot snapshot;
+    auto add = [&snapshot](const char* name, const char* unit, const LatencyHistogram& histogram,
+                           double scale, const std::vector<double>& bounds) {
+        MetricsSnapshot::Series series{name, unit, histogram.summary(scale), {}};
+        auto counts = histogram.cumulativeCounts(bounds, scale);
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            series.buckets.emplace_back(bounds[i], counts[i]);
+        }
+        snapshot.series.push_back(std::move(series));
+    };
+    add("request", "ms", histograms_.request, kMs, kMsBounds);
+    add("cache_lookup", "ms", histograms_.cacheLookup, kMs, kMsBounds);
+    add("glossary", "ms", histograms_.glossary, kMs, kMsBounds);
+    add("segmentation", "ms", histograms_.segmentation, kMs, kMsBounds);
+    add("tokenization", "ms", histograms_.tokenization, kMs, kMsBounds);
+    add("queue_wait", "ms", histograms_.queueWait, kMs, kMsBounds);
+    add("inference", "ms", histograms_.inference, kMs, kMsBounds);
+    add("detokenization", "ms", histograms_.detokenization, kMs, kMsBounds);
+    add("postprocessing", "ms", histograms_.postprocessing, kMs, kMsBounds);
+    add("batch_size", "sequences", histograms_.batchSize, 1.0, kBatchBounds);
+    add("tokens_per_second", "tokens/s", histograms_.tokensPerSecond, 1.0, kRateBounds);
+    return snapshot;
+}
+
 std::vector<std::string> TranslatorEngine::preprocessTexts(
     const std::vector<std::string>& texts,
     const TermMap& glossary
@@ -339,7 +943,7 @@ std::string TranslatorEngine::getLanguageCode(const std::string& direction, bool
     }
 }
 
-bool TranslatorEngine::validateDirection(const std::string& direction) const {
+bool TranslatorEngine::validateDirection(const std::string& direction) {
     return direction == "es-da" || direction == "da-es";
 }
 
@@ -356,49 +960,410 @@ bool TranslatorEngine::isMostlyLatin(const std::string& text) const {
     return (static_cast<double>(latinCount) / text.length()) >= 0.8;
 }
 
-std::string TranslatorEngine::translateSegment(const std::string& segment, const std::string& direction, 
-                                              int maxNewTokens, bool formal) {
-#ifdef HAVE_CTRANSLATE2
-    if (!translator_ || !tokenizer_) {
-        return translateSegmentSimple(segment, direction, formal);
+std::vector<std::vector<std::string>> TranslatorEngine::translateUnits(
+    const std::vector<std::vector<std::string>>& unitLists,
+    const InferencePipeline::Settings& settings) {
+    // Pack each text's units; packs never span two texts
+    std::vector<std::vector<Segmenter::PackedSegment>> packedLists;
+    packedLists.reserve(unitLists.size());
+    std::vector<std::string> sequences;
+    for (const auto& units : unitLists) {
+        auto packed = segmenter_->pack(units);
+        for (const auto& p : packed) {
+            sequences.push_back(p.text);
+        }
+        packedLists.push_back(std::move(packed));
     }
     
-    try {
-        std::string sourceLang = getLanguageCode(direction, true);
-        std::string targetLang = getLanguageCode(direction, false);
+    auto translatedSequences = translateSequences(sequences, settings);
+    
+    std::vector<std::vector<std::string>> translated(unitLists.size());
+    std::vector<std::string> retryUnits;
+    std::vector<std::pair<size_t, size_t>> retrySlots;  // (text, unit)
+    size_t next = 0;
+    
+    for (size_t t = 0; t < unitLists.size(); ++t) {
+        const auto& units = unitLists[t];
+        auto& out = translated[t];
+        out.reserve(units.size());
+        
+        for (const auto& packed : packedLists[t]) {
+            std::string& translation = translatedSequences[next++];
+            
+            if (packed.unitCount == 1) {
+                out.push_back(std::move(translation));
+                continue;
+            }
+            
+            packedSegments_++;
+            auto restored = segmenter_->unpack(translation, packed.unitCount);
+            if (!restored.empty()) {
+                for (auto& unit : restored) {
+                    out.push_back(std::move(unit));
+                }
+                continue;
+            }
+            
+            // Markers lost in translation: fall back to one sequence per unit
+            packingFallbacks_++;
+            for (size_t i = 0; i < packed.unitCount; ++i) {
+                retrySlots.emplace_back(t, out.size());
+                retryUnits.push_back(units[out.size()]);
+                out.emplace_back();
+            }
+        }
+    }
+    
+    if (!retryUnits.empty()) {
+        auto retried = translateSequences(retryUnits, settings);
+        for (size_t i = 0; i < retried.size(); ++i) {
+            translated[retrySlots[i].first][retrySlots[i].second] = std::move(retried[i]);
+        }
+    }
+    
+    return translated;
+}
+
+std::vector<std::string> TranslatorEngine::translateSequences(
+    const std::vector<std::string>& sequences,
+    const InferencePipeline::Settings& settings) {
+    decoderSequences_ += sequences.size();
+    
+    // Cascade: split by model first, so every batch runs on exactly one model.
+    // Degraded requests are already pinned to the small model.
+    InferencePipeline::Settings smallSettings = settings;
+    smallSettings.useSmallModel = true;
+    smallSettings.escalateLowConfidence = true;
+    
+    std::vector<size_t> largeIndices;
+    std::vector<size_t> smallIndices;
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        bool small = !settings.useSmallModel && router_->route(sequences[i]) == ModelRouter::Model::Small;
+        (small ? smallIndices : largeIndices).push_back(i);
+    }
+    
+    // Split into batches bounded by sequence count and estimated source tokens
+    const size_t maxBatchSize = static_cast<size_t>(std::max(1, config_.maxBatchSize()));
+    const size_t maxBatchTokens = static_cast<size_t>(std::max(1, config_.maxBatchTokens()));
+    
+    std::vector<std::future<std::vector<std::string>>> pending;
+    std::vector<std::vector<size_t>> pendingIndices;
+    
+    auto submitGroup = [&](const std::vector<size_t>& indices, const InferencePipeline::Settings& groupSettings) {
+        std::unique_ptr<InferencePipeline::Batch> batch;
+        std::vector<size_t> batchIndices;
+        size_t batchTokens = 0;
         
-        // Tokenize input
-        auto tokens = tokenizer_->encode(segment, sourceLang);
+        auto flush = [&]() {
+            if (batch) {
+                pending.push_back(pipeline_->submit(std::move(batch)));
+                pendingIndices.push_back(std::move(batchIndices));
+            }
+            batch.reset();
+            batchIndices.clear();
+            batchTokens = 0;
+        };
         
+        for (size_t index : indices) {
+            const std::string& sequence = sequences[index];
+            size_t tokens = Segmenter::estimateTokens(sequence);
+            if (batch && (batch->sources.size() >= maxBatchSize || batchTokens + tokens > maxBatchTokens)) {
+                flush();
+            }
+            if (!batch && settings.cancel && settings.cancel->stopRequested()) {
+                return;  // submit nothing more; thrown below once the pending batches are back
+            }
+            if (!batch) {
+                batch = std::make_unique<InferencePipeline::Batch>();
+                batch->settings = groupSettings;
+            }
+            batch->sources.push_back(sequence);
+            batchIndices.push_back(index);
+            batchTokens += tokens;
+        }
+        flush();
+    };
+    
+    submitGroup(largeIndices, settings);
+    submitGroup(smallIndices, smallSettings);
+    
+    // Batches are submitted up front, so later ones tokenize while earlier ones decode.
+    // Every batch is waited for even after a failure: they point into the caller's settings.
+    std::vector<std::string> translations(sequences.size());
+    std::exception_ptr failure;
+    for (size_t b = 0; b < pending.size(); ++b) {
+        try {
+            auto batchTranslations = pending[b].get();
+            for (size_t i = 0; i < batchTranslations.size(); ++i) {
+                translations[pendingIndices[b][i]] = std::move(batchTranslations[i]);
+            }
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    throwIfStopped(settings.cancel);
+    
+    return translations;
+}
+
+void TranslatorEngine::tokenizeBatch(InferencePipeline::Batch& batch) {
+    if (!replicas_.empty()) {
+        StageTimer timer(histograms_.tokenization, batch.settings.breakdown.get(), SlowRequestLog::Stage::Tokenization);
+        Tracer::Span span(tracer_.get(), batch.settings.traceId, "tokenize", "batch");
+        span.arg("batch", static_cast<double>(batch.id));
+        tokenizer_->encodeBatch(batch.sources, getLanguageCode(batch.settings.direction, true), batch.tokens);
+    }
+}
+
+void TranslatorEngine::launchBatch(InferencePipeline::Batch& batch) {
+    if (!replicaPool_) {
+        runBatchOnReplica(batch, 0);
+        return;
+    }
+    
+    // Hand the batch to the next free replica; the completion stage waits on it.
+    // submit() blocks while every replica is busy and the batch's lane is full,
+    // which only stalls this lane's launch thread.
+    auto job = std::make_shared<std::future<void>>(replicaPool_->submit(
+        [this, &batch](size_t replica) { runBatchOnReplica(batch, replica); }, batch.settings.priority));
+    batch.await = [job](InferencePipeline::Batch&) { job->get(); };
+}
+
+void TranslatorEngine::runBatchOnReplica(InferencePipeline::Batch& batch, size_t replica) {
+    // The batch may have waited for a replica since the pipeline last checked
+    throwIfStopped(batch.settings.cancel);
+    const auto model = batch.settings.useSmallModel ? ModelRouter::Model::Small : ModelRouter::Model::Large;
+    auto start = std::chrono::steady_clock::now();
+    histograms_.queueWait.recordDuration(start - batch.submittedAt);
+    histograms_.batchSize.record(batch.sources.size());
+    auto* breakdown = batch.settings.breakdown.get();
+    if (breakdown) {
+        breakdown->addBatch(batch.id);
+        breakdown->addStage(SlowRequestLog::Stage::QueueWait, start - batch.submittedAt);
+    }
+    
+    // The replica's thread is the span's track, so back-to-back batches of different requests line up
+    Tracer::Span span(tracer_.get(), batch.settings.traceId, "inference", "batch");
+    span.arg("batch", static_cast<double>(batch.id));
+    span.arg("replica", static_cast<double>(replica));
+    span.arg("model", model == ModelRouter::Model::Small ? "small" : "large");
+    span.arg("sequences", static_cast<double>(batch.sources.size()));
+    tracer_->record(batch.settings.traceId, "queue_wait", "batch", batch.submittedAt, start,
+                    "\"batch\":" + std::to_string(batch.id));
+    
+    // Whole batch including loop retries and escalations
+    const auto batchStart = start;
+    auto recordInference = [&](size_t inputTokens, size_t outputTokens) {
+        tokensIn_ += inputTokens;
+        tokensOut_ += outputTokens;
+        auto elapsed = std::chrono::steady_clock::now() - batchStart;
+        histograms_.inference.recordDuration(elapsed);
+        if (breakdown) {
+            breakdown->addTokens(inputTokens, outputTokens);
+            breakdown->addStage(SlowRequestLog::Stage::Inference, elapsed);
+        }
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        if (seconds > 0.0) {
+            histograms_.tokensPerSecond.record(static_cast<uint64_t>(outputTokens / seconds));
+        }
+    };
+    auto elapsedMs = [&start]() {
+        auto now = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - start).count();
+        start = now;
+        return ms;
+    };
+    
+    auto& backends = batch.settings.useSmallModel && !smallReplicas_.empty() ? smallReplicas_ : replicas_;
+    if (replica < backends.size() && backends[replica]) {
         // Prepare translation options
-        ctranslate2::TranslationOptions options;
-        options.beam_size = config_.beamSize();
-        options.max_decoding_length = maxNewTokens > 0 ? maxNewTokens : config_.defaultMaxNewTokens();
-        options.release_attention_weights = false;
-        options.release_hypothesis = false;
+        InferenceBackend::Options options;
+        options.beamSize = static_cast<size_t>(std::max(1, batch.settings.profile.beamSize));
+        options.lengthPenalty = batch.settings.profile.lengthPenalty;
+        options.patience = batch.settings.profile.patience;
+        options.maxDecodingLength = batch.settings.maxNewTokens > 0 ? batch.settings.maxNewTokens : config_.defaultMaxNewTokens();
+        options.useVmap = usesVmap(getLanguageCode(batch.settings.direction, false));
+        options.returnScores = batch.settings.escalateLowConfidence;
+        options.noRepeatNgramSize = static_cast<size_t>(std::max(0, config_.noRepeatNgramSize()));
+        options.repetitionPenalty = static_cast<float>(config_.repetitionPenalty());
+        
+        // The step callback stops a hypothesis as soon as it repeats (loop guard) and
+        // stops all of them once the request is cancelled or out of time. Backends may
+        // only call it for greedy search (CTranslate2 does); beam output is checked afterwards.
+        const bool guard = config_.repetitionGuard();
+        const size_t maxNgram = static_cast<size_t>(std::max(1, config_.repetitionMaxNgram()));
+        const size_t maxRepeats = static_cast<size_t>(std::max(2, config_.repetitionMaxRepeats()));
+        const CancellationToken* cancel = batch.settings.cancel.get();
+        auto guardLoops = [&](InferenceBackend::Options& opts, std::vector<RepetitionDetector>& detectors) {
+            if ((guard || cancel) && opts.beamSize == 1) {
+                opts.stepCallback = [&detectors, guard, cancel](size_t sequence, int tokenId) {
+                    if (cancel && cancel->stopRequested()) {
+                        return true;
+                    }
+                    return guard && sequence < detectors.size() && detectors[sequence].push(tokenId);
+                };
+            }
+        };
+        auto loopsAt = [&](const std::vector<int>& ids) {
+            return guard ? RepetitionDetector::findLoop(ids, maxNgram, maxRepeats) : ids.size();
+        };
         
-        // Add target language prefix
-        std::vector<std::vector<int>> sourceTokens = {tokens};
-        std::vector<std::string> targetPrefix = {targetLang};
+        std::vector<std::vector<int>> sourceTokens;
+        sourceTokens.reserve(batch.tokens.size());
+        for (size_t i = 0; i < batch.tokens.size(); ++i) {
+            sourceTokens.push_back(batch.tokens.sequence(i));
+        }
         
-        // Run translation
-        auto results = translator_->translate_batch(sourceTokens, targetPrefix, options);
+        // Target language token forced as the first output token
+        const std::string targetLang = getLanguageCode(batch.settings.direction, false);
         
-        if (results.empty() || results[0].hypotheses.empty()) {
-            return translateSegmentSimple(segment, direction, formal);
+        std::vector<std::vector<int>> hypotheses(sourceTokens.size());
+        try {
+            std::vector<RepetitionDetector> detectors(sourceTokens.size(), RepetitionDetector(maxNgram, maxRepeats));
+            guardLoops(options, detectors);
+            auto results = backends[replica]->translateBatch(sourceTokens, targetLang, options);
+            options.stepCallback = nullptr;
+            router_->record(model, sourceTokens.size(), elapsedMs());
+            throwIfStopped(batch.settings.cancel);  // output was cut short, skip the retries
+            
+            std::vector<size_t> looped;
+            std::vector<size_t> escalate;
+            for (size_t i = 0; i < results.size() && i < hypotheses.size(); ++i) {
+                if (results[i].ids.empty()) {
+                    continue;
+                }
+                hypotheses[i] = std::move(results[i].ids);
+                
+                if (detectors[i].looping() || loopsAt(hypotheses[i]) < hypotheses[i].size()) {
+                    looped.push_back(i);
+                    continue;
+                }
+                
+                // Low-confidence small-model output is redone by the large model
+                if (batch.settings.escalateLowConfidence && results[i].hasScore) {
+                    float perToken = results[i].score /
+                                     static_cast<float>(std::max<size_t>(1, hypotheses[i].size()));
+                    if (router_->shouldEscalate(perToken)) {
+                        escalate.push_back(i);
+                    }
+                }
+            }
+            
+            // Retry loops greedily with repetition constraints and a length cap near the source length
+            if (!looped.empty()) {
+                repetitionLoops_ += looped.size();
+                
+                InferenceBackend::Options safe = options;
+                safe.beamSize = 1;
+                safe.returnScores = false;
+                safe.noRepeatNgramSize = std::max<size_t>(safe.noRepeatNgramSize, 3);
+                safe.repetitionPenalty = std::max(safe.repetitionPenalty, 1.2f);
+                
+                std::vector<std::vector<int>> retrySources;
+                size_t longestSource = 0;
+                for (size_t i : looped) {
+                    retrySources.push_back(sourceTokens[i]);
+                    longestSource = std::max(longestSource, sourceTokens[i].size());
+                }
+                safe.maxDecodingLength = std::min(safe.maxDecodingLength, 2 * longestSource + 8);
+                
+                std::vector<RepetitionDetector> retryDetectors(retrySources.size(), RepetitionDetector(maxNgram, maxRepeats));
+                guardLoops(safe, retryDetectors);
+                auto retried = backends[replica]->translateBatch(retrySources, targetLang, safe);
+                router_->record(model, retrySources.size(), elapsedMs());
+                
+                for (size_t k = 0; k < retried.size() && k < looped.size(); ++k) {
+                    if (!retried[k].ids.empty()) {
+                        hypotheses[looped[k]] = std::move(retried[k].ids);
+                    }
+                    // Still looping: keep the text up to the first repeat rather than the runaway tail
+                    auto& ids = hypotheses[looped[k]];
+                    size_t loop = loopsAt(ids);
+                    if (loop < ids.size()) {
+                        ids.resize(loop);
+                    } else {
+                        repetitionRecovered_++;
+                    }
+                }
+            }
+            
+            if (!escalate.empty() && replicas_[replica]) {
+                std::vector<std::vector<int>> retrySources;
+                for (size_t i : escalate) {
+                    retrySources.push_back(sourceTokens[i]);
+                }
+                options.returnScores = false;
+                auto retried = replicas_[replica]->translateBatch(retrySources, targetLang, options);
+                router_->record(ModelRouter::Model::Large, retrySources.size(), elapsedMs());
+                router_->recordEscalations(escalate.size());
+                for (size_t k = 0; k < retried.size() && k < escalate.size(); ++k) {
+                    if (!retried[k].ids.empty()) {
+                        hypotheses[escalate[k]] = std::move(retried[k].ids);
+                    }
+                }
+            }
+        } catch (const OperationCancelled&) {
+            throw;
+        } catch (const std::exception& e) {
+            // Left empty: completeBatch falls back to the simplified translation
+            TRADUCTOR_LOG(Error, "engine") << "Batch translation error: " << e.what();
         }
         
+        batch.output.clear();
+        batch.output.offsets.push_back(0);
+        for (const auto& ids : hypotheses) {
+            batch.output.ids.insert(batch.output.ids.end(), ids.begin(), ids.end());
+            batch.output.offsets.push_back(batch.output.ids.size());
+        }
+        recordInference(batch.tokens.ids.size(), batch.output.ids.size());
+        return;
+    }
+    // Fallback to simplified translation
+    batch.translations.clear();
+    batch.translations.reserve(batch.sources.size());
+    size_t inputTokens = 0;
+    size_t outputTokens = 0;
+    for (const auto& source : batch.sources) {
+        batch.translations.push_back(translateSegmentSimple(source, batch.settings.direction, batch.settings.formal));
+        inputTokens += Segmenter::estimateTokens(source);
+        outputTokens += Segmenter::estimateTokens(batch.translations.back());
+    }
+    router_->record(model, batch.sources.size(), elapsedMs());
+    recordInference(inputTokens, outputTokens);
+}
+
+void TranslatorEngine::completeBatch(InferencePipeline::Batch& batch) {
+    if (batch.output.size() > 0) {
         // Decode result
-        std::string translation = tokenizer_->decode(results[0].hypotheses[0]);
-        return translation;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Translation error: " << e.what() << std::endl;
-        return translateSegmentSimple(segment, direction, formal);
+        {
+            StageTimer timer(histograms_.detokenization, batch.settings.breakdown.get(),
+                             SlowRequestLog::Stage::Detokenization);
+            Tracer::Span span(tracer_.get(), batch.settings.traceId, "detokenize", "batch");
+            span.arg("batch", static_cast<double>(batch.id));
+            batch.translations = tokenizer_->decodeBatch(batch.output);
+        }
+        for (size_t i = 0; i < batch.translations.size(); ++i) {
+            if (batch.translations[i].empty() && !batch.sources[i].empty()) {
+                batch.translations[i] = translateSegmentSimple(batch.sources[i], batch.settings.direction, batch.settings.formal);
+            }
+        }
     }
-#else
-    return translateSegmentSimple(segment, direction, formal);
-#endif
+}
+
+std::string TranslatorEngine::finishTranslation(const std::string& text, const InferencePipeline::Settings& settings) {
+    // Language-specific processing, then glossary restoration
+    StageTimer timer(histograms_.postprocessing, settings.breakdown.get(), SlowRequestLog::Stage::Postprocessing);
+    Tracer::Span span(tracer_.get(), settings.traceId, "postprocess", "stage");
+    std::string result = postprocessTranslation(text, settings.direction, settings.formal);
+    if (settings.glossary) {
+        result = settings.glossary->applyPostProcessing(result);
+    }
+    return result;
 }
 
 std::string TranslatorEngine::translateSegmentSimple(const std::string& segment, 
@@ -464,7 +1429,8 @@ std::string TranslatorEngine::postprocessTranslation(const std::string& text,
     return result;
 }
 
-std::string TranslatorEngine::makeCacheKey(const std::string& text, const std::string& direction) const {
+std::string TranslatorEngine::makeCacheKey(const std::string& text, const std::string& direction,
+                                           const std::string& profile) {
     // Normalize text for cache key
     std::string normalized = text;
     std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::tolower);
@@ -475,7 +1441,8 @@ std::string TranslatorEngine::makeCacheKey(const std::string& text, const std::s
     // Trim
     normalized = std::regex_replace(normalized, std::regex(R"(^\s+|\s+$)"), "");
     
-    return direction + "||" + normalized;
+    // Profiles decode differently, so their results are cached apart
+    return direction + "|" + profile + "||" + normalized;
 }
 
 } // namespace traductor
\ No newline at end of file
@@ -6,12 +6,21 @@
 #include <chrono>
 #include <unordered_map>
 #include <mutex>
-
-// Forward declarations
-#ifdef HAVE_CTRANSLATE2
-#include <ctranslate2/translator.h>
-#include <ctranslate2/translation_options.h>
-#endif
+#include <functional>
+#include <optional>
+#include <istream>
+#include <atomic>
+#include "AdmissionController.h"
+#include "CancellationToken.h"
+#include "InferencePipeline.h"
+#include "LatencyHistogram.h"
+#include "SlowRequestLog.h"
+#include "Tracer.h"
+#include "ReplicaPool.h"
+#include "CpuInfo.h"
+#include "DegradationController.h"
+#include "ModelRouter.h"
+#include "InferenceBackend.h"
 
 namespace traductor {
 
@@ -26,9 +35,21 @@ class PostprocessES;
 // Type alias for Glossary terms
 using TermMap = std::unordered_map<std::string, std::string>;
 
+// Per-request settings that do not change the text itself
+struct RequestOptions {
+    std::string profile;  // decoding profile name, empty = config default_profile
+    std::optional<Priority> priority;  // scheduling lane for the request's batches, unset = the profile's
+    // Admission taken by the caller before queueing (REST); translate() admits itself when empty
+    std::shared_ptr<AdmissionController::Ticket> admission;
+    // Stop flag the caller can trigger (window closed, client gone); translate() makes one
+    // when empty. Without a deadline of its own it gets request_timeout from the call's start.
+    std::shared_ptr<CancellationToken> cancel;
+    bool trace = false;  // always trace this request (needs trace_file); others are sampled
+};
+
 /**
  * Main translation engine that orchestrates the entire translation pipeline.
- * Uses CTranslate2 for inference with SentencePiece tokenization.
+ * Uses CTranslate2 (or another InferenceBackend) for inference with SentencePiece tokenization.
  */
 class TranslatorEngine {
 public:
@@ -39,6 +60,16 @@ public:
         std::string sourceLang;
         std::string targetLang;
         std::string direction;
+        std::string profile;  // decoding profile used
+        Priority priority = Priority::Interactive;  // lane the request's batches ran in
+        bool degraded = false;        // served at reduced quality because of load
+        std::string degradation;      // level label, "normal" when not degraded
+        bool rejected = false;        // refused by admission control, nothing translated
+        std::string rejection;        // "overloaded" or "too_large"
+        int retryAfterSeconds = 0;
+        bool cancelled = false;       // stopped early, translations are empty
+        std::string cancellation;     // "cancelled" or "deadline_exceeded"
+        uint64_t traceId = 0;         // args.request of its spans in the trace file, 0 if not traced
     };
 
     explicit TranslatorEngine(const Config& config);
@@ -56,7 +87,8 @@ public:
         const std::string& direction = "es-da",
         int maxNewTokens = -1,  // -1 = auto-calculate
         bool formal = false,
-        const TermMap& glossary = {}
+        const TermMap& glossary = {},
+        const RequestOptions& options = {}
     );
     
     // Single text translation (convenience)
@@ -65,7 +97,29 @@ public:
         const std::string& direction = "es-da",
         int maxNewTokens = -1,
         bool formal = false,
-        const TermMap& glossary = {}
+        const TermMap& glossary = {},
+        const RequestOptions& options = {}
+    );
+    
+    // Streaming translation for huge documents: segments are pulled lazily from
+    // the input and each translated paragraph is handed to the callback as soon
+    // as it is done. Unless options.cancel carries a deadline, request_timeout
+    // applies to each paragraph rather than to the whole stream.
+    using ParagraphCallback = std::function<void(const std::string&)>;
+    struct StreamResult {
+        size_t paragraphs = 0;        // paragraphs emitted
+        bool complete = false;        // the whole input was translated; otherwise see lastError
+        bool cancelled = false;       // stopped early by the caller or a deadline
+        std::string cancellation;     // "cancelled" or "deadline_exceeded"
+    };
+    StreamResult translateStream(
+        std::istream& input,
+        const ParagraphCallback& emit,
+        const std::string& direction = "es-da",
+        int maxNewTokens = -1,
+        bool formal = false,
+        const TermMap& glossary = {},
+        const RequestOptions& options = {}
     );
     
     // HTML translation (preserves structure)
@@ -80,43 +134,191 @@ public:
     // Health check and diagnostics
     struct HealthInfo {
         bool modelLoaded = false;
+        std::string inferenceBackend;  // "ctranslate2", "mock" or "simplified"
         bool tokenizerLoaded = false;
         std::string lastError;
         std::chrono::milliseconds loadTime{0};
+        std::string computeType;   // resolved, never "auto"
+        std::string cpuFeatures;
+        std::vector<std::string> vmapLanguages;  // targets decoded with the vocabulary map
         size_t cacheSize = 0;
         double cacheHitRate = 0.0;
+        size_t cacheHits = 0;
+        size_t cacheMisses = 0;
+        
+        // Tokenizer caches
+        size_t tokenizerEncodeHits = 0;
+        size_t tokenizerEncodeMisses = 0;
+        size_t tokenizerDecodeHits = 0;
+        size_t tokenizerDecodeMisses = 0;
+        
+        // Segment packing
+        size_t decoderSequences = 0;
+        size_t packedSegments = 0;
+        size_t packingFallbacks = 0;
+        
+        // Tokens through the decoder (source in, generated out)
+        size_t tokensIn = 0;
+        size_t tokensOut = 0;
+        
+        // Inference pipeline (batches waiting in front of each stage)
+        size_t preprocessQueueDepth = 0;
+        size_t inferenceQueueDepth = 0;
+        size_t completionQueueDepth = 0;
+        size_t pipelineQueueCapacity = 0;
+        size_t batchesCompleted = 0;
+        
+        // Model replicas (one worker thread each) and their shared job queue
+        std::vector<ReplicaPool::ReplicaStats> replicas;
+        size_t replicaQueueDepth = 0;
+        
+        // Batches queued per priority lane (pipeline stages and replica queue)
+        size_t interactiveQueued = 0;
+        size_t bulkQueued = 0;
+        
+        // Load-adaptive degradation
+        int degradationLevel = 0;
+        std::string degradation;
+        double latencyEwmaMs = 0.0;
+        size_t degradationChanges = 0;
+        size_t degradedResponses = 0;
+        bool smallModelLoaded = false;
+        
+        // Model cascade: per-model sequences, batch latency and escalations
+        std::vector<ModelRouter::ModelStats> models;
+        
+        // Runaway generation: hypotheses cut short as loops, and retries that came back clean
+        size_t repetitionLoops = 0;
+        size_t repetitionRecovered = 0;
+        
+        // Admission control: admitted backlog, measured throughput and refusals
+        AdmissionController::Stats admission;
+        
+        // Requests stopped by their caller or deadline, and batches dropped with them
+        size_t cancelledRequests = 0;
+        size_t deadlineExceeded = 0;
+        size_t batchesCancelled = 0;
+        
+        // Requests over slow_request_ms since start (the last few are in getSlowRequestLog())
+        size_t slowRequests = 0;
     };
     
     HealthInfo getHealthInfo() const;
     
+    // Latency and throughput distributions since the engine was created
+    struct MetricsSnapshot {
+        struct Series {
+            std::string name;
+            std::string unit;  // "ms", "sequences" or "tokens/s"
+            LatencyHistogram::Summary summary;
+            std::vector<std::pair<double, uint64_t>> buckets;  // cumulative (upper bound, count), for exporters
+        };
+        // "request" (end to end) first, then each stage in pipeline order, then batch shape
+        std::vector<Series> series;
+        
+        const Series* find(const std::string& name) const;
+    };
+    
+    MetricsSnapshot getMetricsSnapshot() const;
+    
+    // Requests over slow_request_ms, the most recent with their stage breakdown
+    const SlowRequestLog& getSlowRequestLog() const { return *slowLog_; }
+    
+    // Cost texts in estimated tokens and check them against the deadline (request_timeout).
+    // Keep the returned ticket alive until the request is done, e.g. in RequestOptions.
+    AdmissionController::Decision admit(const std::vector<std::string>& texts);
+    
+    // Names of the configured decoding profiles
+    std::vector<std::string> getDecodingProfiles() const { return config_.decodingProfileNames(); }
+    std::string getDefaultProfile() const { return config_.defaultProfile(); }
+    
     // Performance metrics
-    double getAverageLatency() const { return avgLatency_; }
-    size_t getTotalTranslations() const { return totalTranslations_; }
+    double getAverageLatency() const { return histograms_.request.mean() / 1000.0; }
+    size_t getTotalTranslations() const { return histograms_.request.count(); }
+    
+    // Cores reserved for model replicas (empty unless ct2_pin_cores is set)
+    std::vector<int> getInferenceCores() const;
+    
+    // Map the configured compute type to the one the model is loaded with.
+    // "auto" picks by ISA; unknown names are treated as "auto".
+    static std::string resolveComputeType(const std::string& requested, const CpuInfo::Features& cpu);
+    
+    // Translation cache key: direction, profile and the case- and whitespace-normalized text
+    static std::string makeCacheKey(const std::string& text, const std::string& direction,
+                                    const std::string& profile);
+
+    // True for the translation directions the engine serves ("es-da", "da-es")
+    static bool validateDirection(const std::string& direction);
 
 private:
     const Config& config_;
     
     // Core components
-#ifdef HAVE_CTRANSLATE2
-    std::unique_ptr<ctranslate2::Translator> translator_;
-#endif
+    // One backend per replica, built on the replica's worker; empty in simplified mode
+    std::vector<std::unique_ptr<InferenceBackend>> replicas_;
+    // Optional small model per replica: cascade target and last degradation level
+    std::vector<std::unique_ptr<InferenceBackend>> smallReplicas_;
+    std::unique_ptr<ReplicaPool> replicaPool_;
     std::unique_ptr<Tokenizer> tokenizer_;
     std::unique_ptr<LRUCache> cache_;
     std::unique_ptr<Segmenter> segmenter_;
+    std::unique_ptr<DegradationController> degradation_;
+    std::unique_ptr<ModelRouter> router_;
+    std::unique_ptr<AdmissionController> admission_;
+    std::unique_ptr<Tracer> tracer_;
+    std::unique_ptr<SlowRequestLog> slowLog_;
+    // Declared after the components its stages use, so it shuts down first
+    std::unique_ptr<InferencePipeline> pipeline_;
     
     // State
     bool isReady_ = false;
+    // Written by concurrent requests and read by getHealthInfo; only touch it via setLastError
+    mutable std::mutex lastErrorMutex_;
     std::string lastError_;
     std::chrono::steady_clock::time_point loadStartTime_;
     std::chrono::milliseconds loadTime_{0};
+    std::string computeType_;
+    std::vector<std::string> vmapLanguages_;
     
-    // Performance tracking
-    double avgLatency_ = 0.0;
-    size_t totalTranslations_ = 0;
+    // Performance tracking. Histograms record microseconds unless noted; all lock-free.
+    struct Histograms {
+        LatencyHistogram request;
+        LatencyHistogram cacheLookup;
+        LatencyHistogram glossary;
+        LatencyHistogram segmentation;
+        LatencyHistogram tokenization;
+        LatencyHistogram queueWait;        // batch submitted -> decoding starts (includes tokenization)
+        LatencyHistogram inference;
+        LatencyHistogram detokenization;
+        LatencyHistogram postprocessing;
+        LatencyHistogram batchSize;        // sequences per batch
+        LatencyHistogram tokensPerSecond;  // output tokens per second of inference, per batch
+    };
+    Histograms histograms_;
+    std::atomic<size_t> decoderSequences_{0};
+    std::atomic<size_t> tokensIn_{0};
+    std::atomic<size_t> tokensOut_{0};
+    std::atomic<size_t> packedSegments_{0};
+    std::atomic<size_t> packingFallbacks_{0};
+    std::atomic<size_t> degradedResponses_{0};
+    std::atomic<size_t> activeRequests_{0};
+    std::atomic<size_t> repetitionLoops_{0};
+    std::atomic<size_t> repetitionRecovered_{0};
+    std::atomic<size_t> cancelledRequests_{0};
+    std::atomic<size_t> deadlineExceeded_{0};
     
     // Internal helpers
+    void setLastError(std::string error);
     bool loadModel();
+    DecodingProfile applyDegradation(DecodingProfile profile, const DegradationController::Level& level) const;
+    size_t currentQueueDepth() const;
+    bool startReplicaPool(bool withModel);
+    void loadVocabularyMaps();
+    bool usesVmap(const std::string& targetLang) const;
+    ReplicaPool::Options replicaOptions() const;
     bool loadTokenizer();
+    std::shared_ptr<CancellationToken> requestToken(const RequestOptions& options) const;
+    void recordCancellation(CancellationToken::Reason reason);
     
     // Translation pipeline
     std::vector<std::string> preprocessTexts(
@@ -153,22 +355,29 @@ private:
     // Utility functions
     int calculateMaxNewTokens(const std::vector<std::vector<std::string>>& sourceTokens) const;
     std::string getLanguageCode(const std::string& direction, bool isSource) const;
-    bool validateDirection(const std::string& direction) const;
     bool isMostlyLatin(const std::string& text) const;
     
-    // Translation segment processing
-    std::string translateSegment(const std::string& segment, const std::string& direction, 
-                                int maxNewTokens, bool formal);
+    // Translation segment processing: one unit list per text, short units packed
+    std::vector<std::vector<std::string>> translateUnits(
+        const std::vector<std::vector<std::string>>& unitLists,
+        const InferencePipeline::Settings& settings);
+    std::vector<std::string> translateSequences(
+        const std::vector<std::string>& sequences,
+        const InferencePipeline::Settings& settings);
+    
+    // Pipeline stages
+    void tokenizeBatch(InferencePipeline::Batch& batch);
+    void launchBatch(InferencePipeline::Batch& batch);
+    void completeBatch(InferencePipeline::Batch& batch);
+    void runBatchOnReplica(InferencePipeline::Batch& batch, size_t replica);
+    
     std::string translateSegmentSimple(const std::string& segment, const std::string& direction, 
                                       bool formal);
     std::string postprocessTranslation(const std::string& text, const std::string& direction, 
                                       bool formal) const;
-    
-    // Thread safety
-    mutable std::mutex translateMutex_;
-    
-    // Cache operations
-    std::string makeCacheKey(const std::string& text, const std::string& direction) const;
+    // Post-processing and glossary restoration of one rejoined text; rules may
+    // span segment boundaries, so this never runs per segment
+    std::string finishTranslation(const std::string& text, const InferencePipeline::Settings& settings);
 };
 
 } // namespace traductor
@@ -20,6 +20,7 @@
 #include <QProgressBar>
 #include <QFile>
 #include <QTextStream>
+#include <QStringList>
 #include <stdexcept>
 
 MainWindow::MainWindow(traductor::TranslatorEngine& translator, QWidget* parent)
@@ -37,7 +38,24 @@ MainWindow::MainWindow(traductor::TranslatorEngine& translator, QWidget* parent)
     updateModelStatus();
 }
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow() {
+    stopTranslation();
+}
+
+void MainWindow::closeEvent(QCloseEvent* event) {
+    stopTranslation();
+    QMainWindow::closeEvent(event);
+}
+
+void MainWindow::stopTranslation() {
+    if (cancel_) {
+        cancel_->cancel();
+    }
+    if (worker_) {
+        // The engine checks the token between segments and decoding steps, so this is short
+        worker_->wait();
+    }
+}
 
 void MainWindow::setupUI() {
     setWindowTitle("Traductor Danés-Español");
@@ -83,6 +101,16 @@ void MainWindow::setupUI() {
     formalCheckBox_ = new QCheckBox("Formal (DA)");
     controlLayout->addWidget(formalCheckBox_);
     
+    controlLayout->addWidget(new QLabel("Perfil:"));
+    profileCombo_ = new QComboBox;
+    for (const auto& name : translator_.getDecodingProfiles()) {
+        profileCombo_->addItem(QString::fromStdString(name), QString::fromStdString(name));
+    }
+    profileCombo_->setCurrentIndex(profileCombo_->findData(
+        QString::fromStdString(translator_.getDefaultProfile())));
+    profileCombo_->setToolTip("fast: rápido (greedy), quality: máxima calidad");
+    controlLayout->addWidget(profileCombo_);
+    
     controlLayout->addWidget(new QLabel("Max tokens:"));
     maxTokensSpinBox_ = new QSpinBox;
     maxTokensSpinBox_->setRange(32, 8192);
@@ -195,32 +223,59 @@ void MainWindow::translateText() {
         return;
     }
     
+    if (worker_) {
+        return;  // one translation at a time; the button is disabled meanwhile
+    }
+    
     progressBar_->setVisible(true);
     progressBar_->setRange(0, 0); // Indeterminate
+    translateButton_->setEnabled(false);
     
-    QString direction = directionCombo_->currentData().toString();
+    std::string direction = directionCombo_->currentData().toString().toStdString();
     bool formal = formalCheckBox_->isChecked();
     int maxTokens = maxTokensSpinBox_->value() > 0 ? maxTokensSpinBox_->value() : -1;
     
-    try {
-        std::string result = translator_.translate(
-            inputText.toStdString(),
-            direction.toStdString(),
-            maxTokens,
-            formal,
-            glossary_
-        );
-        
-        textOutput_->setPlainText(QString::fromStdString(result));
-        
-        updateCacheStats();
-        
-    } catch (const std::exception& e) {
-        QMessageBox::critical(this, "Error de Traducción", 
-            QString("Error al traducir: %1").arg(e.what()));
+    auto options = currentRequestOptions();
+    cancel_ = std::make_shared<traductor::CancellationToken>();
+    options.cancel = cancel_;
+    
+    // Translate off the UI thread so the window stays responsive and can be closed
+    worker_ = QThread::create([this, text = inputText.toStdString(), direction, maxTokens, formal,
+                               glossary = glossary_, options]() {
+        auto result = translator_.translate(std::vector<std::string>{text}, direction, maxTokens,
+                                            formal, glossary, options);
+        QMetaObject::invokeMethod(this, [this, result]() { showTextResult(result); }, Qt::QueuedConnection);
+    });
+    connect(worker_, &QThread::finished, worker_, &QObject::deleteLater);
+    connect(worker_, &QThread::finished, this, [this]() {
+        worker_ = nullptr;
+        cancel_.reset();
+        translateButton_->setEnabled(true);
+        progressBar_->setVisible(false);
+    });
+    worker_->start();
+}
+
+void MainWindow::showTextResult(const traductor::TranslatorEngine::TranslationResult& result) {
+    if (result.cancelled) {
+        statusBar()->showMessage("Traducción cancelada", 3000);
+        return;
+    }
+    if (result.translations.empty()) {
+        QMessageBox::critical(this, "Error de Traducción",
+            QString("Error al traducir: %1").arg(QString::fromStdString(translator_.getHealthInfo().lastError)));
+        return;
     }
     
-    progressBar_->setVisible(false);
+    textOutput_->setPlainText(QString::fromStdString(result.translations[0]));
+    statusBar()->showMessage(QString("Perfil: %1").arg(profileCombo_->currentText()), 3000);
+    updateCacheStats();
+}
+
+traductor::RequestOptions MainWindow::currentRequestOptions() const {
+    traductor::RequestOptions options;
+    options.profile = profileCombo_->currentData().toString().toStdString();
+    return options;
 }
 
 void MainWindow::translateHtml() {
@@ -298,8 +353,26 @@ void MainWindow::updateMetrics() {
     updateModelStatus();
     updateCacheStats();
     
-    double avgLatency = translator_.getAverageLatency();
-    latencyLabel_->setText(QString("Latencia: %1ms").arg(avgLatency, 0, 'f', 1));
+    auto metrics = translator_.getMetricsSnapshot();
+    const auto* request = metrics.find("request");
+    if (request && request->summary.count > 0) {
+        latencyLabel_->setText(QString("Latencia: p50 %1ms, p99 %2ms")
+            .arg(request->summary.p50, 0, 'f', 1)
+            .arg(request->summary.p99, 0, 'f', 1));
+        
+        // Per-stage breakdown on hover
+        QStringList stages;
+        for (const auto& series : metrics.series) {
+            if (series.summary.count > 0) {
+                stages << QString("%1: p50 %2, p99 %3 %4")
+                    .arg(QString::fromStdString(series.name))
+                    .arg(series.summary.p50, 0, 'f', 2)
+                    .arg(series.summary.p99, 0, 'f', 2)
+                    .arg(QString::fromStdString(series.unit));
+            }
+        }
+        latencyLabel_->setToolTip(stages.join("\n"));
+    }
 }
 
 void MainWindow::updateModelStatus() {
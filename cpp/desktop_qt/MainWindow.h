@@ -13,6 +13,9 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTimer>
+#include <QThread>
+#include <QCloseEvent>
+#include <memory>
 
 // Necesario porque usamos traductor::Glossary::TermMap en miembros
 #include "../core/Glossary.h"
@@ -29,6 +32,10 @@ public:
     explicit MainWindow(traductor::TranslatorEngine& translator, QWidget* parent = nullptr);
     ~MainWindow();
 
+protected:
+    // Cancels a running translation and waits for it before the window goes away
+    void closeEvent(QCloseEvent* event) override;
+
 private slots:
     void translateText();
     void translateHtml();
@@ -43,6 +50,9 @@ private:
     void setupStatusBar();
     void connectSignals();
     void updateCacheStats();
+    traductor::RequestOptions currentRequestOptions() const;
+    void showTextResult(const traductor::TranslatorEngine::TranslationResult& result);
+    void stopTranslation();
 
     traductor::TranslatorEngine& translator_;
     
@@ -53,6 +63,7 @@ private:
     QTextEdit* htmlInput_ = nullptr;
     QTextEdit* htmlOutput_ = nullptr;
     QComboBox* directionCombo_ = nullptr;
+    QComboBox* profileCombo_ = nullptr;
     QCheckBox* formalCheckBox_ = nullptr;
     QSpinBox* maxTokensSpinBox_ = nullptr;
     QPushButton* translateButton_ = nullptr;
@@ -70,4 +81,8 @@ private:
     // State
     traductor::Glossary::TermMap glossary_;
     QTimer* metricsTimer_ = nullptr;
+    
+    // Text translation in progress (runs off the UI thread)
+    QThread* worker_ = nullptr;
+    std::shared_ptr<traductor::CancellationToken> cancel_;
 };
@@ -6,6 +6,7 @@
 #include "MainWindow.h"
 #include "../core/TranslatorEngine.h"
 #include "../core/Config.h"
+#include "../core/Logger.h"
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
@@ -20,10 +21,12 @@ int main(int argc, char *argv[]) {
     
     // Initialize translator engine with explicit model paths
     traductor::Config config;
+    traductor::Logger::instance().configure(traductor::Logger::Options::fromConfig(config));
     
     // Set explicit model paths for GUI (relative to executable location)
     config.setModelDir("./models/nllb-600m");
     config.setCt2Dir("./models/nllb-600m-ct2-int8");
+    config.setAdmissionEnabled(false);  // one local user; long documents must not be refused
     
     traductor::TranslatorEngine translator(config);
     
@@ -35,6 +38,7 @@ int main(int argc, char *argv[]) {
     // Initialize in background (in real implementation, you'd use threads)
     if (!translator.initialize()) {
         auto health = translator.getHealthInfo();
+        TRADUCTOR_LOG(Error, "gui") << "Failed to initialize translator: " << health.lastError;
         QMessageBox::critical(nullptr, "Error de Inicialización",
             QString("No se pudo inicializar el traductor.\n"
                    "Error: %1").arg(QString::fromStdString(health.lastError)));
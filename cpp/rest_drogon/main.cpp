@@ -1,11 +1,17 @@
-#include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <algorithm>
 #include "../core/TranslatorEngine.h"
 #include "../core/Config.h"
 #include "../core/Glossary.h"
+#include "../core/CpuInfo.h"
+#include "../core/FairQueue.h"
+#include "../core/Logger.h"
+#include "../core/MetricsExporter.h"
+#include "../core/RateLimiter.h"
+#include "../core/Segmenter.h"
 #include <nlohmann/json.hpp>
 
 #ifdef DROGON_FOUND
@@ -18,10 +24,12 @@ namespace traductor {
         
         class RestServer {
         public:
-            RestServer(const Config& config) : translator_(config) {}
+            RestServer(const Config& config)
+                : translator_(config),
+                  metrics_({"/translate", "/translate/html", "/health", "/metrics", "/stats/latency", "/debug/slow"}) {}
             
             bool initialize() {
-                std::cout << "Initializing REST server..." << std::endl;
+                TRADUCTOR_LOG(Info, "rest") << "Initializing REST server...";
                 return translator_.initialize();
             }
             
@@ -53,14 +61,49 @@ namespace traductor {
                         }
                     }
                     
-                    auto result = translator_.translate(texts, direction, maxTokens, formal, glossary);
+                    RequestOptions options;
+                    options.profile = request.value("profile", "");
+                    if (!isKnownProfile(options.profile)) {
+                        nlohmann::json error;
+                        error["error"] = "Unknown profile: " + options.profile;
+                        return error;
+                    }
+                    std::string priority = request.value("priority", "");
+                    if (!parsePriority(priority, options.priority)) {
+                        nlohmann::json error;
+                        error["error"] = "Unknown priority: " + priority;
+                        return error;
+                    }
+                    options.trace = request.value("trace", false);
+                    
+                    auto result = translator_.translate(texts, direction, maxTokens, formal, glossary, options);
+                    if (result.rejected) {
+                        nlohmann::json error;
+                        error["error"] = "Request cannot complete within the request timeout";
+                        error["reason"] = result.rejection;
+                        error["retry_after"] = result.retryAfterSeconds;
+                        return error;
+                    }
+                    if (result.cancelled) {
+                        nlohmann::json error;
+                        error["error"] = "Translation stopped before completion";
+                        error["reason"] = result.cancellation;
+                        return error;
+                    }
                     
                     nlohmann::json response;
                     response["provider"] = "nllb-ct2-int8";
                     response["direction"] = result.direction;
                     response["source"] = result.sourceLang;
                     response["target"] = result.targetLang;
+                    response["profile"] = result.profile;
+                    response["priority"] = priorityName(result.priority);
+                    response["degraded"] = result.degraded;
+                    response["degradation"] = result.degradation;
                     response["translations"] = result.translations;
+                    if (result.traceId != 0) {
+                        response["trace_id"] = result.traceId;
+                    }
                     
                     return response;
                     
@@ -114,18 +157,120 @@ namespace traductor {
                 nlohmann::json response;
                 response["status"] = health.modelLoaded ? "healthy" : "unhealthy";
                 response["model_loaded"] = health.modelLoaded;
+                response["inference_backend"] = health.inferenceBackend;
                 response["ready_for_translation"] = health.modelLoaded && health.tokenizerLoaded;
                 response["last_error"] = health.lastError;
+                response["compute_type"] = health.computeType;
+                response["cpu_features"] = health.cpuFeatures;
+                response["vmap_languages"] = health.vmapLanguages;
                 response["cache"] = {
                     {"size", health.cacheSize},
                     {"hit_rate", health.cacheHitRate}
                 };
+                response["tokenizer_cache"] = {
+                    {"encode_hits", health.tokenizerEncodeHits},
+                    {"encode_misses", health.tokenizerEncodeMisses},
+                    {"decode_hits", health.tokenizerDecodeHits},
+                    {"decode_misses", health.tokenizerDecodeMisses}
+                };
+                response["pipeline"] = {
+                    {"preprocess_queue", health.preprocessQueueDepth},
+                    {"inference_queue", health.inferenceQueueDepth},
+                    {"completion_queue", health.completionQueueDepth},
+                    {"queue_capacity", health.pipelineQueueCapacity},
+                    {"batches_completed", health.batchesCompleted},
+                    {"interactive_queued", health.interactiveQueued},
+                    {"bulk_queued", health.bulkQueued}
+                };
+                response["replicas"] = nlohmann::json::array();
+                for (const auto& replica : health.replicas) {
+                    response["replicas"].push_back({
+                        {"cores", replica.cores},
+                        {"numa_node", replica.numaNode},
+                        {"batches", replica.batches},
+                        {"busy_ms", replica.busyMs},
+                        {"utilization", replica.utilization}
+                    });
+                }
+                response["replica_queue"] = health.replicaQueueDepth;
+                response["degradation"] = {
+                    {"level", health.degradationLevel},
+                    {"mode", health.degradation},
+                    {"latency_ewma_ms", health.latencyEwmaMs},
+                    {"level_changes", health.degradationChanges},
+                    {"degraded_responses", health.degradedResponses},
+                    {"small_model_loaded", health.smallModelLoaded}
+                };
+                response["models"] = nlohmann::json::array();
+                for (const auto& model : health.models) {
+                    response["models"].push_back({
+                        {"name", model.name},
+                        {"sequences", model.sequences},
+                        {"batches", model.batches},
+                        {"avg_batch_ms", model.avgBatchMs()},
+                        {"escalations", model.escalations}
+                    });
+                }
+                response["repetition"] = {
+                    {"loops", health.repetitionLoops},
+                    {"recovered", health.repetitionRecovered}
+                };
+                response["admission"] = {
+                    {"backlog_tokens", health.admission.backlogTokens},
+                    {"in_flight", health.admission.inFlight},
+                    {"throughput_tokens_per_sec", health.admission.throughput},
+                    {"predicted_wait_seconds", health.admission.predictedWaitSeconds},
+                    {"admitted", health.admission.admitted},
+                    {"rejected_overloaded", health.admission.rejectedOverloaded},
+                    {"rejected_too_large", health.admission.rejectedTooLarge}
+                };
+                response["cancellation"] = {
+                    {"cancelled", health.cancelledRequests},
+                    {"deadline_exceeded", health.deadlineExceeded},
+                    {"batches_dropped", health.batchesCancelled}
+                };
                 
                 return response;
             }
             
+            // Endpoint: GET /metrics (Prometheus text format)
+            std::string handleMetrics() {
+                return metrics_.render(translator_.getHealthInfo(), translator_.getMetricsSnapshot());
+            }
+            
+            // Endpoint: GET /stats/latency
+            nlohmann::json handleLatencyStats() {
+                nlohmann::json response = nlohmann::json::object();
+                for (const auto& series : translator_.getMetricsSnapshot().series) {
+                    const auto& summary = series.summary;
+                    response[series.name] = {
+                        {"unit", series.unit},
+                        {"count", summary.count},
+                        {"mean", summary.mean},
+                        {"p50", summary.p50},
+                        {"p90", summary.p90},
+                        {"p99", summary.p99},
+                        {"p999", summary.p999},
+                        {"max", summary.max}
+                    };
+                }
+                return response;
+            }
+            
+            // Endpoint: GET /debug/slow
+            nlohmann::json handleSlowRequests() {
+                return translator_.getSlowRequestLog().toJson();
+            }
+            
         private:
             TranslatorEngine translator_;
+            MetricsExporter metrics_;
+            
+            bool isKnownProfile(const std::string& profile) const {
+                if (profile.empty()) return true;
+                auto names = translator_.getDecodingProfiles();
+                return std::find(names.begin(), names.end(), profile) != names.end();
+            }
             
             std::string getLanguageCode(const std::string& direction, bool isSource) {
                 if (direction == "es-da") {
@@ -142,6 +287,121 @@ namespace traductor {
 #ifdef DROGON_FOUND
 // Global translator instance (solo cuando Drogon está disponible)
 static std::unique_ptr<traductor::TranslatorEngine> g_translator;
+static const traductor::Config* g_config = nullptr;
+static std::unique_ptr<traductor::RateLimiter> g_rateLimiter;
+static std::unique_ptr<traductor::FairQueue> g_fairQueue;
+static std::unique_ptr<traductor::MetricsExporter> g_metrics;
+
+using ResponseCallback = std::function<void(const HttpResponsePtr&)>;
+
+// Clients are identified by API key when they send one listed in client_weights,
+// otherwise by source address. Unknown keys are ignored, so a client cannot
+// dodge its rate limit (or grow the limiter's tables) by sending a new key per request.
+struct ClientId {
+    std::string id;      // rate limiter / fair queue key
+    std::string weightKey;  // raw key or address, as used in client_weights
+};
+
+static ClientId identifyClient(const HttpRequestPtr& req) {
+    std::string key = req->getHeader(g_config->apiKeyHeader());
+    if (!key.empty() && g_config->isKnownClient(key)) {
+        return {"key:" + key, key};
+    }
+    std::string address = req->peerAddr().toIp();
+    return {"ip:" + address, address};
+}
+
+// Never echo full API keys in stats output
+static std::string displayClient(const std::string& id) {
+    if (id.rfind("key:", 0) == 0 && id.size() > 8) {
+        return id.substr(0, 8) + "...";
+    }
+    return id;
+}
+
+static size_t estimateTokens(const std::vector<std::string>& texts) {
+    size_t tokens = 0;
+    for (const auto& text : texts) {
+        tokens += traductor::Segmenter::estimateTokens(text);
+    }
+    return tokens;
+}
+
+// Token-bucket check; replies 429 with Retry-After and returns false when over the limit
+static bool admitRequest(const ClientId& client, size_t texts, size_t tokens, const ResponseCallback& callback) {
+    auto decision = g_rateLimiter->admit(client.id, texts, tokens);
+    if (decision.allowed) {
+        return true;
+    }
+    Json::Value error;
+    error["error"] = "Rate limit exceeded";
+    error["retry_after"] = decision.retryAfterSeconds;
+    auto resp = HttpResponse::newHttpJsonResponse(error);
+    resp->setStatusCode(k429TooManyRequests);
+    resp->addHeader("Retry-After", std::to_string(decision.retryAfterSeconds));
+    callback(resp);
+    return false;
+}
+
+// Deadline check against the engine backlog; replies 503 (overloaded, with Retry-After)
+// or 413 (too large for request_timeout even when idle) and returns false when refused.
+// The request's deadline starts here, so time spent in the fair queue counts against it.
+static bool admitWork(const std::vector<std::string>& texts, traductor::RequestOptions& options,
+                      const ResponseCallback& callback) {
+    auto decision = g_translator->admit(texts);
+    if (decision.admitted()) {
+        options.admission = decision.ticket;
+        options.cancel = std::make_shared<traductor::CancellationToken>();
+        if (g_config->requestTimeout() > 0) {
+            options.cancel->setTimeout(std::chrono::seconds(g_config->requestTimeout()));
+        }
+        return true;
+    }
+    Json::Value error;
+    error["error"] = "Request cannot complete within the request timeout";
+    error["reason"] = traductor::AdmissionController::reasonName(decision.reason);
+    error["predicted_seconds"] = decision.predictedSeconds;
+    auto resp = HttpResponse::newHttpJsonResponse(error);
+    if (decision.reason == traductor::AdmissionController::Reason::TooLarge) {
+        resp->setStatusCode(k413RequestEntityTooLarge);
+    } else {
+        resp->setStatusCode(k503ServiceUnavailable);
+        resp->addHeader("Retry-After", std::to_string(decision.retryAfterSeconds));
+    }
+    callback(resp);
+    return false;
+}
+
+// Run the translation on a REST worker in weighted-fair order (cost = estimated tokens),
+// so the IO threads stay free; replies 503 when the queue is full
+static void enqueueRequest(const ClientId& client, size_t tokens, std::function<void()> job,
+                           const ResponseCallback& callback) {
+    double weight = g_config->clientWeight(client.weightKey);
+    if (g_fairQueue->submit(client.id, weight, static_cast<double>(tokens), std::move(job))) {
+        return;
+    }
+    Json::Value error;
+    error["error"] = "Server busy, request queue is full";
+    auto resp = HttpResponse::newHttpJsonResponse(error);
+    resp->setStatusCode(k503ServiceUnavailable);
+    resp->addHeader("Retry-After", "1");
+    callback(resp);
+}
+
+// Empty means the configured default profile
+static bool isKnownProfile(const std::string& profile) {
+    if (profile.empty()) return true;
+    auto names = g_translator->getDecodingProfiles();
+    return std::find(names.begin(), names.end(), profile) != names.end();
+}
+
+static void rejectBadRequest(const std::string& message, const ResponseCallback& callback) {
+    Json::Value error;
+    error["error"] = message;
+    auto resp = HttpResponse::newHttpJsonResponse(error);
+    resp->setStatusCode(k400BadRequest);
+    callback(resp);
+}
 
 // Health endpoint
 void healthHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpResponsePtr&)>&& callback) {
@@ -150,10 +410,70 @@ void healthHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpR
     Json::Value response;
     response["status"] = health.modelLoaded ? "healthy" : "unhealthy";
     response["model_loaded"] = health.modelLoaded;
+    response["inference_backend"] = health.inferenceBackend;
     response["ready_for_translation"] = health.modelLoaded && health.tokenizerLoaded;
     response["last_error"] = health.lastError;
+    response["compute_type"] = health.computeType;
+    response["cpu_features"] = health.cpuFeatures;
+    response["vmap_languages"] = Json::Value(Json::arrayValue);
+    for (const auto& lang : health.vmapLanguages) {
+        response["vmap_languages"].append(lang);
+    }
     response["cache"]["size"] = static_cast<int>(health.cacheSize);
     response["cache"]["hit_rate"] = health.cacheHitRate;
+    response["tokenizer_cache"]["encode_hits"] = static_cast<Json::UInt64>(health.tokenizerEncodeHits);
+    response["tokenizer_cache"]["encode_misses"] = static_cast<Json::UInt64>(health.tokenizerEncodeMisses);
+    response["tokenizer_cache"]["decode_hits"] = static_cast<Json::UInt64>(health.tokenizerDecodeHits);
+    response["tokenizer_cache"]["decode_misses"] = static_cast<Json::UInt64>(health.tokenizerDecodeMisses);
+    response["pipeline"]["preprocess_queue"] = static_cast<Json::UInt64>(health.preprocessQueueDepth);
+    response["pipeline"]["inference_queue"] = static_cast<Json::UInt64>(health.inferenceQueueDepth);
+    response["pipeline"]["completion_queue"] = static_cast<Json::UInt64>(health.completionQueueDepth);
+    response["pipeline"]["queue_capacity"] = static_cast<Json::UInt64>(health.pipelineQueueCapacity);
+    response["pipeline"]["batches_completed"] = static_cast<Json::UInt64>(health.batchesCompleted);
+    response["pipeline"]["interactive_queued"] = static_cast<Json::UInt64>(health.interactiveQueued);
+    response["pipeline"]["bulk_queued"] = static_cast<Json::UInt64>(health.bulkQueued);
+    response["replicas"] = Json::Value(Json::arrayValue);
+    for (const auto& replica : health.replicas) {
+        Json::Value entry;
+        entry["cores"] = Json::Value(Json::arrayValue);
+        for (int core : replica.cores) {
+            entry["cores"].append(core);
+        }
+        entry["numa_node"] = replica.numaNode;
+        entry["batches"] = static_cast<Json::UInt64>(replica.batches);
+        entry["busy_ms"] = replica.busyMs;
+        entry["utilization"] = replica.utilization;
+        response["replicas"].append(entry);
+    }
+    response["replica_queue"] = static_cast<Json::UInt64>(health.replicaQueueDepth);
+    response["degradation"]["level"] = health.degradationLevel;
+    response["degradation"]["mode"] = health.degradation;
+    response["degradation"]["latency_ewma_ms"] = health.latencyEwmaMs;
+    response["degradation"]["level_changes"] = static_cast<Json::UInt64>(health.degradationChanges);
+    response["degradation"]["degraded_responses"] = static_cast<Json::UInt64>(health.degradedResponses);
+    response["degradation"]["small_model_loaded"] = health.smallModelLoaded;
+    response["models"] = Json::Value(Json::arrayValue);
+    for (const auto& model : health.models) {
+        Json::Value entry;
+        entry["name"] = model.name;
+        entry["sequences"] = static_cast<Json::UInt64>(model.sequences);
+        entry["batches"] = static_cast<Json::UInt64>(model.batches);
+        entry["avg_batch_ms"] = model.avgBatchMs();
+        entry["escalations"] = static_cast<Json::UInt64>(model.escalations);
+        response["models"].append(entry);
+    }
+    response["repetition"]["loops"] = static_cast<Json::UInt64>(health.repetitionLoops);
+    response["repetition"]["recovered"] = static_cast<Json::UInt64>(health.repetitionRecovered);
+    response["admission"]["backlog_tokens"] = static_cast<Json::UInt64>(health.admission.backlogTokens);
+    response["admission"]["in_flight"] = static_cast<Json::UInt64>(health.admission.inFlight);
+    response["admission"]["throughput_tokens_per_sec"] = health.admission.throughput;
+    response["admission"]["predicted_wait_seconds"] = health.admission.predictedWaitSeconds;
+    response["admission"]["admitted"] = static_cast<Json::UInt64>(health.admission.admitted);
+    response["admission"]["rejected_overloaded"] = static_cast<Json::UInt64>(health.admission.rejectedOverloaded);
+    response["admission"]["rejected_too_large"] = static_cast<Json::UInt64>(health.admission.rejectedTooLarge);
+    response["cancellation"]["cancelled"] = static_cast<Json::UInt64>(health.cancelledRequests);
+    response["cancellation"]["deadline_exceeded"] = static_cast<Json::UInt64>(health.deadlineExceeded);
+    response["cancellation"]["batches_dropped"] = static_cast<Json::UInt64>(health.batchesCancelled);
     
     auto resp = HttpResponse::newHttpJsonResponse(response);
     callback(resp);
@@ -196,24 +516,75 @@ void translateHandler(const HttpRequestPtr& req, std::function<void(const HttpRe
             }
         }
         
-        auto result = g_translator->translate(texts, direction, maxTokens, formal, glossary);
-        
-        Json::Value response;
-        response["provider"] = "nllb-ct2-int8";
-        response["direction"] = result.direction;
-        response["source"] = result.sourceLang;
-        response["target"] = result.targetLang;
-        response["latency_ms"] = result.latency_ms;
-        response["used_cache"] = result.usedCache;
+        traductor::RequestOptions options;
+        options.profile = json->get("profile", "").asString();
+        if (!isKnownProfile(options.profile)) {
+            rejectBadRequest("Unknown profile: " + options.profile, callback);
+            return;
+        }
+        std::string priority = json->get("priority", "").asString();
+        if (!traductor::parsePriority(priority, options.priority)) {
+            rejectBadRequest("Unknown priority: " + priority, callback);
+            return;
+        }
+        options.trace = json->get("trace", false).asBool();
         
-        Json::Value translations(Json::arrayValue);
-        for (const auto& translation : result.translations) {
-            translations.append(translation);
+        auto client = identifyClient(req);
+        size_t tokens = estimateTokens(texts);
+        if (!admitRequest(client, texts.size(), tokens, callback)) {
+            return;
+        }
+        if (!admitWork(texts, options, callback)) {
+            g_rateLimiter->refund(client.id, texts.size(), tokens);  // refused work does not use up the quota
+            return;
         }
-        response["translations"] = translations;
         
-        auto resp = HttpResponse::newHttpJsonResponse(response);
-        callback(resp);
+        auto job = [texts = std::move(texts), direction, maxTokens, formal,
+                    glossary = std::move(glossary), options, callback]() {
+            try {
+                auto result = g_translator->translate(texts, direction, maxTokens, formal, glossary, options);
+                if (result.cancelled) {
+                    // Ran out of time in the queue or mid-decode; its batches were already dropped
+                    Json::Value error;
+                    error["error"] = "Translation did not finish within the request timeout";
+                    error["reason"] = result.cancellation;
+                    auto resp = HttpResponse::newHttpJsonResponse(error);
+                    resp->setStatusCode(k503ServiceUnavailable);
+                    callback(resp);
+                    return;
+                }
+                
+                Json::Value response;
+                response["provider"] = "nllb-ct2-int8";
+                response["direction"] = result.direction;
+                response["source"] = result.sourceLang;
+                response["target"] = result.targetLang;
+                response["profile"] = result.profile;
+                response["priority"] = traductor::priorityName(result.priority);
+                response["degraded"] = result.degraded;
+                response["degradation"] = result.degradation;
+                response["latency_ms"] = result.latency_ms;
+                response["used_cache"] = result.usedCache;
+                
+                Json::Value translations(Json::arrayValue);
+                for (const auto& translation : result.translations) {
+                    translations.append(translation);
+                }
+                response["translations"] = translations;
+                if (result.traceId != 0) {
+                    response["trace_id"] = static_cast<Json::UInt64>(result.traceId);
+                }
+                
+                callback(HttpResponse::newHttpJsonResponse(response));
+            } catch (const std::exception& e) {
+                Json::Value error;
+                error["error"] = e.what();
+                auto resp = HttpResponse::newHttpJsonResponse(error);
+                resp->setStatusCode(k500InternalServerError);
+                callback(resp);
+            }
+        };
+        enqueueRequest(client, tokens, std::move(job), callback);
         
     } catch (const std::exception& e) {
         Json::Value error;
@@ -250,15 +621,39 @@ void translateHtmlHandler(const HttpRequestPtr& req, std::function<void(const Ht
             }
         }
         
-        std::string result = g_translator->translateHtml(html, direction, maxTokens, formal, glossary);
-        
-        Json::Value response;
-        response["provider"] = "nllb-ct2-int8";
-        response["direction"] = direction;
-        response["html"] = result;
+        // HTML is not translated through the decoding pipeline, so profile and priority do not apply
+        traductor::RequestOptions options;
+        auto client = identifyClient(req);
+        size_t tokens = traductor::Segmenter::estimateTokens(html);
+        if (!admitRequest(client, 1, tokens, callback)) {
+            return;
+        }
+        if (!admitWork({html}, options, callback)) {
+            g_rateLimiter->refund(client.id, 1, tokens);  // refused work does not use up the quota
+            return;
+        }
         
-        auto resp = HttpResponse::newHttpJsonResponse(response);
-        callback(resp);
+        // options holds the admission ticket until the job finishes
+        auto job = [html = std::move(html), direction, maxTokens, formal,
+                    glossary = std::move(glossary), options, callback]() {
+            try {
+                std::string result = g_translator->translateHtml(html, direction, maxTokens, formal, glossary);
+                
+                Json::Value response;
+                response["provider"] = "nllb-ct2-int8";
+                response["direction"] = direction;
+                response["html"] = result;
+                
+                callback(HttpResponse::newHttpJsonResponse(response));
+            } catch (const std::exception& e) {
+                Json::Value error;
+                error["error"] = e.what();
+                auto resp = HttpResponse::newHttpJsonResponse(error);
+                resp->setStatusCode(k500InternalServerError);
+                callback(resp);
+            }
+        };
+        enqueueRequest(client, tokens, std::move(job), callback);
         
     } catch (const std::exception& e) {
         Json::Value error;
@@ -268,33 +663,152 @@ void translateHtmlHandler(const HttpRequestPtr& req, std::function<void(const Ht
         callback(resp);
     }
 }
+
+// Per-client usage: admitted/rejected requests, texts, tokens and bucket levels
+void clientStatsHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpResponsePtr&)>&& callback) {
+    Json::Value response;
+    response["rate_limit_enabled"] = g_rateLimiter->enabled();
+    
+    auto queue = g_fairQueue->getStats();
+    response["queue"]["queued"] = static_cast<Json::UInt64>(queue.queued);
+    response["queue"]["running"] = static_cast<Json::UInt64>(queue.running);
+    response["queue"]["dispatched"] = static_cast<Json::UInt64>(queue.dispatched);
+    response["queue"]["rejected"] = static_cast<Json::UInt64>(queue.rejected);
+    
+    response["clients"] = Json::Value(Json::arrayValue);
+    for (const auto& client : g_rateLimiter->getClientStats()) {
+        Json::Value entry;
+        entry["client"] = displayClient(client.client);
+        entry["requests"] = static_cast<Json::UInt64>(client.requests);
+        entry["rejected"] = static_cast<Json::UInt64>(client.rejected);
+        entry["texts"] = static_cast<Json::UInt64>(client.texts);
+        entry["tokens"] = static_cast<Json::UInt64>(client.tokens);
+        entry["queued"] = static_cast<Json::UInt64>(g_fairQueue->queuedFor(client.client));
+        if (g_rateLimiter->enabled()) {
+            entry["texts_available"] = client.textsAvailable;
+            entry["tokens_available"] = client.tokensAvailable;
+        }
+        response["clients"].append(entry);
+    }
+    
+    callback(HttpResponse::newHttpJsonResponse(response));
+}
+
+// Latency and throughput percentiles: end to end and per pipeline stage
+void latencyStatsHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpResponsePtr&)>&& callback) {
+    Json::Value response(Json::objectValue);
+    for (const auto& series : g_translator->getMetricsSnapshot().series) {
+        const auto& summary = series.summary;
+        Json::Value entry;
+        entry["unit"] = series.unit;
+        entry["count"] = static_cast<Json::UInt64>(summary.count);
+        entry["mean"] = summary.mean;
+        entry["p50"] = summary.p50;
+        entry["p90"] = summary.p90;
+        entry["p99"] = summary.p99;
+        entry["p999"] = summary.p999;
+        entry["max"] = summary.max;
+        response[series.name] = entry;
+    }
+    callback(HttpResponse::newHttpJsonResponse(response));
+}
+
+// Last slow requests with their stage breakdown (text redacted unless slow_request_log_text)
+void slowRequestsHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpResponsePtr&)>&& callback) {
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setContentTypeCode(CT_APPLICATION_JSON);
+    resp->setBody(g_translator->getSlowRequestLog().toJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+    callback(resp);
+}
+
+// Prometheus scrape target
+void metricsHandler(const HttpRequestPtr& /*req*/, std::function<void(const HttpResponsePtr&)>&& callback) {
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setContentTypeCode(CT_TEXT_PLAIN);
+    resp->setBody(g_metrics->render(g_translator->getHealthInfo(), g_translator->getMetricsSnapshot()));
+    callback(resp);
+}
+
+// Count every response once it is sent, whichever handler or error path produced it
+static void countResponse(const HttpRequestPtr& req, const HttpResponsePtr& resp) {
+    std::string direction;
+    if (req->path().rfind("/translate", 0) == 0) {
+        auto json = req->getJsonObject();
+        direction = json && json->isObject() ? json->get("direction", "es-da").asString() : "invalid";
+    }
+    g_metrics->recordRequest(req->path(), direction, static_cast<int>(resp->statusCode()));
+}
 #endif
 
 int main(int argc, char* argv[]) {
 #ifdef DROGON_FOUND
-    std::cout << "Starting REST API server..." << std::endl;
-    
     // Load configuration
     traductor::Config config;
+    traductor::Logger::instance().configure(traductor::Logger::Options::fromConfig(config));
+    TRADUCTOR_LOG(Info, "rest") << "Starting REST API server...";
     
     // Initialize translator
     g_translator = std::make_unique<traductor::TranslatorEngine>(config);
     
     if (!g_translator->initialize()) {
         auto health = g_translator->getHealthInfo();
-        std::cerr << "Failed to initialize translator: " << health.lastError << std::endl;
+        TRADUCTOR_LOG(Error, "rest") << "Failed to initialize translator: " << health.lastError;
         return 1;
     }
     
-    std::cout << "Translator initialized successfully" << std::endl;
+    TRADUCTOR_LOG(Info, "rest") << "Translator initialized successfully";
+    
+    // Admission in front of the engine: per-client token buckets, then a weighted
+    // fair queue feeding a few REST workers (the engine schedules their batches)
+    g_config = &config;
+    traductor::RateLimiter::Options limits;
+    limits.enabled = config.rateLimitEnabled();
+    limits.textsPerSecond = config.rateLimitTextsPerSec();
+    limits.textsBurst = config.rateLimitTextsBurst();
+    limits.tokensPerSecond = config.rateLimitTokensPerSec();
+    limits.tokensBurst = config.rateLimitTokensBurst();
+    g_rateLimiter = std::make_unique<traductor::RateLimiter>(limits);
+    
+    // Keep the HTTP IO threads off the replica cores. The replicas are already
+    // running, so only threads created from here on (Drogon's, the REST workers)
+    // inherit this mask.
+    auto inferenceCores = g_translator->getInferenceCores();
+    if (!inferenceCores.empty()) {
+        std::vector<int> ioCores;
+        for (int core = 0; core < traductor::CpuInfo::logicalCores(); ++core) {
+            if (std::find(inferenceCores.begin(), inferenceCores.end(), core) == inferenceCores.end()) {
+                ioCores.push_back(core);
+            }
+        }
+        if (!ioCores.empty() && traductor::CpuInfo::pinCurrentThread(ioCores)) {
+            TRADUCTOR_LOG(Info, "rest") << "REST IO threads restricted to " << ioCores.size() << " cores";
+        } else {
+            TRADUCTOR_LOG(Warning, "rest") << "No free cores left for REST IO threads";
+        }
+    }
+    
+    // Created after pinning, so the REST workers share the IO cores
+    g_fairQueue = std::make_unique<traductor::FairQueue>(
+        static_cast<size_t>(std::max(1, config.restWorkers())),
+        static_cast<size_t>(std::max(1, config.restQueueCapacity())));
+    
+    // The routes registered below; any other path is counted as "other"
+    g_metrics = std::make_unique<traductor::MetricsExporter>(std::vector<std::string>{
+        "/health", "/translate", "/translate/html", "/stats/clients", "/stats/latency", "/metrics", "/debug/slow"});
     
     // Configure Drogon
     app().setLogLevel(trantor::Logger::kInfo);
+    app().setThreadNum(static_cast<size_t>(std::max(1, config.restIoThreads())));
     
     // Set up routes
     app().registerHandler("/health", &healthHandler, {Get});
     app().registerHandler("/translate", &translateHandler, {Post});
     app().registerHandler("/translate/html", &translateHtmlHandler, {Post});
+    app().registerHandler("/stats/clients", &clientStatsHandler, {Get});
+    app().registerHandler("/stats/latency", &latencyStatsHandler, {Get});
+    app().registerHandler("/metrics", &metricsHandler, {Get});
+    app().registerHandler("/debug/slow", &slowRequestsHandler, {Get});
+    app().registerPostHandlingAdvice(&countResponse);
     
     // Set server address and port from config
     app()
@@ -302,18 +816,19 @@ int main(int argc, char* argv[]) {
         .addListener(config.host(), config.port())
         .run();
 #else
-    std::cout << "REST Server - Drogon not found, using stub implementation" << std::endl;
-    
     traductor::Config config;
+    traductor::Logger::instance().configure(traductor::Logger::Options::fromConfig(config));
+    TRADUCTOR_LOG(Info, "rest") << "REST Server - Drogon not found, using stub implementation";
+    
     traductor::rest::RestServer server(config);
     
     if (!server.initialize()) {
-        std::cerr << "Failed to initialize server" << std::endl;
+        TRADUCTOR_LOG(Error, "rest") << "Failed to initialize server";
         return 1;
     }
     
-    std::cout << "Server stub initialized successfully" << std::endl;
-    std::cout << "Note: Install Drogon for full REST server functionality." << std::endl;
+    TRADUCTOR_LOG(Info, "rest") << "Server stub initialized successfully";
+    TRADUCTOR_LOG(Info, "rest") << "Note: Install Drogon for full REST server functionality.";
 #endif
     
     return 0;
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "../core/AdmissionController.h"
+#include <thread>
+
+using traductor::AdmissionController;
+
+class AdmissionControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        options_.enabled = true;
+        options_.deadlineSeconds = 10.0;
+        options_.initialThroughput = 100.0;  // 1000 tokens fit in the deadline
+    }
+    
+    AdmissionController::Options options_;
+};
+
+// Test refusal once the backlog would push a request past its deadline
+TEST_F(AdmissionControllerTest, RefusesWhenBacklogTooLong) {
+    AdmissionController controller(options_);
+    
+    auto first = controller.admit(600);
+    ASSERT_TRUE(first.admitted());
+    EXPECT_DOUBLE_EQ(first.predictedSeconds, 6.0);
+    
+    auto second = controller.admit(600);
+    EXPECT_FALSE(second.admitted());
+    EXPECT_EQ(second.reason, AdmissionController::Reason::Overloaded);
+    EXPECT_EQ(second.retryAfterSeconds, 2);
+    
+    // Small requests still fit
+    auto third = controller.admit(300);
+    EXPECT_TRUE(third.admitted());
+    
+    auto stats = controller.getStats();
+    EXPECT_EQ(stats.backlogTokens, 900u);
+    EXPECT_EQ(stats.inFlight, 2u);
+    EXPECT_EQ(stats.rejectedOverloaded, 1u);
+}
+
+// Test that finished requests release their backlog
+TEST_F(AdmissionControllerTest, TicketReleasesBacklog) {
+    AdmissionController controller(options_);
+    {
+        auto decision = controller.admit(900);
+        ASSERT_TRUE(decision.admitted());
+        EXPECT_FALSE(controller.admit(500).admitted());
+    }
+    EXPECT_EQ(controller.getStats().backlogTokens, 0u);
+    EXPECT_TRUE(controller.admit(500).admitted());
+}
+
+// Test requests that cannot meet the deadline even on an idle server
+TEST_F(AdmissionControllerTest, TooLargeAndDisabled) {
+    AdmissionController controller(options_);
+    auto decision = controller.admit(5000);
+    EXPECT_FALSE(decision.admitted());
+    EXPECT_EQ(decision.reason, AdmissionController::Reason::TooLarge);
+    EXPECT_STREQ(AdmissionController::reasonName(decision.reason), "too_large");
+    
+    options_.enabled = false;
+    AdmissionController disabled(options_);
+    EXPECT_TRUE(disabled.admit(5000).admitted());
+    EXPECT_EQ(disabled.getStats().admitted, 1u);
+}
+
+// Test that only completed work feeds the throughput sample, while every
+// ticket still releases its backlog
+TEST_F(AdmissionControllerTest, ThroughputCountsCompletedTokensOnly) {
+    options_.minSampleSeconds = 0.02;
+    AdmissionController controller(options_);
+    {
+        // Cancelled, failed or served from the cache: nothing completed
+        auto decision = controller.admit(500);
+        ASSERT_TRUE(decision.admitted());
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+    auto stats = controller.getStats();
+    EXPECT_EQ(stats.backlogTokens, 0u);
+    EXPECT_DOUBLE_EQ(stats.throughput, 100.0);
+    
+    {
+        auto decision = controller.admit(500);
+        ASSERT_TRUE(decision.admitted());
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        decision.ticket->setCompletedTokens(500);
+    }
+    stats = controller.getStats();
+    EXPECT_EQ(stats.backlogTokens, 0u);
+    EXPECT_GT(stats.throughput, 100.0);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../core/DegradationController.h"
+
+using traductor::DegradationController;
+
+class DegradationControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        options_.enabled = true;
+        options_.degradeQueueDepth = 8;
+        options_.degradeLatencyMs = 1000.0;
+        options_.recoverQueueDepth = 2;
+        options_.recoverLatencyMs = 400.0;
+        options_.holdTime = std::chrono::milliseconds(100);
+        options_.beamSteps = {2, 1};
+    }
+    
+    DegradationController::Options options_;
+    DegradationController::Clock::time_point t0_ = DegradationController::Clock::now();
+    
+    DegradationController::Clock::time_point at(int ms) const {
+        return t0_ + std::chrono::milliseconds(ms);
+    }
+};
+
+// Test stepping down one level per hold period under queue pressure
+TEST_F(DegradationControllerTest, DegradesInSteps) {
+    DegradationController controller(options_);
+    EXPECT_FALSE(controller.current().degraded());
+    
+    controller.observe(20, 100.0, at(0));
+    EXPECT_EQ(controller.current().maxBeam, 2);
+    
+    // Still inside the hold time: no further change
+    controller.observe(20, 100.0, at(50));
+    EXPECT_EQ(controller.current().index, 1);
+    
+    controller.observe(20, 100.0, at(200));
+    EXPECT_EQ(controller.current().label(), "greedy");
+    
+    // No small model configured: greedy is the last level
+    controller.observe(20, 100.0, at(400));
+    EXPECT_EQ(controller.current().index, 2);
+    
+    controller.setSmallModelAvailable(true);
+    controller.observe(20, 100.0, at(600));
+    EXPECT_TRUE(controller.current().useSmallModel);
+}
+
+// Test that recovery needs both signals below the lower thresholds
+TEST_F(DegradationControllerTest, RecoversWithHysteresis) {
+    DegradationController controller(options_);
+    controller.observe(20, 100.0, at(0));
+    ASSERT_EQ(controller.current().index, 1);
+    
+    // Between the recover and degrade thresholds: stay degraded
+    controller.observe(5, 100.0, at(200));
+    EXPECT_EQ(controller.current().index, 1);
+    
+    controller.observe(1, 100.0, at(400));
+    EXPECT_EQ(controller.current().index, 0);
+    EXPECT_EQ(controller.getStats().levelChanges, 2);
+}
+
+// Test that slow requests alone trigger degradation
+TEST_F(DegradationControllerTest, LatencyTriggers) {
+    DegradationController controller(options_);
+    controller.observe(0, 5000.0, at(0));
+    EXPECT_TRUE(controller.current().degraded());
+    
+    options_.enabled = false;
+    DegradationController disabled(options_);
+    disabled.observe(100, 5000.0, at(0));
+    EXPECT_FALSE(disabled.current().degraded());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../core/FairQueue.h"
+#include <future>
+
+using traductor::FairQueue;
+
+class FairQueueTest : public ::testing::Test {
+protected:
+    // Occupy the single worker so the queue fills up before anything is dispatched
+    void blockWorker(FairQueue& queue) {
+        auto started = std::make_shared<std::promise<void>>();
+        auto startedFuture = started->get_future();
+        queue.submit("blocker", 1.0, 1.0, [this, started] {
+            started->set_value();
+            release_.get_future().wait();
+        });
+        startedFuture.wait();
+    }
+    
+    // Release the worker and wait until the queued jobs have run
+    std::vector<std::string> run(size_t jobs) {
+        std::promise<void> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            remaining_ = jobs;
+            done_ = &done;
+        }
+        release_.set_value();
+        done.get_future().wait();
+        return order_;
+    }
+    
+    FairQueue::Job record(const std::string& name) {
+        return [this, name] {
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(name);
+            if (--remaining_ == 0) {
+                done_->set_value();
+            }
+        };
+    }
+    
+    std::promise<void> release_;
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+    size_t remaining_ = 0;
+    std::promise<void>* done_ = nullptr;
+};
+
+// Test that a client flooding the queue is interleaved with a later one
+TEST_F(FairQueueTest, InterleavesClients) {
+    FairQueue queue(1, 16);
+    blockWorker(queue);
+    for (int i = 1; i <= 3; ++i) {
+        queue.submit("flood", 1.0, 1.0, record("F" + std::to_string(i)));
+    }
+    for (int i = 1; i <= 3; ++i) {
+        queue.submit("chat", 1.0, 1.0, record("C" + std::to_string(i)));
+    }
+    EXPECT_EQ(queue.queuedFor("flood"), 3u);
+    
+    auto order = run(6);
+    EXPECT_EQ(order, (std::vector<std::string>{"F1", "C1", "F2", "C2", "F3", "C3"}));
+}
+
+// Test that weights and costs shape the service order
+TEST_F(FairQueueTest, WeightedOrder) {
+    FairQueue queue(1, 16);
+    blockWorker(queue);
+    for (int i = 1; i <= 3; ++i) {
+        queue.submit("gold", 2.0, 10.0, record("G" + std::to_string(i)));
+    }
+    for (int i = 1; i <= 3; ++i) {
+        queue.submit("std", 1.0, 10.0, record("S" + std::to_string(i)));
+    }
+    
+    auto order = run(6);
+    EXPECT_EQ(order, (std::vector<std::string>{"G1", "G2", "S1", "G3", "S2", "S3"}));
+}
+
+// Test capacity limit and stats
+TEST_F(FairQueueTest, RejectsWhenFull) {
+    FairQueue queue(1, 2);
+    blockWorker(queue);
+    EXPECT_TRUE(queue.submit("a", 1.0, 1.0, record("A1")));
+    EXPECT_TRUE(queue.submit("a", 1.0, 1.0, record("A2")));
+    EXPECT_FALSE(queue.submit("b", 1.0, 1.0, record("B1")));
+    
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.queued, 2u);
+    EXPECT_EQ(stats.running, 1u);
+    EXPECT_EQ(stats.rejected, 1u);
+    
+    run(2);
+    EXPECT_EQ(queue.getStats().dispatched, 3u);
+}
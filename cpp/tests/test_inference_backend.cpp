@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "../core/MockBackend.h"
+#include "../core/TranslatorEngine.h"
+#include "../core/Config.h"
+#include <chrono>
+#include <thread>
+
+using traductor::InferenceBackend;
+using traductor::MockBackend;
+
+// Test that the mock echoes its input, honours the length cap and scores
+TEST(InferenceBackendTest, MockEchoesDeterministically) {
+    MockBackend backend;
+    InferenceBackend::Options options;
+    options.maxDecodingLength = 3;
+    options.returnScores = true;
+
+    auto results = backend.translateBatch({{10, 11, 12, 13}, {20}}, "dan_Latn", options);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].ids, (std::vector<int>{10, 11, 12}));
+    EXPECT_EQ(results[1].ids, (std::vector<int>{20}));
+    ASSERT_TRUE(results[0].hasScore);
+    EXPECT_FLOAT_EQ(results[0].score, -0.3f);
+    EXPECT_EQ(backend.calls(), 1u);
+    EXPECT_EQ(backend.sequences(), 2u);
+
+    // The step callback stops a sequence at the token it returns true for
+    options.maxDecodingLength = 256;
+    options.stepCallback = [](size_t sequence, int tokenId) { return sequence == 0 && tokenId == 11; };
+    results = backend.translateBatch({{10, 11, 12, 13}, {20, 21}}, "dan_Latn", options);
+    EXPECT_EQ(results[0].ids, (std::vector<int>{10, 11}));
+    EXPECT_EQ(results[1].ids, (std::vector<int>{20, 21}));
+}
+
+// Test the latency model: per call, per step and per active sequence, times the beam
+TEST(InferenceBackendTest, MockLatency) {
+    MockBackend::Options latency;
+    latency.batchLatency = std::chrono::microseconds(1000);
+    latency.stepLatency = std::chrono::microseconds(100);
+    latency.tokenLatency = std::chrono::microseconds(10);
+    MockBackend backend(latency);
+
+    InferenceBackend::Options options;
+    std::vector<std::vector<int>> sources = {{1, 2, 3, 4}, {1, 2}};
+    // 1000 + 2 steps x (100 + 2 x 10) + 2 steps x (100 + 1 x 10)
+    EXPECT_EQ(backend.expectedLatency(sources, options).count(), 1460);
+    options.beamSize = 2;
+    EXPECT_EQ(backend.expectedLatency(sources, options).count(), 1920);
+
+    auto start = std::chrono::steady_clock::now();
+    backend.translateBatch(sources, "dan_Latn", options);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(1920));
+}
+
+// Test the engine end to end on the mock backend, from several threads
+TEST(InferenceBackendTest, EngineOnMock) {
+    traductor::Config config;
+    config.setInferenceBackend("mock");
+    config.setMockLatencyUs(500, 20, 2);
+    traductor::TranslatorEngine engine(config);
+    ASSERT_TRUE(engine.initialize());
+
+    auto health = engine.getHealthInfo();
+    EXPECT_TRUE(health.modelLoaded);
+    EXPECT_EQ(health.inferenceBackend, "mock");
+
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(4);
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&engine, &results, t]() {
+            results[t] = engine.translate("Buenos días número " + std::to_string(t), "es-da");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < results.size(); ++t) {
+        // Without a SentencePiece model the mock's output is the source text
+        EXPECT_NE(results[t].find("número " + std::to_string(t)), std::string::npos) << results[t];
+    }
+
+    health = engine.getHealthInfo();
+    EXPECT_GT(health.tokensOut, 0u);
+    EXPECT_GE(health.batchesCompleted, 1u);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "../core/InferencePipeline.h"
+#include <chrono>
+#include <future>
+#include <thread>
+
+using traductor::InferencePipeline;
+using traductor::Priority;
+
+namespace {
+
+std::unique_ptr<InferencePipeline::Batch> makeBatch(const std::string& source, Priority priority) {
+    auto batch = std::make_unique<InferencePipeline::Batch>();
+    batch->sources = {source};
+    batch->settings.priority = priority;
+    return batch;
+}
+
+} // namespace
+
+// Test that a long bulk decode in flight, a bulk launch stuck on a full replica
+// queue and a bulk batch stuck in preprocessing (as when the next bulk lane is
+// full) do not hold back an interactive batch submitted after them
+TEST(InferencePipelineTest, BulkDoesNotBlockInteractive) {
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> decoding;
+
+    InferencePipeline::Stages stages;
+    stages.preprocess = [&](InferencePipeline::Batch& batch) {
+        if (batch.sources[0] == "bulk-tokenize") {
+            gate.wait();
+        }
+    };
+    stages.launch = [&](InferencePipeline::Batch& batch) {
+        if (batch.sources[0] == "bulk-decode") {
+            // Asynchronous model call that runs until the gate opens
+            batch.await = [gate](InferencePipeline::Batch&) { gate.wait(); };
+            decoding.set_value();
+        } else if (batch.sources[0] == "bulk-queued") {
+            gate.wait();  // as ReplicaPool::submit while the bulk lane is full
+        }
+    };
+    stages.complete = [](InferencePipeline::Batch& batch) {
+        batch.translations = {batch.sources[0] + " done"};
+    };
+    InferencePipeline pipeline(std::move(stages), 4);
+
+    auto bulkDecode = pipeline.submit(makeBatch("bulk-decode", Priority::Bulk));
+    decoding.get_future().wait();
+    auto bulkQueued = pipeline.submit(makeBatch("bulk-queued", Priority::Bulk));
+    auto bulkTokenize = pipeline.submit(makeBatch("bulk-tokenize", Priority::Bulk));
+    auto interactive = pipeline.submit(makeBatch("interactive", Priority::Interactive));
+
+    auto interactiveStatus = interactive.wait_for(std::chrono::seconds(5));
+    auto bulkDecodeStatus = bulkDecode.wait_for(std::chrono::milliseconds(0));
+    auto bulkQueuedStatus = bulkQueued.wait_for(std::chrono::milliseconds(0));
+    release.set_value();  // before any check, so a failure cannot hang the pipeline's shutdown
+
+    ASSERT_EQ(interactiveStatus, std::future_status::ready);
+    EXPECT_EQ(bulkDecodeStatus, std::future_status::timeout);
+    EXPECT_EQ(bulkQueuedStatus, std::future_status::timeout);
+    EXPECT_EQ(interactive.get(), std::vector<std::string>{"interactive done"});
+    EXPECT_EQ(bulkDecode.get(), std::vector<std::string>{"bulk-decode done"});
+    EXPECT_EQ(bulkQueued.get(), std::vector<std::string>{"bulk-queued done"});
+    EXPECT_EQ(bulkTokenize.get(), std::vector<std::string>{"bulk-tokenize done"});
+    EXPECT_EQ(pipeline.getStats().batchesCompleted, 4u);
+}
+
+// Test that a cancelled batch gives up its queue slot as soon as a push needs it,
+// even while the stage that would pop it is busy
+TEST(InferencePipelineTest, CancelledBatchFreesQueueSlot) {
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> busy;
+
+    InferencePipeline::Stages stages;
+    stages.preprocess = [&](InferencePipeline::Batch& batch) {
+        if (batch.sources[0] == "blocker") {
+            busy.set_value();
+            gate.wait();
+        }
+    };
+    stages.launch = [](InferencePipeline::Batch&) {};
+    stages.complete = [](InferencePipeline::Batch& batch) { batch.translations = batch.sources; };
+    InferencePipeline pipeline(std::move(stages), 1);
+
+    auto blocker = pipeline.submit(makeBatch("blocker", Priority::Interactive));
+    busy.get_future().wait();
+
+    auto cancelledBatch = makeBatch("cancelled", Priority::Interactive);
+    auto token = std::make_shared<traductor::CancellationToken>();
+    cancelledBatch->settings.cancel = token;
+    auto cancelled = pipeline.submit(std::move(cancelledBatch));  // takes the lane's only slot
+    token->cancel();
+
+    // Blocks until the cancelled batch is dropped from the full lane
+    auto next = std::async(std::launch::async, [&] { return pipeline.submit(makeBatch("next", Priority::Interactive)); });
+    auto nextStatus = next.wait_for(std::chrono::seconds(5));
+    auto cancelledStatus = cancelled.wait_for(std::chrono::milliseconds(0));
+    release.set_value();  // before any check, so a failure cannot hang the pipeline's shutdown
+
+    ASSERT_EQ(nextStatus, std::future_status::ready);
+    ASSERT_EQ(cancelledStatus, std::future_status::ready);
+    EXPECT_THROW(cancelled.get(), traductor::OperationCancelled);
+    EXPECT_EQ(blocker.get(), std::vector<std::string>{"blocker"});
+    EXPECT_EQ(next.get().get(), std::vector<std::string>{"next"});
+    EXPECT_EQ(pipeline.getStats().batchesCancelled, 1u);
+}
+
+// Test that a stopped batch whose model call is still running is not dropped by
+// the inference stage's push: the completion stage waits for the call instead
+TEST(InferencePipelineTest, InFlightBatchAwaitedByCompletionStage) {
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> awaitingFirst;
+    std::promise<void> launchedLast;
+    std::thread::id launchThread;
+    std::thread::id awaitThread;
+
+    InferencePipeline::Stages stages;
+    stages.preprocess = [](InferencePipeline::Batch&) {};
+    stages.launch = [&](InferencePipeline::Batch& batch) {
+        const std::string& source = batch.sources[0];
+        if (source == "first") {
+            batch.await = [&, gate](InferencePipeline::Batch&) {
+                awaitingFirst.set_value();
+                gate.wait();
+            };
+        } else if (source == "stopped") {
+            launchThread = std::this_thread::get_id();
+            batch.await = [&, gate](InferencePipeline::Batch&) {
+                awaitThread = std::this_thread::get_id();
+                gate.wait();  // as a beam search, which does not stop early
+            };
+        } else {
+            launchedLast.set_value();
+        }
+    };
+    stages.complete = [](InferencePipeline::Batch& batch) { batch.translations = batch.sources; };
+    InferencePipeline pipeline(std::move(stages), 1);
+
+    auto first = pipeline.submit(makeBatch("first", Priority::Interactive));
+    awaitingFirst.get_future().wait();  // the completion stage is busy
+
+    auto stoppedBatch = makeBatch("stopped", Priority::Interactive);
+    auto token = std::make_shared<traductor::CancellationToken>();
+    stoppedBatch->settings.cancel = token;
+    auto stopped = pipeline.submit(std::move(stoppedBatch));  // launched, then fills the completion lane
+    auto last = pipeline.submit(makeBatch("last", Priority::Interactive));
+    launchedLast.get_future().wait();
+    token->cancel();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));  // let "last" push into the full lane
+    release.set_value();
+
+    EXPECT_THROW(stopped.get(), traductor::OperationCancelled);
+    EXPECT_EQ(first.get(), std::vector<std::string>{"first"});
+    EXPECT_EQ(last.get(), std::vector<std::string>{"last"});
+    EXPECT_NE(awaitThread, std::thread::id());
+    EXPECT_NE(awaitThread, launchThread);
+    EXPECT_EQ(pipeline.getStats().batchesCancelled, 1u);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "../core/LatencyHistogram.h"
+#include <thread>
+#include <vector>
+
+using traductor::LatencyHistogram;
+
+// Test that bucket bounds are monotonic and keep values within 1/16
+TEST(LatencyHistogramTest, BucketPrecision) {
+    for (uint64_t value : std::vector<uint64_t>{0, 1, 15, 16, 17, 1000, 123456789, UINT64_MAX}) {
+        size_t bucket = LatencyHistogram::bucketFor(value);
+        ASSERT_LT(bucket, LatencyHistogram::kBuckets);
+        uint64_t low = LatencyHistogram::bucketLowerBound(bucket);
+        EXPECT_LE(low, value);
+        EXPECT_LE(value - low, low / 16 + 1);
+    }
+    for (size_t bucket = 1; bucket < LatencyHistogram::kBuckets; ++bucket) {
+        EXPECT_LT(LatencyHistogram::bucketLowerBound(bucket - 1), LatencyHistogram::bucketLowerBound(bucket));
+    }
+}
+
+// Test that percentiles show the tail a mean would hide
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(1000);  // 1 ms
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(500000);  // 500 ms
+    }
+
+    auto summary = histogram.summary(0.001);
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_NEAR(summary.p50, 1.0, 0.07);
+    EXPECT_NEAR(summary.p90, 1.0, 0.07);
+    EXPECT_NEAR(summary.p999, 500.0, 500.0 / 16);
+    EXPECT_DOUBLE_EQ(summary.min, 1.0);
+    EXPECT_DOUBLE_EQ(summary.max, 500.0);
+    EXPECT_NEAR(summary.mean, 5.99, 0.01);
+
+    EXPECT_EQ(LatencyHistogram().summary().p99, 0.0);
+}
+
+// Test that concurrent writers lose no samples
+TEST(LatencyHistogramTest, ConcurrentRecord) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&histogram, t] {
+            for (int i = 0; i < 10000; ++i) {
+                histogram.record(static_cast<uint64_t>(t * 100 + i % 50));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    auto summary = histogram.summary();
+    EXPECT_EQ(summary.count, 40000u);
+    EXPECT_DOUBLE_EQ(summary.min, 0.0);
+    EXPECT_DOUBLE_EQ(summary.max, 349.0);
+}
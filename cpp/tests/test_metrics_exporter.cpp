@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../core/MetricsExporter.h"
+#include "../core/Config.h"
+#include <set>
+#include <sstream>
+
+using traductor::MetricsExporter;
+
+class MetricsExporterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        engine_ = std::make_unique<traductor::TranslatorEngine>(config_);
+        ASSERT_TRUE(engine_->initialize());
+    }
+    
+    std::string render() {
+        return exporter_.render(engine_->getHealthInfo(), engine_->getMetricsSnapshot());
+    }
+    
+    traductor::Config config_;
+    std::unique_ptr<traductor::TranslatorEngine> engine_;
+    MetricsExporter exporter_{{"/translate", "/metrics"}};
+};
+
+// Test request counters by endpoint, direction and status
+TEST_F(MetricsExporterTest, RequestCounters) {
+    exporter_.recordRequest("/translate", "es-da", 200);
+    exporter_.recordRequest("/translate", "es-da", 200);
+    exporter_.recordRequest("/translate", "da-es", 429);
+    
+    std::string text = render();
+    EXPECT_NE(text.find("# TYPE traductor_http_requests_total counter"), std::string::npos);
+    EXPECT_NE(text.find("traductor_http_requests_total{endpoint=\"/translate\",direction=\"es-da\",status=\"200\"} 2"),
+              std::string::npos);
+    EXPECT_NE(text.find("status=\"429\"} 1"), std::string::npos);
+}
+
+// Test that client-supplied paths and directions map to a fixed label set
+TEST_F(MetricsExporterTest, RequestLabelsAreBounded) {
+    exporter_.recordRequest("/metrics", "", 200);
+    exporter_.recordRequest("/no/such/route?x=1", "", 404);
+    exporter_.recordRequest("/wp-login.php", "", 404);
+    exporter_.recordRequest("/translate", "xx-yy", 400);
+    exporter_.recordRequest("/translate", "en-fr", 400);
+    
+    std::string text = render();
+    EXPECT_NE(text.find("traductor_http_requests_total{endpoint=\"/metrics\",direction=\"\",status=\"200\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("traductor_http_requests_total{endpoint=\"other\",direction=\"\",status=\"404\"} 2"),
+              std::string::npos);
+    EXPECT_NE(text.find("traductor_http_requests_total{endpoint=\"/translate\",direction=\"invalid\",status=\"400\"} 2"),
+              std::string::npos);
+    EXPECT_EQ(text.find("wp-login"), std::string::npos);
+    EXPECT_EQ(text.find("xx-yy"), std::string::npos);
+}
+
+// Test that latency histograms are cumulative and end in +Inf = count
+TEST_F(MetricsExporterTest, Histograms) {
+    engine_->translate(std::vector<std::string>{"Hola mundo", "Buenos días"}, "es-da");
+    
+    std::string text = render();
+    EXPECT_NE(text.find("# TYPE traductor_request_duration_seconds histogram"), std::string::npos);
+    EXPECT_NE(text.find("traductor_request_duration_seconds_bucket{le=\"+Inf\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("traductor_request_duration_seconds_count 1\n"), std::string::npos);
+    EXPECT_NE(text.find("traductor_stage_duration_seconds_bucket{stage=\"inference\",le=\"0.0001\"}"), std::string::npos);
+    EXPECT_NE(text.find("traductor_tokens_total{kind=\"generated\"}"), std::string::npos);
+    EXPECT_NE(text.find("traductor_cache_misses_total{tier=\"translation\"} 2"), std::string::npos);
+    EXPECT_NE(text.find("traductor_model_load_seconds"), std::string::npos);
+}
+
+// Test that every family's samples come right after its own HELP/TYPE lines
+TEST_F(MetricsExporterTest, FamiliesAreContiguous) {
+    engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da");
+    
+    std::istringstream lines(render());
+    std::string line;
+    std::string family;
+    std::set<std::string> seen;
+    while (std::getline(lines, line)) {
+        if (line.rfind("# TYPE ", 0) == 0) {
+            std::istringstream fields(line.substr(7));
+            fields >> family;
+            EXPECT_TRUE(seen.insert(family).second) << "family described twice: " << family;
+        } else if (!line.empty() && line[0] != '#') {
+            std::string name = line.substr(0, line.find_first_of("{ "));
+            for (const char* suffix : {"_bucket", "_sum", "_count"}) {
+                if (name != family && name.size() > family.size() && name.compare(0, family.size(), family) == 0 &&
+                    name.substr(family.size()) == suffix) {
+                    name = family;
+                }
+            }
+            EXPECT_EQ(name, family) << line;
+        }
+    }
+    EXPECT_TRUE(seen.count("traductor_stage_duration_seconds"));
+}
+
+#ifdef __linux__
+// Test process RSS
+TEST_F(MetricsExporterTest, ResidentMemory) {
+    EXPECT_GT(MetricsExporter::residentMemoryBytes(), 1024u * 1024u);
+}
+#endif
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "../core/ModelRouter.h"
+
+using traductor::ModelRouter;
+
+class ModelRouterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        options_.enabled = true;
+        options_.maxTokens = 4;
+        options_.maxSimpleTokens = 24;
+        options_.minSimplicity = 0.9;
+        options_.minScore = -1.5f;
+    }
+    
+    ModelRouter::Options options_;
+};
+
+// Test that nothing is routed to the small model until it is loaded
+TEST_F(ModelRouterTest, InactiveWithoutSmallModel) {
+    ModelRouter router(options_);
+    EXPECT_FALSE(router.active());
+    EXPECT_EQ(router.route("Gracias"), ModelRouter::Model::Large);
+    
+    router.setSmallModelAvailable(true);
+    EXPECT_TRUE(router.active());
+    EXPECT_EQ(router.route("Gracias"), ModelRouter::Model::Small);
+    
+    options_.enabled = false;
+    ModelRouter disabled(options_);
+    disabled.setSmallModelAvailable(true);
+    EXPECT_EQ(disabled.route("Gracias"), ModelRouter::Model::Large);
+}
+
+// Test routing by length, simplicity and markers
+TEST_F(ModelRouterTest, RoutesShortAndSimpleSegments) {
+    ModelRouter router(options_);
+    router.setSmallModelAvailable(true);
+    
+    EXPECT_EQ(router.route("Hola, buenos días."), ModelRouter::Model::Small);
+    EXPECT_EQ(router.route("Muchas gracias por su ayuda con el pedido de ayer."),
+              ModelRouter::Model::Small);
+    EXPECT_EQ(router.route("Factura 2024/0117: importe 1.250,00 EUR (IVA 21%) ref #A-77"),
+              ModelRouter::Model::Large);
+    EXPECT_EQ(router.route("Gracias [[TERM::0]]"), ModelRouter::Model::Large);
+    
+    std::string longText;
+    for (int i = 0; i < 20; ++i) {
+        longText += "La reunión del comité se aplaza hasta el próximo lunes. ";
+    }
+    EXPECT_EQ(router.route(longText), ModelRouter::Model::Large);
+    
+    EXPECT_DOUBLE_EQ(ModelRouter::simplicity("Hola mundo"), 1.0);
+    EXPECT_LT(ModelRouter::simplicity("{\"id\": 42}"), 0.9);
+}
+
+// Test escalation threshold and per-model statistics
+TEST_F(ModelRouterTest, EscalationAndStats) {
+    ModelRouter router(options_);
+    EXPECT_TRUE(router.shouldEscalate(-2.0f));
+    EXPECT_FALSE(router.shouldEscalate(-0.5f));
+    
+    EXPECT_EQ(router.getStats().size(), 1u);
+    router.setSmallModelAvailable(true);
+    
+    router.record(ModelRouter::Model::Small, 8, 10.0);
+    router.record(ModelRouter::Model::Small, 4, 20.0);
+    router.record(ModelRouter::Model::Large, 2, 50.0);
+    router.recordEscalations(2);
+    
+    auto stats = router.getStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].name, "large");
+    EXPECT_EQ(stats[0].sequences, 2u);
+    EXPECT_DOUBLE_EQ(stats[0].avgBatchMs(), 50.0);
+    EXPECT_EQ(stats[1].name, "small");
+    EXPECT_EQ(stats[1].sequences, 12u);
+    EXPECT_EQ(stats[1].batches, 2u);
+    EXPECT_DOUBLE_EQ(stats[1].avgBatchMs(), 15.0);
+    EXPECT_EQ(stats[1].escalations, 2u);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../core/PriorityScheduler.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using traductor::Priority;
+using traductor::PriorityScheduler;
+
+// Test that interactive items are served before queued bulk items
+TEST(PrioritySchedulerTest, InteractiveFirst) {
+    PriorityScheduler<int> queue(8, 0.0);
+    queue.push(1, Priority::Bulk);
+    queue.push(2, Priority::Bulk);
+    queue.push(10, Priority::Interactive);
+    queue.push(11, Priority::Interactive);
+    
+    EXPECT_EQ(*queue.pop(), 10);
+    EXPECT_EQ(*queue.pop(), 11);
+    EXPECT_EQ(*queue.pop(), 1);
+    EXPECT_EQ(*queue.pop(), 2);
+    EXPECT_EQ(queue.laneStats(Priority::Bulk).dispatched, 2u);
+}
+
+// Test that bulk gets its minimum share while interactive work keeps arriving
+TEST(PrioritySchedulerTest, BulkMinimumShare) {
+    PriorityScheduler<int> queue(16, 0.25);
+    for (int i = 0; i < 4; ++i) {
+        queue.push(100 + i, Priority::Bulk);
+    }
+    for (int i = 0; i < 12; ++i) {
+        queue.push(i, Priority::Interactive);
+    }
+    
+    std::vector<int> order;
+    for (int i = 0; i < 8; ++i) {
+        order.push_back(*queue.pop());
+    }
+    // One bulk item in every four pops
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 100, 3, 4, 5, 101}));
+}
+
+// Test that a full bulk lane does not block interactive pushes, and close() drains
+TEST(PrioritySchedulerTest, LanesHaveSeparateCapacity) {
+    PriorityScheduler<int> queue(1, 0.2);
+    ASSERT_TRUE(queue.push(1, Priority::Bulk));
+    
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        queue.push(2, Priority::Bulk);  // waits for room in the bulk lane
+        pushed = true;
+    });
+    
+    EXPECT_TRUE(queue.push(10, Priority::Interactive));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_FALSE(pushed.load());
+    
+    EXPECT_EQ(*queue.pop(), 10);
+    EXPECT_EQ(*queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    
+    queue.close();
+    EXPECT_FALSE(queue.push(3, Priority::Interactive));
+    EXPECT_EQ(*queue.pop(), 2);
+    EXPECT_FALSE(queue.pop().has_value());
+}
+
+// Test priority names as accepted by REST and the CLI
+TEST(PrioritySchedulerTest, ParsePriority) {
+    Priority priority = Priority::Bulk;
+    EXPECT_TRUE(traductor::parsePriority("", priority));
+    EXPECT_EQ(priority, Priority::Interactive);
+    EXPECT_TRUE(traductor::parsePriority("bulk", priority));
+    EXPECT_EQ(priority, Priority::Bulk);
+    EXPECT_FALSE(traductor::parsePriority("urgent", priority));
+    EXPECT_STREQ(traductor::priorityName(Priority::Interactive), "interactive");
+}
+
+// Test that a push into a full lane makes room by dropping its stale items
+TEST(PrioritySchedulerTest, PushDropsStaleItems) {
+    PriorityScheduler<int> queue(2, 0.0);
+    std::atomic<int> staleItem{0};
+    std::vector<int> dropped;
+    queue.setStalePolicy([&](const int& item) { return item == staleItem.load(); },
+                         [&](int item) { dropped.push_back(item); });
+    
+    ASSERT_TRUE(queue.push(1, Priority::Bulk));
+    ASSERT_TRUE(queue.push(2, Priority::Bulk));
+    staleItem = 2;  // item 2's request stopped while it waited
+    ASSERT_TRUE(queue.push(3, Priority::Bulk));
+    EXPECT_EQ(dropped, std::vector<int>{2});
+    
+    // An item that goes stale while a push waits is found by a later sweep
+    std::thread producer([&] { queue.push(4, Priority::Bulk); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    staleItem = 1;
+    producer.join();
+    EXPECT_EQ(dropped, (std::vector<int>{2, 1}));
+    EXPECT_EQ(*queue.pop(), 3);
+    EXPECT_EQ(*queue.pop(), 4);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../core/RateLimiter.h"
+
+using traductor::RateLimiter;
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        options_.enabled = true;
+        options_.textsPerSecond = 2.0;
+        options_.textsBurst = 4.0;
+        options_.tokensPerSecond = 100.0;
+        options_.tokensBurst = 200.0;
+    }
+    
+    RateLimiter::Options options_;
+    RateLimiter::Clock::time_point t0_ = RateLimiter::Clock::now();
+    
+    RateLimiter::Clock::time_point at(int ms) const {
+        return t0_ + std::chrono::milliseconds(ms);
+    }
+};
+
+// Test burst, refusal with Retry-After, and refill over time
+TEST_F(RateLimiterTest, TextBucket) {
+    RateLimiter limiter(options_);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(limiter.admit("a", 1, 10, at(0)).allowed);
+    }
+    
+    auto refused = limiter.admit("a", 1, 10, at(0));
+    EXPECT_FALSE(refused.allowed);
+    EXPECT_EQ(refused.retryAfterSeconds, 1);
+    
+    // Other clients have their own buckets
+    EXPECT_TRUE(limiter.admit("b", 1, 10, at(0)).allowed);
+    
+    // 2 texts/s: one text is back after 500 ms
+    EXPECT_TRUE(limiter.admit("a", 1, 10, at(500)).allowed);
+    EXPECT_FALSE(limiter.admit("a", 1, 10, at(500)).allowed);
+}
+
+// Test the token bucket and oversize requests taking the bucket into debt
+TEST_F(RateLimiterTest, TokenBucketAndDebt) {
+    RateLimiter limiter(options_);
+    
+    // Larger than the burst: admitted from a full bucket
+    EXPECT_TRUE(limiter.admit("a", 1, 500, at(0)).allowed);
+    
+    // 300 tokens of debt plus 50 needed, at 100 tokens/s
+    auto refused = limiter.admit("a", 1, 50, at(0));
+    EXPECT_FALSE(refused.allowed);
+    EXPECT_EQ(refused.retryAfterSeconds, 4);
+    EXPECT_TRUE(limiter.admit("a", 1, 50, at(3500)).allowed);
+}
+
+// Test usage counters, and that a disabled limiter only counts
+TEST_F(RateLimiterTest, ClientStats) {
+    options_.enabled = false;
+    RateLimiter limiter(options_);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(limiter.admit("bulk", 5, 100, at(0)).allowed);
+    }
+    limiter.admit("chat", 1, 8, at(0));
+    
+    auto stats = limiter.getClientStats(at(0));
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].client, "bulk");
+    EXPECT_EQ(stats[0].requests, 10u);
+    EXPECT_EQ(stats[0].texts, 50u);
+    EXPECT_EQ(stats[0].tokens, 1000u);
+    EXPECT_EQ(stats[0].rejected, 0u);
+    EXPECT_EQ(stats[1].client, "chat");
+}
+
+// Test that a refunded request gives back its cost and its usage counts
+TEST_F(RateLimiterTest, Refund) {
+    RateLimiter limiter(options_);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(limiter.admit("a", 1, 10, at(0)).allowed);
+    }
+    EXPECT_FALSE(limiter.admit("a", 1, 10, at(0)).allowed);
+    
+    // Refused downstream: the client keeps its quota
+    limiter.refund("a", 1, 10, at(0));
+    EXPECT_TRUE(limiter.admit("a", 1, 10, at(0)).allowed);
+    
+    auto stats = limiter.getClientStats(at(0));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].requests, 4u);
+    EXPECT_EQ(stats[0].texts, 4u);
+    EXPECT_EQ(stats[0].rejected, 1u);
+    
+    // An oversize request's debt is cleared, but the bucket is not filled past its burst
+    EXPECT_TRUE(limiter.admit("b", 1, 500, at(0)).allowed);
+    limiter.refund("b", 1, 500, at(0));
+    EXPECT_TRUE(limiter.admit("b", 1, 200, at(0)).allowed);
+    EXPECT_FALSE(limiter.admit("b", 1, 1, at(0)).allowed);
+    
+    // Unknown clients are ignored
+    limiter.refund("nobody", 1, 10, at(0));
+    EXPECT_EQ(limiter.getClientStats(at(0)).size(), 2u);
+}
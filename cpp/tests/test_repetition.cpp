@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "../core/RepetitionDetector.h"
+
+using traductor::RepetitionDetector;
+
+// Test that streaming detection fires on the token completing the loop
+TEST(RepetitionDetectorTest, StopsOnRepeatedToken) {
+    RepetitionDetector detector(4, 4);
+    std::vector<int> ids = {10, 11, 12, 7, 7, 7};
+    for (int id : ids) {
+        EXPECT_FALSE(detector.push(id));
+    }
+    EXPECT_TRUE(detector.push(7));
+    EXPECT_TRUE(detector.looping());
+    
+    detector.reset();
+    EXPECT_FALSE(detector.looping());
+    EXPECT_FALSE(detector.push(7));
+}
+
+// Test n-gram loops and normal text with occasional repeats
+TEST(RepetitionDetectorTest, DetectsNgramLoops) {
+    RepetitionDetector detector(4, 3);
+    std::vector<int> bigramLoop = {5, 20, 21, 20, 21, 20};
+    for (int id : bigramLoop) {
+        EXPECT_FALSE(detector.push(id));
+    }
+    EXPECT_TRUE(detector.push(21));
+    
+    // "la casa y la casa de la playa": repeats, but never three times in a row
+    std::vector<int> prose = {1, 2, 3, 1, 2, 4, 1, 5, 6};
+    EXPECT_EQ(RepetitionDetector::findLoop(prose, 4, 3), prose.size());
+}
+
+// Test that findLoop keeps exactly one copy of the repeated n-gram
+TEST(RepetitionDetectorTest, FindLoopTruncatesAfterFirstCopy) {
+    std::vector<int> ids = {1, 2, 3, 8, 9, 8, 9, 8, 9, 8, 9, 8};
+    size_t end = RepetitionDetector::findLoop(ids, 4, 3);
+    ASSERT_EQ(end, 5u);
+    EXPECT_EQ(std::vector<int>(ids.begin(), ids.begin() + end), (std::vector<int>{1, 2, 3, 8, 9}));
+    
+    std::vector<int> unigram = {4, 6, 6, 6, 6, 6, 6};
+    EXPECT_EQ(RepetitionDetector::findLoop(unigram, 4, 4), 2u);
+    EXPECT_EQ(RepetitionDetector::findLoop({}, 4, 4), 0u);
+}
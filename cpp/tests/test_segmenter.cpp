@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../core/Segmenter.h"
+#include "../core/SegmentStream.h"
+#include <sstream>
 
 class SegmenterTest : public ::testing::Test {
 protected:
@@ -35,3 +37,45 @@ TEST_F(SegmenterTest, ShortText) {
     EXPECT_EQ(segments.size(), 1);
     EXPECT_EQ(segments[0], shortText);
 }
+
+TEST_F(SegmenterTest, PackShortUnits) {
+    // Short email lines should share one decoder sequence
+    traductor::Segmenter::PackingOptions options;
+    options.enabled = true;
+    options.targetTokens = 64;
+    options.maxUnitTokens = 16;
+    segmenter_->setPackingOptions(options);
+    
+    std::vector<std::string> units = {"Hola,", "Gracias por tu ayuda.", "Saludos", "Ana"};
+    auto packed = segmenter_->pack(units);
+    
+    ASSERT_EQ(packed.size(), 1);
+    EXPECT_EQ(packed[0].unitCount, 4);
+    
+    // Boundaries must be restored exactly
+    auto restored = segmenter_->unpack(packed[0].text, packed[0].unitCount);
+    EXPECT_EQ(restored, units);
+}
+
+TEST_F(SegmenterTest, UnpackDetectsLostMarkers) {
+    // A translation that dropped a marker must not be split wrongly
+    auto restored = segmenter_->unpack("Hej [[SEG]] Tak for hjælpen", 3);
+    EXPECT_TRUE(restored.empty());
+}
+
+TEST_F(SegmenterTest, StreamYieldsParagraphs) {
+    // Segments are pulled paragraph by paragraph from the stream
+    std::istringstream input("Hola,\n\nGracias por tu ayuda.\nSaludos\n\n\nAna");
+    traductor::SegmentStream stream(input, *segmenter_);
+    
+    std::vector<std::string> texts;
+    traductor::SegmentStream::Segment segment;
+    while (stream.next(segment)) {
+        EXPECT_TRUE(segment.endsParagraph);
+        texts.push_back(segment.text);
+    }
+    
+    ASSERT_EQ(texts.size(), 3);
+    EXPECT_EQ(texts[1], "Gracias por tu ayuda.\nSaludos");
+    EXPECT_EQ(stream.paragraphsRead(), 3);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../core/SlowRequestLog.h"
+#include "../core/Config.h"
+#include "../core/TranslatorEngine.h"
+
+using traductor::SlowRequestLog;
+
+namespace {
+
+SlowRequestLog::Entry makeEntry(double latencyMs) {
+    SlowRequestLog::Entry entry;
+    entry.latencyMs = latencyMs;
+    entry.direction = "es-da";
+    entry.text = {"Hola mundo"};
+    return entry;
+}
+
+} // namespace
+
+// Test the threshold and that only the last N slow requests are kept, newest first
+TEST(SlowRequestLogTest, ThresholdAndRing) {
+    SlowRequestLog::Options options;
+    options.thresholdMs = 100.0;
+    options.capacity = 3;
+    SlowRequestLog log(options);
+    ASSERT_TRUE(log.enabled());
+
+    EXPECT_FALSE(log.record(makeEntry(99.0)));
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(log.record(makeEntry(100.0 + i)));
+    }
+
+    EXPECT_EQ(log.total(), 5u);
+    auto recent = log.recent();
+    ASSERT_EQ(recent.size(), 3u);
+    EXPECT_DOUBLE_EQ(recent[0].latencyMs, 104.0);
+    EXPECT_DOUBLE_EQ(recent[2].latencyMs, 102.0);
+
+    SlowRequestLog disabled(SlowRequestLog::Options{0.0, 10, false});
+    EXPECT_FALSE(disabled.enabled());
+    EXPECT_FALSE(disabled.record(makeEntry(1e6)));
+}
+
+// Test that text is redacted unless text logging is enabled
+TEST(SlowRequestLogTest, Redaction) {
+    SlowRequestLog redacted(SlowRequestLog::Options{1.0, 10, false});
+    redacted.record(makeEntry(5.0));
+    auto json = redacted.toJson();
+    EXPECT_EQ(json["requests"][0]["text"], "[redacted]");
+    EXPECT_EQ(json["text_logged"], false);
+
+    SlowRequestLog withText(SlowRequestLog::Options{1.0, 10, true});
+    withText.record(makeEntry(5.0));
+    EXPECT_EQ(withText.toJson()["requests"][0]["text"][0], "Hola mundo");
+
+    // Excerpts are cut before a multi-byte character, not inside it
+    auto excerpt = SlowRequestLog::excerpt({"abcñ"}, 4);
+    EXPECT_EQ(excerpt[0], "abc...");
+}
+
+// Test that logged text which is not valid UTF-8 is replaced, not thrown on
+TEST(SlowRequestLogTest, InvalidUtf8Text) {
+    SlowRequestLog log(SlowRequestLog::Options{1.0, 10, true});
+    auto entry = makeEntry(5.0);
+    entry.text = {"caf\xe9 \xff"};
+    bool recorded = false;
+    EXPECT_NO_THROW(recorded = log.record(entry));
+    EXPECT_TRUE(recorded);
+    ASSERT_EQ(log.recent().size(), 1u);
+
+    std::string body;
+    EXPECT_NO_THROW(body = log.toJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+    EXPECT_NE(body.find("caf\xef\xbf\xbd"), std::string::npos);  // U+FFFD
+}
+
+// Test that a slow engine request is logged with its breakdown
+TEST(SlowRequestLogTest, EngineBreakdown) {
+    traductor::Config config;
+    config.setSlowRequestMs(0.001);
+    traductor::TranslatorEngine engine(config);
+    ASSERT_TRUE(engine.initialize());
+
+    auto result = engine.translate(std::vector<std::string>{"Hola mundo. ¿Cómo estás?", "Gracias"}, "es-da");
+    ASSERT_FALSE(result.translations.empty());
+    engine.translate(std::vector<std::string>{"Gracias"}, "es-da");
+
+    const auto& log = engine.getSlowRequestLog();
+    EXPECT_EQ(engine.getHealthInfo().slowRequests, 2u);
+    auto recent = log.recent();
+    ASSERT_EQ(recent.size(), 2u);
+
+    // Newest first: the second request was a cache hit
+    EXPECT_EQ(recent[0].cacheHits, 1u);
+    EXPECT_TRUE(recent[0].batches.empty());
+
+    const auto& first = recent[1];
+    EXPECT_EQ(first.outcome, "ok");
+    EXPECT_EQ(first.texts, 2u);
+    EXPECT_GT(first.inputBytes, 0u);
+    EXPECT_GE(first.segments, 2u);
+    EXPECT_FALSE(first.batches.empty());
+    EXPECT_GT(first.tokensIn, 0u);
+    EXPECT_TRUE(first.text.empty());
+
+    auto json = SlowRequestLog::toJson(first);
+    EXPECT_TRUE(json["stages_ms"].contains("inference"));
+    EXPECT_TRUE(json["stages_ms"].contains("queue_wait"));
+}
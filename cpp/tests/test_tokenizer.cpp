@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../core/Tokenizer.h"
+
+class TokenizerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tokenizer_ = std::make_unique<traductor::Tokenizer>();
+        tokenizer_->setNumWorkers(3);
+    }
+    
+    void TearDown() override {
+        tokenizer_.reset();
+    }
+    
+    std::unique_ptr<traductor::Tokenizer> tokenizer_;
+};
+
+TEST_F(TokenizerTest, BatchEncodeMatchesSingleEncode) {
+    // The flat arena must hold the same IDs as encoding texts one by one
+    std::vector<std::string> texts = {"Hola mundo", "Gracias", "", "Un saludo cordial", "Ana"};
+    
+    traductor::Tokenizer::TokenBatch batch;
+    tokenizer_->encodeBatch(texts, "spa_Latn", batch);
+    
+    ASSERT_EQ(batch.size(), texts.size());
+    EXPECT_EQ(batch.offsets.back(), batch.ids.size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        EXPECT_EQ(batch.sequence(i), tokenizer_->encode(texts[i], "spa_Latn"));
+    }
+}
+
+TEST_F(TokenizerTest, BatchDecodeRoundTrip) {
+    // Decoding the arena restores every text in order
+    std::vector<std::string> texts = {"Hej", "verden", "tak for hjaelpen"};
+    
+    traductor::Tokenizer::TokenBatch batch;
+    tokenizer_->encodeBatch(texts, "dan_Latn", batch);
+    
+    EXPECT_EQ(tokenizer_->decodeBatch(batch), texts);
+}
+
+TEST_F(TokenizerTest, CacheCountsRepeatedSegments) {
+    // Repeated greetings are served from the encode cache
+    tokenizer_->setCacheSize(64);
+    
+    auto first = tokenizer_->encode("Un saludo,", "spa_Latn");
+    auto second = tokenizer_->encode("Un saludo,", "spa_Latn");
+    EXPECT_EQ(first, second);
+    
+    tokenizer_->decode(first);
+    tokenizer_->decode(first);
+    
+    auto stats = tokenizer_->getCacheStats();
+    EXPECT_EQ(stats.encodeHits, 1);
+    EXPECT_EQ(stats.encodeMisses, 1);
+    EXPECT_EQ(stats.decodeHits, 1);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "../core/Tracer.h"
+#include "../core/Config.h"
+#include "../core/TranslatorEngine.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using traductor::Tracer;
+
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("traductor_trace_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                  "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".json")).string();
+        cleanup();
+    }
+
+    void TearDown() override {
+        cleanup();
+    }
+
+    void cleanup() {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+        for (int i = 1; i <= 4; ++i) {
+            std::filesystem::remove(path_ + "." + std::to_string(i), ec);
+        }
+    }
+
+    static nlohmann::json readTrace(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return nlohmann::json::parse(buffer.str());
+    }
+
+    std::string path_;
+};
+
+// Test that disabled tracing and unsampled requests get id 0
+TEST_F(TracerTest, Sampling) {
+    Tracer disabled(Tracer::Options{});
+    EXPECT_FALSE(disabled.enabled());
+    EXPECT_EQ(disabled.startTrace(true), 0u);
+
+    Tracer::Options options;
+    options.path = path_;
+    options.sampleRate = 0.25;
+    Tracer tracer(options);
+    EXPECT_TRUE(tracer.enabled());
+
+    int sampled = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (tracer.startTrace(false) != 0) {
+            sampled++;
+        }
+    }
+    EXPECT_EQ(sampled, 25);
+
+    // Forced traces are always taken and get distinct ids
+    uint64_t first = tracer.startTrace(true);
+    uint64_t second = tracer.startTrace(true);
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(second, 0u);
+    EXPECT_NE(first, second);
+}
+
+// Test that spans produce a valid Chrome trace with their args
+TEST_F(TracerTest, SpansWritten) {
+    {
+        Tracer::Options options;
+        options.path = path_;
+        Tracer tracer(options);
+        uint64_t id = tracer.startTrace(true);
+        {
+            Tracer::Span span(&tracer, id, "inference", "batch");
+            EXPECT_TRUE(span.active());
+            span.arg("model", std::string("base \"int8\""));
+            span.arg("sequences", 4.0);
+        }
+        {
+            Tracer::Span untraced(&tracer, 0, "inference", "batch");
+            EXPECT_FALSE(untraced.active());
+        }
+        EXPECT_EQ(tracer.eventsWritten(), 1u);
+    }
+
+    auto trace = readTrace(path_);
+    ASSERT_TRUE(trace.is_array());
+    ASSERT_EQ(trace.size(), 1u);
+    EXPECT_EQ(trace[0]["name"], "inference");
+    EXPECT_EQ(trace[0]["ph"], "X");
+    EXPECT_EQ(trace[0]["args"]["request"], 1);
+    EXPECT_EQ(trace[0]["args"]["model"], "base \"int8\"");
+    EXPECT_EQ(trace[0]["args"]["sequences"], 4);
+    EXPECT_GE(trace[0]["dur"].get<int64_t>(), 0);
+}
+
+// Test that files rotate at the size limit and only maxFiles are kept
+TEST_F(TracerTest, Rotation) {
+    {
+        Tracer::Options options;
+        options.path = path_;
+        options.maxFileBytes = 512;
+        options.maxFiles = 2;
+        Tracer tracer(options);
+        uint64_t id = tracer.startTrace(true);
+        auto now = Tracer::Clock::now();
+        for (int i = 0; i < 50; ++i) {
+            tracer.record(id, "tokenize", "batch", now, now);
+        }
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(path_));
+    EXPECT_TRUE(std::filesystem::exists(path_ + ".1"));
+    EXPECT_TRUE(std::filesystem::exists(path_ + ".2"));
+    EXPECT_FALSE(std::filesystem::exists(path_ + ".3"));
+    for (const auto& file : {path_, path_ + ".1", path_ + ".2"}) {
+        EXPECT_LE(std::filesystem::file_size(file), 512u + 200u);
+        EXPECT_NO_THROW(readTrace(file)) << file;
+    }
+}
+
+// Test that a traced engine request reports its id and writes its spans
+TEST_F(TracerTest, EngineRequest) {
+    traductor::Config config;
+    config.setTraceFile(path_);
+    uint64_t traceId = 0;
+    {
+        traductor::TranslatorEngine engine(config);
+        ASSERT_TRUE(engine.initialize());
+
+        traductor::RequestOptions options;
+        auto untraced = engine.translate(std::vector<std::string>{"Hola"}, "es-da", -1, false, {}, options);
+        EXPECT_EQ(untraced.traceId, 0u);
+
+        options.trace = true;
+        auto result = engine.translate(std::vector<std::string>{"Hola mundo"}, "es-da", -1, false, {}, options);
+        traceId = result.traceId;
+        EXPECT_NE(traceId, 0u);
+    }
+
+    auto trace = readTrace(path_);
+    bool sawRequest = false;
+    for (const auto& event : trace) {
+        EXPECT_EQ(event["args"]["request"], traceId);
+        if (event["name"] == "translate") {
+            sawRequest = true;
+        }
+    }
+    EXPECT_TRUE(sawRequest);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../core/TranslatorEngine.h"
 #include "../core/Config.h"
+#include <atomic>
+#include <sstream>
+#include <thread>
 
 class TranslatorEngineTest : public ::testing::Test {
 protected:
@@ -37,3 +40,236 @@ TEST_F(TranslatorEngineTest, BasicAPI) {
     EXPECT_NO_THROW(engine_->getAverageLatency());
     EXPECT_NO_THROW(engine_->getTotalTranslations());
 }
+
+// Test that multi-text requests flow through the batched pipeline
+TEST_F(TranslatorEngineTest, PipelineTranslatesAllBatches) {
+    ASSERT_TRUE(engine_->initialize());
+    
+    std::vector<std::string> texts;
+    for (int i = 0; i < 40; ++i) {
+        texts.push_back("Hola mundo " + std::to_string(i));
+    }
+    
+    auto result = engine_->translate(texts, "es-da");
+    ASSERT_EQ(result.translations.size(), texts.size());
+    EXPECT_EQ(result.translations[7], "Hej verden 7");
+    
+    auto health = engine_->getHealthInfo();
+    EXPECT_GE(health.batchesCompleted, 3);  // 40 texts, max_batch_size 16
+    EXPECT_EQ(health.preprocessQueueDepth, 0);
+}
+
+// Test that every batch is run by one of the replicas
+TEST_F(TranslatorEngineTest, ReplicasShareBatches) {
+    ASSERT_TRUE(engine_->initialize());
+    
+    std::vector<std::string> texts;
+    for (int i = 0; i < 64; ++i) {
+        texts.push_back("Buenos días " + std::to_string(i));
+    }
+    engine_->translate(texts, "es-da");
+    
+    auto health = engine_->getHealthInfo();
+    ASSERT_EQ(health.replicas.size(), static_cast<size_t>(config_->ct2InterThreads()));
+    
+    size_t batches = 0;
+    for (const auto& replica : health.replicas) {
+        batches += replica.batches;
+        EXPECT_GE(replica.utilization, 0.0);
+    }
+    EXPECT_EQ(batches, health.batchesCompleted);
+}
+
+// Test compute type selection from CPU features
+TEST_F(TranslatorEngineTest, ResolveComputeType) {
+    using traductor::TranslatorEngine;
+    traductor::CpuInfo::Features cpu;
+    
+    EXPECT_EQ(TranslatorEngine::resolveComputeType("auto", cpu), "float32");
+    cpu.avx2 = true;
+    EXPECT_EQ(TranslatorEngine::resolveComputeType("auto", cpu), "int8_float32");
+    cpu.avx512vnni = true;
+    EXPECT_EQ(TranslatorEngine::resolveComputeType("auto", cpu), "int8");
+    
+    // Explicit choices are kept, unknown ones fall back to auto
+    EXPECT_EQ(TranslatorEngine::resolveComputeType("int16", cpu), "int16");
+    EXPECT_EQ(TranslatorEngine::resolveComputeType("fp8", cpu), "int8");
+}
+
+// Test decoding profile selection per request
+TEST_F(TranslatorEngineTest, DecodingProfiles) {
+    config_->setDecodingProfile({"batch", 1, 1.0f, 1.0f, traductor::Priority::Bulk});
+    ASSERT_TRUE(engine_->initialize());
+    
+    auto result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da");
+    EXPECT_EQ(result.profile, config_->defaultProfile());
+    EXPECT_EQ(result.priority, traductor::Priority::Interactive);
+    
+    traductor::RequestOptions options;
+    options.profile = "fast";
+    result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da", -1, false, {}, options);
+    EXPECT_EQ(result.profile, "fast");
+    ASSERT_EQ(result.translations.size(), 1);
+    EXPECT_EQ(result.translations[0], "Hej verden");
+    
+    // The profile's lane applies unless the request names one
+    options.profile = "batch";
+    result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da", -1, false, {}, options);
+    EXPECT_EQ(result.priority, traductor::Priority::Bulk);
+    options.priority = traductor::Priority::Interactive;
+    result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da", -1, false, {}, options);
+    EXPECT_EQ(result.priority, traductor::Priority::Interactive);
+    
+    options.profile = "no-such-profile";
+    result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da", -1, false, {}, options);
+    EXPECT_TRUE(result.translations.empty());
+}
+
+// Test that interactive and bulk requests run concurrently on one engine
+TEST_F(TranslatorEngineTest, ConcurrentPriorityLanes) {
+    ASSERT_TRUE(engine_->initialize());
+    
+    std::vector<std::string> bulkTexts(200, "Buenos días");
+    traductor::RequestOptions bulk;
+    bulk.priority = traductor::Priority::Bulk;
+    
+    traductor::TranslatorEngine::TranslationResult bulkResult;
+    std::thread bulkJob([&] {
+        bulkResult = engine_->translate(bulkTexts, "es-da", -1, false, {}, bulk);
+    });
+    
+    auto result = engine_->translate(std::vector<std::string>{"Hola mundo"}, "es-da");
+    bulkJob.join();
+    
+    ASSERT_EQ(result.translations.size(), 1);
+    EXPECT_EQ(result.translations[0], "Hej verden");
+    ASSERT_EQ(bulkResult.translations.size(), bulkTexts.size());
+    EXPECT_FALSE(bulkResult.translations.back().empty());
+    
+    auto health = engine_->getHealthInfo();
+    EXPECT_EQ(health.interactiveQueued + health.bulkQueued, 0u);
+}
+
+// Test that a cancelled or expired request stops and is counted
+TEST_F(TranslatorEngineTest, CancellationAndDeadline) {
+    ASSERT_TRUE(engine_->initialize());
+    std::vector<std::string> texts(50, "Buenos días");
+    
+    traductor::RequestOptions options;
+    options.cancel = std::make_shared<traductor::CancellationToken>();
+    options.cancel->cancel();
+    auto result = engine_->translate(texts, "es-da", -1, false, {}, options);
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.cancellation, "cancelled");
+    EXPECT_TRUE(result.translations.empty());
+    
+    options.cancel = std::make_shared<traductor::CancellationToken>(std::chrono::nanoseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    result = engine_->translate(texts, "es-da", -1, false, {}, options);
+    EXPECT_EQ(result.cancellation, "deadline_exceeded");
+    
+    // Without a token of its own the request gets request_timeout and completes
+    result = engine_->translate(texts, "es-da");
+    EXPECT_FALSE(result.cancelled);
+    EXPECT_EQ(result.translations.size(), texts.size());
+    
+    auto health = engine_->getHealthInfo();
+    EXPECT_EQ(health.cancelledRequests, 1u);
+    EXPECT_EQ(health.deadlineExceeded, 1u);
+}
+
+// Test per-stage latency histograms
+TEST_F(TranslatorEngineTest, MetricsSnapshot) {
+    ASSERT_TRUE(engine_->initialize());
+    std::vector<std::string> texts(20, "Hola mundo");
+    texts.push_back("Buenos días");
+    engine_->translate(texts, "es-da");
+    engine_->translate(texts, "es-da");  // served from the cache
+    
+    auto metrics = engine_->getMetricsSnapshot();
+    ASSERT_NE(metrics.find("request"), nullptr);
+    EXPECT_EQ(metrics.find("request")->summary.count, 2u);
+    EXPECT_EQ(metrics.find("cache_lookup")->summary.count, 2 * texts.size());
+    EXPECT_GE(metrics.find("inference")->summary.count, 1u);
+    EXPECT_GE(metrics.find("batch_size")->summary.max, 1.0);
+    EXPECT_EQ(metrics.find("no_such_stage"), nullptr);
+    EXPECT_EQ(engine_->getTotalTranslations(), 2u);
+}
+
+// Test that concurrent failing requests and health reads do not race on the last error (run under TSan)
+TEST_F(TranslatorEngineTest, ConcurrentFailures) {
+    ASSERT_TRUE(engine_->initialize());
+    
+    std::atomic<bool> done{false};
+    std::thread reader([this, &done]() {
+        while (!done) {
+            auto health = engine_->getHealthInfo();
+            EXPECT_TRUE(health.lastError.empty() || health.lastError.rfind("Invalid direction: ", 0) == 0);
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 8; ++t) {
+        writers.emplace_back([this, t]() {
+            for (int i = 0; i < 200; ++i) {
+                engine_->translate(std::vector<std::string>{"Hola"}, "xx-" + std::to_string(t * 1000 + i));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+    
+    EXPECT_EQ(engine_->getHealthInfo().lastError.rfind("Invalid direction: xx-", 0), 0u);
+}
+
+// Test that post-processing and glossary restoration run on each rejoined text,
+// pinning the output of texts split into several segments
+TEST_F(TranslatorEngineTest, MultiSegmentOutput) {
+    config_->setMaxSegmentChars(24);
+    ASSERT_TRUE(engine_->initialize());
+    
+    auto result = engine_->translate(
+        std::vector<std::string>{"Hola mundo, amigo.\n\nGracias por tu ayuda.\n\nLa reunión es el 05/03/2024."}, "es-da");
+    ASSERT_EQ(result.translations.size(), 1);
+    EXPECT_EQ(result.translations[0], "Hej verden, amigo. tak for din hjælp. La reunión es el 05.03.2024.");
+    
+    traductor::TermMap glossary{{"amigo", "ven"}};
+    result = engine_->translate(std::vector<std::string>{"Hola amigo.\n\nNos vemos el 05/03/2024, amigo."},
+                                "es-da", -1, true, glossary);
+    ASSERT_EQ(result.translations.size(), 1);
+    EXPECT_EQ(result.translations[0], "Kære ven. Nos vemos el 05/03/2024, ven.");
+}
+
+// Test that request_timeout bounds each streamed paragraph, not the whole
+// document, and that a stream stopped early says so
+TEST_F(TranslatorEngineTest, StreamDeadlinePerParagraph) {
+    config_->setInferenceBackend("mock");
+    config_->setMockLatencyUs(300000, 0, 0);
+    config_->setRequestTimeout(1);
+    ASSERT_TRUE(engine_->initialize());
+    
+    std::string document;
+    for (int i = 0; i < 5; ++i) {
+        document += "Buenos días número " + std::to_string(i) + ".\n\n";
+    }
+    std::istringstream input(document);
+    std::vector<std::string> paragraphs;
+    auto result = engine_->translateStream(input, [&](const std::string& p) { paragraphs.push_back(p); });
+    EXPECT_TRUE(result.complete);
+    EXPECT_FALSE(result.cancelled);
+    EXPECT_EQ(result.paragraphs, 5u);
+    EXPECT_EQ(paragraphs.size(), 5u);
+    
+    traductor::RequestOptions options;
+    options.cancel = std::make_shared<traductor::CancellationToken>();
+    options.cancel->cancel();
+    std::istringstream again(document);
+    result = engine_->translateStream(again, [](const std::string&) {}, "es-da", -1, false, {}, options);
+    EXPECT_FALSE(result.complete);
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.cancellation, "cancelled");
+    EXPECT_EQ(result.paragraphs, 0u);
+    EXPECT_NE(engine_->getHealthInfo().lastError.find("cancelled"), std::string::npos);
+}
@@ -0,0 +1,804 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+#include "../core/TranslatorEngine.h"
+#include "../core/Config.h"
+#include "../core/Logger.h"
+#include "../core/LatencyHistogram.h"
+#include "../core/PriorityScheduler.h"
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// Load generator: drives the REST server (--url) or an in-process engine with
+// requests drawn from a corpus, either at a fixed arrival rate (open loop,
+// --rate) or with a fixed number of clients sending back to back (closed loop).
+//
+// Open-loop latency is measured from the time each request was scheduled to be
+// sent, not from when a client got round to sending it, so a stalled server is
+// charged for the requests that queued up behind it (coordinated omission).
+// Closed-loop latency is the service time; --expected_interval_ms backfills
+// the samples a stall kept the clients from taking, as HdrHistogram does.
+//
+// Corpus: one request per line. A JSON object is read like a POST /translate
+// body ("text" as string or array, optional "direction", "glossary", "formal",
+// "profile", "priority"); objects without "text" use their "body" string, so a
+// backlog-style requests.jsonl works as is. Any other line is one text.
+
+using Clock = std::chrono::steady_clock;
+using TermMap = traductor::TermMap;
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " --corpus FILE [OPTIONS]\n\n";
+    std::cout << "Target (default: in-process engine):\n";
+    std::cout << "  --url URL                REST server, e.g. http://localhost:8000\n";
+    std::cout << "  --config FILE            Engine configuration (in-process)\n";
+    std::cout << "  --backend NAME           Engine inference_backend: auto, ctranslate2 or mock (in-process;\n";
+    std::cout << "                           mock latency from MOCK_*_LATENCY_US)\n\n";
+    std::cout << "Load:\n";
+    std::cout << "  --rate R                 Open loop: R requests/s; omit for closed loop\n";
+    std::cout << "  --arrival KIND           poisson or constant inter-arrival times (default: poisson)\n";
+    std::cout << "  --concurrency N          Clients, i.e. requests in flight at most (default: 8)\n";
+    std::cout << "  --duration S             Seconds of load after the warm-up (default: 30)\n";
+    std::cout << "  --warmup S               Seconds sent but not measured (default: 5)\n";
+    std::cout << "  --requests N             Stop after N requests (including warm-up)\n";
+    std::cout << "  --think_ms MS            Closed loop: pause between a client's requests\n";
+    std::cout << "  --expected_interval_ms MS  Closed loop: correct for coordinated omission\n";
+    std::cout << "  --timeout S              Per-request HTTP timeout (default: 60)\n\n";
+    std::cout << "Request mix (each picked at random per request):\n";
+    std::cout << "  --directions LIST        For lines without a direction (default: es-da,da-es)\n";
+    std::cout << "  --glossary_sizes LIST    Synthetic glossary terms added (default: 0)\n";
+    std::cout << "  --lengths LIST           Corpus lines joined into one text (default: 1)\n";
+    std::cout << "  --profile NAME           Decoding profile for every request\n";
+    std::cout << "  --priority NAME          interactive or bulk for every request\n";
+    std::cout << "  --unique                 Number each request's text so the cache never hits\n";
+    std::cout << "  --seed N                 Random seed (default: 42)\n\n";
+    std::cout << "Output:\n";
+    std::cout << "  --json FILE              Write the report as JSON\n";
+    std::cout << "  --help                   Show this help message\n\n";
+    std::cout << "Example:\n";
+    std::cout << "  " << programName << " --corpus emails.jsonl --url http://localhost:8000 --rate 20 --duration 60\n";
+}
+
+// ---- Corpus and request mix ----
+
+struct LoadRequest {
+    std::vector<std::string> texts;
+    std::string direction;
+    std::shared_ptr<const TermMap> glossary;
+    bool formal = false;
+    std::string profile;
+    std::string priority;
+    size_t chars = 0;
+};
+
+bool parseList(const std::string& value, std::vector<std::string>& items) {
+    items.clear();
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return !items.empty();
+}
+
+bool parseSizes(const std::string& value, std::vector<size_t>& sizes) {
+    std::vector<std::string> items;
+    if (!parseList(value, items)) {
+        return false;
+    }
+    sizes.clear();
+    for (const auto& item : items) {
+        char* end = nullptr;
+        long size = std::strtol(item.c_str(), &end, 10);
+        if (*end != '\0' || size < 0) {
+            return false;
+        }
+        sizes.push_back(static_cast<size_t>(size));
+    }
+    return true;
+}
+
+bool loadCorpus(const std::string& path, std::vector<LoadRequest>& corpus) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open corpus " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        LoadRequest entry;
+        auto json = line.front() == '{' ? nlohmann::json::parse(line, nullptr, false) : nlohmann::json();
+        if (json.is_object()) {
+            if (json.contains("text") && json["text"].is_string()) {
+                entry.texts.push_back(json["text"]);
+            } else if (json.contains("text") && json["text"].is_array()) {
+                for (const auto& item : json["text"]) {
+                    if (item.is_string()) entry.texts.push_back(item);
+                }
+            } else if (json.contains("body") && json["body"].is_string()) {
+                entry.texts.push_back(json["body"]);
+            }
+            entry.direction = json.value("direction", "");
+            entry.formal = json.value("formal", false);
+            entry.profile = json.value("profile", "");
+            entry.priority = json.value("priority", "");
+            if (json.contains("glossary") && json["glossary"].is_object()) {
+                auto glossary = std::make_shared<TermMap>();
+                for (const auto& [source, target] : json["glossary"].items()) {
+                    if (target.is_string()) (*glossary)[source] = target;
+                }
+                entry.glossary = std::move(glossary);
+            }
+        } else {
+            entry.texts.push_back(line);
+        }
+        if (!entry.texts.empty()) {
+            corpus.push_back(std::move(entry));
+        }
+    }
+    return true;
+}
+
+// Synthetic glossary: terms that never occur in text cost as much to scan for as real ones
+std::shared_ptr<const TermMap> makeGlossary(size_t terms) {
+    auto glossary = std::make_shared<TermMap>();
+    for (size_t i = 0; i < terms; ++i) {
+        (*glossary)["término" + std::to_string(i)] = "term" + std::to_string(i);
+    }
+    return glossary;
+}
+
+// Pre-built, seeded sequence of requests; request k is pool[k % size]
+std::vector<LoadRequest> buildPool(const std::vector<LoadRequest>& corpus,
+                                   const std::vector<std::string>& directions,
+                                   const std::vector<size_t>& glossarySizes,
+                                   const std::vector<size_t>& lengths,
+                                   const std::string& profile, const std::string& priority, uint64_t seed) {
+    std::map<size_t, std::shared_ptr<const TermMap>> glossaries;
+    for (size_t size : glossarySizes) {
+        glossaries[size] = size > 0 ? makeGlossary(size) : nullptr;
+    }
+
+    std::mt19937_64 rng(seed);
+    auto pick = [&rng](size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(rng); };
+    const size_t poolSize = std::min<size_t>(std::max<size_t>(1024, corpus.size()), 65536);
+
+    std::vector<LoadRequest> pool;
+    pool.reserve(poolSize);
+    for (size_t n = 0; n < poolSize; ++n) {
+        size_t first = pick(corpus.size());
+        size_t length = std::max<size_t>(1, lengths[pick(lengths.size())]);
+        LoadRequest request = corpus[first];
+        if (length > 1) {
+            // Consecutive corpus lines as the paragraphs of one longer text
+            std::string joined;
+            for (size_t i = 0; i < length; ++i) {
+                for (const auto& text : corpus[(first + i) % corpus.size()].texts) {
+                    if (!joined.empty()) joined += "\n\n";
+                    joined += text;
+                }
+            }
+            request.texts = {joined};
+        }
+        if (request.direction.empty()) {
+            request.direction = directions[pick(directions.size())];
+        }
+        const auto& synthetic = glossaries[glossarySizes[pick(glossarySizes.size())]];
+        if (synthetic && request.glossary) {
+            auto merged = std::make_shared<TermMap>(*synthetic);
+            merged->insert(request.glossary->begin(), request.glossary->end());
+            request.glossary = std::move(merged);
+        } else if (synthetic) {
+            request.glossary = synthetic;
+        }
+        if (!profile.empty()) request.profile = profile;
+        if (!priority.empty()) request.priority = priority;
+        for (const auto& text : request.texts) {
+            request.chars += text.size();
+        }
+        pool.push_back(std::move(request));
+    }
+    return pool;
+}
+
+// ---- Targets ----
+
+struct Outcome {
+    enum class Kind { Ok, Rejected, Error } kind = Kind::Ok;
+    std::string error;  // short reason, used as a counter key
+};
+
+// One per client thread
+class Target {
+public:
+    virtual ~Target() = default;
+    virtual Outcome send(const LoadRequest& request, uint64_t number) = 0;
+};
+
+std::vector<std::string> requestTexts(const LoadRequest& request, uint64_t number, bool unique) {
+    std::vector<std::string> texts = request.texts;
+    if (unique && !texts.empty()) {
+        texts.back() += " (" + std::to_string(number) + ")";
+    }
+    return texts;
+}
+
+class EngineTarget : public Target {
+public:
+    EngineTarget(traductor::TranslatorEngine& engine, bool unique) : engine_(engine), unique_(unique) {}
+
+    Outcome send(const LoadRequest& request, uint64_t number) override {
+        traductor::RequestOptions options;
+        options.profile = request.profile;
+        if (!traductor::parsePriority(request.priority, options.priority)) {
+            return {Outcome::Kind::Error, "unknown_priority"};
+        }
+        static const TermMap kNoGlossary;
+        try {
+            auto result = engine_.translate(requestTexts(request, number, unique_), request.direction, -1,
+                                            request.formal, request.glossary ? *request.glossary : kNoGlossary,
+                                            options);
+            if (result.rejected) {
+                return {Outcome::Kind::Rejected, result.rejection};
+            }
+            if (result.cancelled) {
+                return {Outcome::Kind::Error, result.cancellation};
+            }
+            return {};
+        } catch (const std::exception&) {
+            return {Outcome::Kind::Error, "exception"};
+        }
+    }
+
+private:
+    traductor::TranslatorEngine& engine_;
+    bool unique_;
+};
+
+#ifndef _WIN32
+// Minimal blocking HTTP/1.1 client: one keep-alive connection, reopened when the server closes it
+class HttpTarget : public Target {
+public:
+    HttpTarget(std::string host, std::string port, int timeoutSeconds, bool unique)
+        : host_(std::move(host)), port_(std::move(port)), timeoutSeconds_(timeoutSeconds), unique_(unique) {}
+    ~HttpTarget() override { disconnect(); }
+
+    Outcome send(const LoadRequest& request, uint64_t number) override {
+        nlohmann::json body;
+        body["text"] = requestTexts(request, number, unique_);
+        body["direction"] = request.direction;
+        body["formal"] = request.formal;
+        if (request.glossary) body["glossary"] = *request.glossary;
+        if (!request.profile.empty()) body["profile"] = request.profile;
+        if (!request.priority.empty()) body["priority"] = request.priority;
+        std::string payload = body.dump();
+
+        std::string message = "POST /translate HTTP/1.1\r\nHost: " + host_ + "\r\n"
+                              "Content-Type: application/json\r\nContent-Length: " +
+                              std::to_string(payload.size()) + "\r\n\r\n" + payload;
+
+        // A reused connection may have been closed by the server since the last request
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            bool reused = fd_ >= 0;
+            if (!reused && !connect()) {
+                return {Outcome::Kind::Error, "connect"};
+            }
+            int status = 0;
+            std::string error;
+            if (exchange(message, status, error)) {
+                if (status >= 200 && status < 300) return {};
+                if (status == 429 || status == 503 || status == 413) {
+                    return {Outcome::Kind::Rejected, "http_" + std::to_string(status)};
+                }
+                return {Outcome::Kind::Error, "http_" + std::to_string(status)};
+            }
+            disconnect();
+            // Only a stale keep-alive connection is retried; the server never saw the request
+            if (!reused || (error != "closed" && error != "send")) {
+                return {Outcome::Kind::Error, error};
+            }
+        }
+        return {Outcome::Kind::Error, "connection_closed"};
+    }
+
+private:
+    bool connect() {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host_.c_str(), port_.c_str(), &hints, &addresses) != 0) {
+            return false;
+        }
+        for (addrinfo* address = addresses; address; address = address->ai_next) {
+            fd_ = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (fd_ < 0) continue;
+            if (::connect(fd_, address->ai_addr, address->ai_addrlen) == 0) break;
+            ::close(fd_);
+            fd_ = -1;
+        }
+        freeaddrinfo(addresses);
+        if (fd_ < 0) {
+            return false;
+        }
+        int one = 1;
+        setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        timeval timeout{timeoutSeconds_, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        buffer_.clear();
+        return true;
+    }
+
+    void disconnect() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool exchange(const std::string& message, int& status, std::string& error) {
+        for (size_t sent = 0; sent < message.size();) {
+            ssize_t n = ::send(fd_, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                error = "send";
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+
+        size_t headerEnd;
+        while ((headerEnd = buffer_.find("\r\n\r\n")) == std::string::npos) {
+            if (!receive(error)) return false;
+        }
+        std::string headers = buffer_.substr(0, headerEnd);
+        buffer_.erase(0, headerEnd + 4);
+        if (std::sscanf(headers.c_str(), "HTTP/%*d.%*d %d", &status) != 1) {
+            error = "bad_response";
+            return false;
+        }
+
+        // Lower-cased for the header lookups
+        for (auto& c : headers) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        bool close = headers.find("\r\nconnection: close") != std::string::npos;
+        size_t length = 0;
+        if (auto pos = headers.find("\r\ncontent-length:"); pos != std::string::npos) {
+            length = static_cast<size_t>(std::strtoull(headers.c_str() + pos + 17, nullptr, 10));
+        } else if (headers.find("\r\ntransfer-encoding: chunked") != std::string::npos) {
+            error = "chunked_response";
+            return false;
+        } else {
+            close = true;  // body runs to the end of the connection
+            length = SIZE_MAX;
+        }
+        while (buffer_.size() < length) {
+            if (!receive(error)) {
+                if (length == SIZE_MAX && error == "closed") break;
+                return false;
+            }
+        }
+        buffer_.erase(0, std::min(length, buffer_.size()));
+        if (close) {
+            disconnect();
+        }
+        return true;
+    }
+
+    bool receive(std::string& error) {
+        char chunk[16384];
+        ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+        if (n == 0) {
+            error = "closed";
+            return false;
+        }
+        if (n < 0) {
+            error = errno == EAGAIN || errno == EWOULDBLOCK ? "timeout" : "recv";
+            return false;
+        }
+        buffer_.append(chunk, static_cast<size_t>(n));
+        return true;
+    }
+
+    std::string host_;
+    std::string port_;
+    int timeoutSeconds_;
+    bool unique_;
+    int fd_ = -1;
+    std::string buffer_;
+};
+#endif
+
+bool parseUrl(const std::string& url, std::string& host, std::string& port) {
+    const std::string scheme = "http://";
+    if (url.rfind(scheme, 0) != 0) {
+        return false;
+    }
+    std::string authority = url.substr(scheme.size());
+    authority = authority.substr(0, authority.find('/'));
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']') == std::string::npos) {
+        host = authority.substr(0, colon);
+        port = authority.substr(colon + 1);
+    } else {
+        host = authority;
+        port = "80";
+    }
+    return !host.empty() && !port.empty();
+}
+
+// ---- Measurement ----
+
+struct Results {
+    traductor::LatencyHistogram latency;  // from the scheduled send time (closed loop: corrected service time)
+    traductor::LatencyHistogram service;  // from the actual send time
+    std::atomic<uint64_t> ok{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> texts{0};
+    std::atomic<uint64_t> chars{0};
+    std::atomic<int64_t> lastCompletionUs{0};  // since the start of measurement
+    std::mutex reasonsMutex;
+    std::map<std::string, uint64_t> reasons;
+
+    void record(const LoadRequest& request, const Outcome& outcome, Clock::time_point scheduled,
+                Clock::time_point sent, Clock::time_point done, Clock::time_point measureStart,
+                std::chrono::microseconds expectedInterval) {
+        if (outcome.kind != Outcome::Kind::Ok) {
+            (outcome.kind == Outcome::Kind::Rejected ? rejected : errors)++;
+            std::lock_guard<std::mutex> lock(reasonsMutex);
+            reasons[outcome.error]++;
+        } else {
+            ok++;
+            texts += request.texts.size();
+            chars += request.chars;
+        }
+
+        auto us = [](Clock::duration elapsed) {
+            return static_cast<uint64_t>(std::max<int64_t>(0,
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        };
+        const uint64_t value = us(done - scheduled);
+        latency.record(value);
+        service.record(us(done - sent));
+        // HdrHistogram-style backfill for the requests a slow one kept this client from sending
+        const auto interval = static_cast<uint64_t>(expectedInterval.count());
+        if (interval > 0) {
+            for (uint64_t missing = value > interval ? value - interval : 0; missing >= interval; missing -= interval) {
+                latency.record(missing);
+            }
+        }
+
+        int64_t completion = static_cast<int64_t>(us(done - measureStart));
+        int64_t previous = lastCompletionUs.load(std::memory_order_relaxed);
+        while (completion > previous && !lastCompletionUs.compare_exchange_weak(previous, completion)) {
+        }
+    }
+};
+
+nlohmann::json summaryJson(const traductor::LatencyHistogram& histogram) {
+    auto summary = histogram.summary(0.001);
+    return {{"count", summary.count}, {"mean", summary.mean}, {"p50", summary.p50}, {"p90", summary.p90},
+            {"p99", summary.p99}, {"p999", summary.p999}, {"max", summary.max}};
+}
+
+int main(int argc, char* argv[]) {
+    std::string corpusPath;
+    std::string url;
+    std::string configFile;
+    std::string backend;
+    std::string jsonPath;
+    std::string profile;
+    std::string priority;
+    std::string arrival = "poisson";
+    std::vector<std::string> directions = {"es-da", "da-es"};
+    std::vector<size_t> glossarySizes = {0};
+    std::vector<size_t> lengths = {1};
+    double rate = 0.0;
+    size_t concurrency = 8;
+    double durationSeconds = 30.0;
+    double warmupSeconds = 5.0;
+    uint64_t maxRequests = 0;
+    double thinkMs = 0.0;
+    double expectedIntervalMs = 0.0;
+    int timeoutSeconds = 60;
+    uint64_t seed = 42;
+    bool unique = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--corpus" && hasValue) {
+            corpusPath = argv[++i];
+        } else if (arg == "--url" && hasValue) {
+            url = argv[++i];
+        } else if (arg == "--config" && hasValue) {
+            configFile = argv[++i];
+        } else if (arg == "--backend" && hasValue) {
+            backend = argv[++i];
+        } else if (arg == "--rate" && hasValue) {
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--arrival" && hasValue) {
+            arrival = argv[++i];
+        } else if (arg == "--concurrency" && hasValue) {
+            concurrency = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--duration" && hasValue) {
+            durationSeconds = std::atof(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            warmupSeconds = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--requests" && hasValue) {
+            maxRequests = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--think_ms" && hasValue) {
+            thinkMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--expected_interval_ms" && hasValue) {
+            expectedIntervalMs = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--timeout" && hasValue) {
+            timeoutSeconds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--directions" && hasValue) {
+            if (!parseList(argv[++i], directions)) {
+                std::cerr << "Error: --directions expects a comma-separated list" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--glossary_sizes" && hasValue) {
+            if (!parseSizes(argv[++i], glossarySizes)) {
+                std::cerr << "Error: --glossary_sizes expects numbers, e.g. 0,10,1000" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--lengths" && hasValue) {
+            if (!parseSizes(argv[++i], lengths)) {
+                std::cerr << "Error: --lengths expects numbers, e.g. 1,3,10" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--profile" && hasValue) {
+            profile = argv[++i];
+        } else if (arg == "--priority" && hasValue) {
+            priority = argv[++i];
+        } else if (arg == "--unique") {
+            unique = true;
+        } else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (corpusPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (arrival != "poisson" && arrival != "constant") {
+        std::cerr << "Error: --arrival must be poisson or constant" << std::endl;
+        return 1;
+    }
+    if (durationSeconds <= 0.0 && maxRequests == 0) {
+        std::cerr << "Error: --duration must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<LoadRequest> corpus;
+    if (!loadCorpus(corpusPath, corpus)) {
+        return 1;
+    }
+    if (corpus.empty()) {
+        std::cerr << "Error: No texts in corpus " << corpusPath << std::endl;
+        return 1;
+    }
+    const auto pool = buildPool(corpus, directions, glossarySizes, lengths, profile, priority, seed);
+
+    // Target: a connection per client, or one engine shared by all of them
+    traductor::Config config;
+    std::unique_ptr<traductor::TranslatorEngine> engine;
+    std::string host;
+    std::string port;
+    std::string targetName;
+    if (!url.empty()) {
+#ifdef _WIN32
+        std::cerr << "Error: --url is not supported on Windows; drive the engine in-process" << std::endl;
+        return 1;
+#else
+        if (!parseUrl(url, host, port)) {
+            std::cerr << "Error: --url expects http://host[:port]" << std::endl;
+            return 1;
+        }
+        targetName = url;
+#endif
+    } else {
+        if (!configFile.empty() && !config.loadFromFile(configFile)) {
+            std::cerr << "Error: Failed to load config from " << configFile << std::endl;
+            return 1;
+        }
+        config.loadFromEnvironment();
+        if (!backend.empty()) {
+            config.setInferenceBackend(backend);
+        }
+        traductor::Logger::instance().configure(traductor::Logger::Options::fromConfig(config));
+        engine = std::make_unique<traductor::TranslatorEngine>(config);
+        if (!engine->initialize()) {
+            std::cerr << "Error: Failed to initialize translator" << std::endl;
+            return 1;
+        }
+        targetName = std::string("in-process (") + engine->getHealthInfo().inferenceBackend + ")";
+    }
+    auto makeTarget = [&]() -> std::unique_ptr<Target> {
+#ifndef _WIN32
+        if (!url.empty()) {
+            return std::make_unique<HttpTarget>(host, port, timeoutSeconds, unique);
+        }
+#endif
+        return std::make_unique<EngineTarget>(*engine, unique);
+    };
+
+    const bool openLoop = rate > 0.0;
+    std::cout << "Load generator: " << (openLoop ? "open loop, " + std::to_string(rate) + " req/s (" + arrival + ")"
+                                                 : "closed loop")
+              << ", " << concurrency << " clients -> " << targetName << std::endl;
+    std::cout << "Corpus: " << corpus.size() << " entries, " << pool.size() << " distinct requests" << std::endl;
+
+    Results results;
+    std::atomic<uint64_t> nextRequest{0};
+    std::atomic<size_t> maxBacklog{0};
+    const auto start = Clock::now() + std::chrono::milliseconds(10);
+    const auto measureStart = start + std::chrono::duration_cast<Clock::duration>(
+                                          std::chrono::duration<double>(warmupSeconds));
+    const auto end = durationSeconds > 0.0
+        ? measureStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(durationSeconds))
+        : Clock::time_point::max();
+    const auto expectedInterval = std::chrono::microseconds(static_cast<int64_t>(expectedIntervalMs * 1000.0));
+
+    struct Job {
+        uint64_t number;
+        Clock::time_point scheduled;
+    };
+    // Unbounded in practice: a backlog is the server falling behind, which the latency must show.
+    // Every job goes through the interactive lane, so this is a plain FIFO.
+    traductor::PriorityScheduler<Job> jobs(size_t{1} << 24, 0.0);
+
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < concurrency; ++c) {
+        clients.emplace_back([&, c]() {
+            auto target = makeTarget();
+            if (openLoop) {
+                while (auto job = jobs.pop()) {
+                    const auto& request = pool[job->number % pool.size()];
+                    auto sent = Clock::now();
+                    auto outcome = target->send(request, job->number);
+                    if (job->scheduled >= measureStart) {
+                        results.record(request, outcome, job->scheduled, sent, Clock::now(), measureStart,
+                                       std::chrono::microseconds(0));
+                    }
+                }
+                return;
+            }
+            // Closed loop: clients start spread over the first think time
+            std::this_thread::sleep_until(start + std::chrono::microseconds(
+                static_cast<int64_t>(thinkMs * 1000.0 * static_cast<double>(c) / static_cast<double>(concurrency))));
+            for (;;) {
+                auto sent = Clock::now();
+                uint64_t number = nextRequest++;
+                if (sent >= end || (maxRequests > 0 && number >= maxRequests)) {
+                    break;
+                }
+                const auto& request = pool[number % pool.size()];
+                auto outcome = target->send(request, number);
+                if (sent >= measureStart) {
+                    results.record(request, outcome, sent, sent, Clock::now(), measureStart, expectedInterval);
+                }
+                if (thinkMs > 0.0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(thinkMs * 1000.0)));
+                }
+            }
+        });
+    }
+
+    if (openLoop) {
+        // Arrival schedule, fixed by the seed; sending late does not shift it
+        std::mt19937_64 rng(seed ^ 0x9e3779b97f4a7c15ULL);
+        std::exponential_distribution<double> poisson(rate);
+        auto scheduled = start;
+        for (uint64_t number = 0; maxRequests == 0 || number < maxRequests; ++number) {
+            if (scheduled >= end) {
+                break;
+            }
+            std::this_thread::sleep_until(scheduled);
+            jobs.push(Job{number, scheduled}, traductor::Priority::Interactive);
+            size_t backlog = jobs.size();
+            if (backlog > maxBacklog.load(std::memory_order_relaxed)) {
+                maxBacklog.store(backlog, std::memory_order_relaxed);
+            }
+            double gap = arrival == "poisson" ? poisson(rng) : 1.0 / rate;
+            scheduled += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(gap));
+        }
+        jobs.close();
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    // Throughput over the measured window, up to the last measured completion
+    const double elapsed = static_cast<double>(results.lastCompletionUs.load()) / 1e6;
+    const uint64_t completed = results.ok + results.rejected + results.errors;
+    auto perSecond = [elapsed](uint64_t count) { return elapsed > 0.0 ? static_cast<double>(count) / elapsed : 0.0; };
+
+    nlohmann::json report;
+    report["target"] = targetName;
+    report["mode"] = openLoop ? "open" : "closed";
+    report["rate"] = rate;
+    report["arrival"] = openLoop ? arrival : "";
+    report["concurrency"] = concurrency;
+    report["warmup_s"] = warmupSeconds;
+    report["measured_s"] = elapsed;
+    report["requests"] = {{"completed", completed}, {"ok", results.ok.load()},
+                          {"rejected", results.rejected.load()}, {"errors", results.errors.load()}};
+    report["failures"] = results.reasons;
+    report["throughput"] = {{"requests_per_s", perSecond(completed)}, {"texts_per_s", perSecond(results.texts)},
+                            {"chars_per_s", perSecond(results.chars)}};
+    report["latency_ms"] = summaryJson(results.latency);
+    report["service_time_ms"] = summaryJson(results.service);
+    const bool corrected = openLoop || expectedInterval.count() > 0;
+    report["coordinated_omission_corrected"] = corrected;
+    if (openLoop) {
+        report["max_backlog"] = maxBacklog.load();
+    }
+
+    auto latency = results.latency.summary(0.001);
+    auto service = results.service.summary(0.001);
+    std::cout << "\nRequests: " << completed << " measured (" << results.ok << " ok, " << results.rejected
+              << " rejected, " << results.errors << " errors) in " << elapsed << "s" << std::endl;
+    for (const auto& [reason, count] : results.reasons) {
+        std::cout << "  " << reason << ": " << count << std::endl;
+    }
+    std::cout << "Throughput: " << perSecond(completed) << " req/s, " << perSecond(results.texts) << " texts/s, "
+              << perSecond(results.chars) << " chars/s" << std::endl;
+    std::cout << "Latency (ms" << (corrected ? ", corrected" : "") << "): p50 "
+              << latency.p50 << "  p90 " << latency.p90 << "  p99 " << latency.p99 << "  p99.9 " << latency.p999
+              << "  max " << latency.max << std::endl;
+    std::cout << "Service time (ms): p50 " << service.p50 << "  p90 " << service.p90 << "  p99 " << service.p99
+              << "  p99.9 " << service.p999 << "  max " << service.max << std::endl;
+    if (openLoop) {
+        std::cout << "Max backlog: " << maxBacklog.load() << " requests waiting for a free client" << std::endl;
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot write " << jsonPath << std::endl;
+            return 1;
+        }
+        out << report.dump(2) << std::endl;
+        std::cout << "Report written to " << jsonPath << std::endl;
+    }
+    return 0;
+}
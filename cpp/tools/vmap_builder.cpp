@@ -0,0 +1,174 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <filesystem>
+#include <cstdlib>
+#include "../core/Tokenizer.h"
+#include "../core/Config.h"
+
+// Vocabulary map builder: tokenizes a monolingual corpus per target language
+// with the same SentencePiece model as the engine and writes the pieces that
+// occur as a CTranslate2 vocabulary map. With use_vmap, the decoder then only
+// scores these pieces instead of NLLB's full ~256k shared vocabulary.
+//
+// Output (in --out, the CTranslate2 model directory by default):
+//   vmap.<lang>.txt  pieces seen in that language's corpus
+//   vmap.txt         union of all languages, the file CTranslate2 reads
+// Every map is a single line with an empty source key, i.e. the pieces are
+// always-allowed candidates regardless of the source sentence.
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " --corpus LANG=FILE [--corpus LANG=FILE ...] [OPTIONS]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --corpus LANG=FILE   Target-language text, one sentence or paragraph per line\n";
+    std::cout << "                       (LANG is a FLORES-200 code: spa_Latn or dan_Latn)\n";
+    std::cout << "  --spm FILE           SentencePiece model (default: <model_dir>/sentencepiece.bpe.model)\n";
+    std::cout << "  --out DIR            Output directory (default: ct2_dir from config)\n";
+    std::cout << "  --min_count N        Drop pieces seen fewer than N times (default: 1)\n";
+    std::cout << "  --config FILE        Load configuration from JSON file\n";
+    std::cout << "  --help               Show this help message\n\n";
+    std::cout << "Example:\n";
+    std::cout << "  " << programName << " --corpus spa_Latn=es.txt --corpus dan_Latn=da.txt\n";
+}
+
+// Pieces the decoder must always be able to emit
+const std::vector<std::string> kAlwaysKeep = {"<s>", "</s>", "<unk>", "<pad>"};
+
+bool countPieces(traductor::Tokenizer& tokenizer, const std::string& filepath,
+                 std::unordered_map<std::string, size_t>& counts, size_t& lines) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open corpus " << filepath << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        for (const auto& piece : tokenizer.tokenize(line)) {
+            counts[piece]++;
+        }
+        lines++;
+    }
+    return true;
+}
+
+bool writeVmap(const std::filesystem::path& path, const std::set<std::string>& pieces) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot write to file " << path.string() << std::endl;
+        return false;
+    }
+
+    file << "\t";
+    bool first = true;
+    for (const auto& piece : pieces) {
+        if (!first) file << " ";
+        file << piece;
+        first = false;
+    }
+    file << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::map<std::string, std::vector<std::string>> corpora;  // language -> files
+    std::string spmPath;
+    std::string outDir;
+    std::string configFile;
+    size_t minCount = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--corpus" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size()) {
+                std::cerr << "Error: --corpus expects LANG=FILE" << std::endl;
+                return 1;
+            }
+            corpora[spec.substr(0, eq)].push_back(spec.substr(eq + 1));
+        } else if (arg == "--spm" && i + 1 < argc) {
+            spmPath = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (arg == "--min_count" && i + 1 < argc) {
+            int value = std::atoi(argv[++i]);
+            minCount = value > 0 ? static_cast<size_t>(value) : 1;
+        } else if (arg == "--config" && i + 1 < argc) {
+            configFile = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    traductor::Config config;
+    if (!configFile.empty() && !config.loadFromFile(configFile)) {
+        std::cerr << "Error: Failed to load config from " << configFile << std::endl;
+        return 1;
+    }
+    if (corpora.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (spmPath.empty()) spmPath = config.modelDir() + "/sentencepiece.bpe.model";
+    if (outDir.empty()) outDir = config.ct2Dir();
+
+    traductor::Tokenizer tokenizer;
+    if (!tokenizer.load(spmPath)) {
+        std::cerr << "Error: Failed to load SentencePiece model from " << spmPath << std::endl;
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
+
+    std::set<std::string> unionPieces(kAlwaysKeep.begin(), kAlwaysKeep.end());
+    for (const auto& [lang, files] : corpora) {
+        if (!tokenizer.isValidLanguageCode(lang)) {
+            std::cerr << "Error: Unsupported language " << lang << std::endl;
+            return 1;
+        }
+
+        std::unordered_map<std::string, size_t> counts;
+        size_t lines = 0;
+        for (const auto& file : files) {
+            if (!countPieces(tokenizer, file, counts, lines)) {
+                return 1;
+            }
+        }
+
+        std::set<std::string> pieces(kAlwaysKeep.begin(), kAlwaysKeep.end());
+        pieces.insert(tokenizer.getLanguageToken(lang));
+        for (const auto& [piece, count] : counts) {
+            if (count >= minCount) pieces.insert(piece);
+        }
+
+        auto path = std::filesystem::path(outDir) / ("vmap." + lang + ".txt");
+        if (!writeVmap(path, pieces)) {
+            return 1;
+        }
+        std::cout << lang << ": " << lines << " lines, " << counts.size() << " distinct pieces, "
+                  << pieces.size() << " kept -> " << path.string() << std::endl;
+
+        unionPieces.insert(pieces.begin(), pieces.end());
+    }
+
+    auto unionPath = std::filesystem::path(outDir) / "vmap.txt";
+    if (!writeVmap(unionPath, unionPieces)) {
+        return 1;
+    }
+    std::cout << "Union: " << unionPieces.size() << " pieces -> " << unionPath.string() << std::endl;
+    std::cout << "Set \"use_vmap\": true in the config to decode with the map" << std::endl;
+    return 0;
+}